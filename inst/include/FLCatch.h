@@ -10,6 +10,12 @@
 #include "FLQuant_base.h"
 
 #endif
+
+#ifndef _FLQuant_param_
+#define _FLQuant_param_
+#include "FLQuant_param.h"
+#endif
+
 #define _FLCatch_base_
 /*
  * FLCatch class
@@ -20,6 +26,7 @@
 /*-------------------------------------------------------------------*/
 // Only n slots are templated and can be AD
 // The other slots are fixed because they are never dependent
+// They are held as FLQuant_param so they can be stored in single precision (see FLQuant_param.h)
 // T is double or adouble
 template <typename T>
 class FLCatch_base {
@@ -30,53 +37,55 @@ class FLCatch_base {
         operator SEXP() const; // Used as intrusive 'wrap' - returns an FLCatch
 		FLCatch_base(const FLCatch_base& FLCatch_base_source); // copy constructor to ensure that copy is a deep copy - used when passing FLSs into functions
 		FLCatch_base& operator = (const FLCatch_base& FLCatch_base_source); // Assignment operator for a deep copy
+		FLCatch_base(FLCatch_base&& FLCatch_base_source) noexcept; // move constructor so that temporaries are not copied
+		FLCatch_base& operator = (FLCatch_base&& FLCatch_base_source) noexcept; // Move assignment operator
 
         // Accessor methods for the slots
         // Get only
-        FLQuant_base<T> landings_n() const;
-        FLQuant_base<T> landings_n(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuant_base<T> discards_n() const;
-        FLQuant_base<T> discards_n(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuant landings_wt() const;
-        FLQuant landings_wt(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuant discards_wt() const;
-        FLQuant discards_wt(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuant catch_sel() const;
-        FLQuant catch_sel(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuant price() const;
-        FLQuant price(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuant_base<T> discards_ratio() const;
-        FLQuant_base<T> discards_ratio(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuant catch_q_params() const;
+        const FLQuant_base<T>& landings_n() const;
+        FLQuant_base<T> landings_n(const Index6& indices_min, const Index6& indices_max) const;
+        const FLQuant_base<T>& discards_n() const;
+        FLQuant_base<T> discards_n(const Index6& indices_min, const Index6& indices_max) const;
+        const FLQuant_param& landings_wt() const;
+        FLQuant landings_wt(const Index6& indices_min, const Index6& indices_max) const;
+        const FLQuant_param& discards_wt() const;
+        FLQuant discards_wt(const Index6& indices_min, const Index6& indices_max) const;
+        const FLQuant_param& catch_sel() const;
+        FLQuant catch_sel(const Index6& indices_min, const Index6& indices_max) const;
+        const FLQuant_param& price() const;
+        FLQuant price(const Index6& indices_min, const Index6& indices_max) const;
+        const FLQuant_base<T>& discards_ratio() const;
+        FLQuant_base<T> discards_ratio(const Index6& indices_min, const Index6& indices_max) const;
+        const FLQuant_param& catch_q_params() const;
         // Extra accessor for catch_q because it's really an FLPar in disguise and does not have
         // the same 'true' dimensions as the other slots
         std::vector<double> catch_q_params(unsigned int year, unsigned int unit, unsigned int season, unsigned int area, unsigned int iter) const;
-        FLQuant catch_q_params(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
+        FLQuant catch_q_params(const Index6& indices_min, const Index6& indices_max) const;
 
         // Get and Set
         FLQuant_base<T>& landings_n();
         FLQuant_base<T>& discards_n();
-        FLQuant& landings_wt();
-        FLQuant& discards_wt();
-        FLQuant& catch_sel();
-        FLQuant& price();
-        FLQuant& catch_q_params();
+        FLQuant_param& landings_wt();
+        FLQuant_param& discards_wt();
+        FLQuant_param& catch_sel();
+        FLQuant_param& price();
+        FLQuant_param& catch_q_params();
 
         // Methods
         FLQuant_base<T> landings() const;
-        FLQuant_base<T> landings(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
+        FLQuant_base<T> landings(const Index5& indices_min, const Index5& indices_max) const;
         FLQuant_base<T> discards() const;
-        FLQuant_base<T> discards(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
+        FLQuant_base<T> discards(const Index5& indices_min, const Index5& indices_max) const;
         FLQuant_base<T> catches() const;
-        FLQuant_base<T> catches(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
+        FLQuant_base<T> catches(const Index5& indices_min, const Index5& indices_max) const;
         FLQuant_base<T> catch_n() const;
-        FLQuant_base<T> catch_n(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
+        FLQuant_base<T> catch_n(const Index6& indices_min, const Index6& indices_max) const;
         FLQuant_base<T> catch_wt() const;
-        FLQuant_base<T> catch_wt(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
+        FLQuant_base<T> catch_wt(const Index6& indices_min, const Index6& indices_max) const;
         FLQuant_base<T> landings_sel() const;
         FLQuant_base<T> discards_sel() const;
         FLQuant_base<T> revenue() const;
-        FLQuant_base<T> revenue(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
+        FLQuant_base<T> revenue(const Index5& indices_min, const Index5& indices_max) const;
         std::string get_name() const;
         std::string get_desc() const;
         Rcpp::NumericVector get_range() const;
@@ -88,11 +97,11 @@ class FLCatch_base {
         FLQuant_base<T> landings_n_flq;
         FLQuant_base<T> discards_n_flq;
         FLQuant_base<T> discards_ratio_flq;
-        FLQuant landings_wt_flq;
-        FLQuant discards_wt_flq;
-        FLQuant catch_sel_flq;
-        FLQuant price_flq;
-        FLQuant catch_q_flq;
+        FLQuant_param landings_wt_flq;
+        FLQuant_param discards_wt_flq;
+        FLQuant_param catch_sel_flq;
+        FLQuant_param price_flq;
+        FLQuant_param catch_q_flq;
         SEXP catch_q_orig; // original - an FLPar - kept for returning only
 };
 
@@ -112,9 +121,11 @@ class FLCatches_base {
         operator SEXP() const; // Used as intrusive 'wrap' - returns an FLCatches objects
 		FLCatches_base(const FLCatches_base& FLCatches_base_source); // copy constructor to ensure that copy is a deep copy - used when passing FLCs into functions
 		FLCatches_base& operator = (const FLCatches_base& FLCatches_base_source); // Assignment operator for a deep copy
+		FLCatches_base(FLCatches_base&& FLCatches_base_source) noexcept; // move constructor so that temporaries are not copied
+		FLCatches_base& operator = (FLCatches_base&& FLCatches_base_source) noexcept; // Move assignment operator
 
         // Accessors
-		FLCatch_base<T> operator () (const unsigned int element) const; // Only gets an FLCatch so const reinforced. Default is the first element
+		const FLCatch_base<T>& operator () (const unsigned int element) const; // Only gets an FLCatch so const reinforced. Default is the first element
 		FLCatch_base<T>& operator () (const unsigned int element); // Gets and sets an FLCatch so const not reinforced
 
         void operator() (const FLCatch_base<T>& flc); // Add another FLCatch_base<T> to the data
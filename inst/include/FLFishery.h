@@ -43,14 +43,16 @@ class FLFishery_base : public FLCatches_base<T> {
         operator SEXP() const; // Used as intrusive 'wrap' - returns an FLFishery
 		FLFishery_base(const FLFishery_base& FLFishery_base_source); // copy constructor to ensure that copy is a deep copy - used when passing FLSs into functions
 		FLFishery_base& operator = (const FLFishery_base& FLFishery_base_source); // Assignment operator for a deep copy
+		FLFishery_base(FLFishery_base&& FLFishery_base_source) noexcept; // move constructor so that temporaries are not copied
+		FLFishery_base& operator = (FLFishery_base&& FLFishery_base_source) noexcept; // Move assignment operator
 
         // Accessor methods for the slots
         // Get only
-        FLQuant_base<T> effort(std::vector<unsigned int> indices_min, std::vector<unsigned int> indices_max) const;
-        FLQuant_base<T> effort() const;
-        FLQuant vcost() const;
-        FLQuant fcost() const;
-        FLQuant hperiod() const;
+        FLQuant_base<T> effort(const Index5& indices_min, const Index5& indices_max) const;
+        const FLQuant_base<T>& effort() const;
+        const FLQuant& vcost() const;
+        const FLQuant& fcost() const;
+        const FLQuant& hperiod() const;
         // Get and Set
         FLQuant_base<T>& effort();
         FLQuant& vcost();
@@ -59,7 +61,7 @@ class FLFishery_base : public FLCatches_base<T> {
 
         // Methods
         FLQuant_base<T> revenue() const;
-        FLQuant_base<T> revenue(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
+        FLQuant_base<T> revenue(const Index5& indices_min, const Index5& indices_max) const;
 
     private:
         std::string name;
@@ -85,11 +87,13 @@ class FLFisheries_base {
         operator SEXP() const; // Used as intrusive 'wrap' - returns an FLFisheries
 		FLFisheries_base(const FLFisheries_base& FLFisheries_base_source); // copy constructor to ensure that copy is a deep copy - used when passing FLSs into functions
 		FLFisheries_base& operator = (const FLFisheries_base& FLFisheries_base_source); // Assignment operator for a deep copy
+		FLFisheries_base(FLFisheries_base&& FLFisheries_base_source) noexcept; // move constructor so that temporaries are not copied
+		FLFisheries_base& operator = (FLFisheries_base&& FLFisheries_base_source) noexcept; // Move assignment operator
 
         // Accessors
-		FLFishery_base<T> operator () (const unsigned int  fishery) const; // Only gets an FLFishery so const reinforced. 
+		const FLFishery_base<T>& operator () (const unsigned int  fishery) const; // Only gets an FLFishery so const reinforced. 
 		FLFishery_base<T>& operator () (const unsigned int fishery); // Gets and sets an FLFishery so const not reinforced. Default is the first element
-		FLCatch_base<T> operator () (const unsigned int fishery, const unsigned int catches) const; // Only gets an FLCatch so const reinforced. 
+		const FLCatch_base<T>& operator () (const unsigned int fishery, const unsigned int catches) const; // Only gets an FLCatch so const reinforced. 
 		FLCatch_base<T>& operator () (const unsigned int fishery, const unsigned int catches); // Gets and sets an FLCatch so const not reinforced. 
         unsigned int get_nfisheries() const;
 
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2014 FLR Team. Distributed under the GPL 2 or later
+ * Maintainer: Finlay Scott, JRC
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+#define _FLQuant_arena_
+
+/*
+ * Arena for the data of FLQuant temporaries
+ * Projecting a timestep makes hundreds of short lived FLQuants (total_z, partial_f, survivors, ...), each with its own heap allocation.
+ * While an FLQuant_arena_scope is alive, the data of new FLQuants made on that thread is bump allocated from large chunks instead.
+ * Freeing a block does nothing except count it off its chunk.
+ * reset() (called between targets in operatingModel::run) rewinds the chunks so the next timestep reuses the same memory.
+ * A chunk that still has live blocks (e.g. a temporary that was moved into a member) is not rewound - it is retired and freed when its last block goes.
+ * Outside a scope, and for very large blocks, the heap is used as normal.
+ * Each block has a small header pointing at its chunk (or nullptr for the heap) so any block can be freed from anywhere.
+ */
+
+/*! \brief The number and size of allocations since the arena was last reset
+ */
+struct FLQuant_arena_counters {
+    std::size_t allocations; // Blocks taken from the arena
+    std::size_t bytes; // Bytes taken from the arena
+    std::size_t heap_allocations; // Blocks that went to the heap while the arena was active, e.g. because they were too large
+};
+
+class FLQuant_arena {
+    public:
+        FLQuant_arena();
+        ~FLQuant_arena();
+        FLQuant_arena(const FLQuant_arena&) = delete;
+        FLQuant_arena& operator = (const FLQuant_arena&) = delete;
+
+        static FLQuant_arena& get(); // The arena of this thread
+        void* allocate(const std::size_t bytes);
+        static void deallocate(void* block);
+        void reset(); // Rewind the chunks and zero the counters
+        void clear(); // Give up all the chunks and zero the counters
+        FLQuant_arena_counters get_counters() const;
+        bool is_active() const;
+
+    private:
+        friend class FLQuant_arena_scope;
+        struct chunk;
+        chunk* new_chunk(const std::size_t min_bytes);
+        static void release(chunk* chunk_ptr);
+        std::vector<chunk*> chunks; // Owned chunks, the last one is being filled
+        unsigned int active; // Number of scopes alive on this thread
+        FLQuant_arena_counters counters;
+};
+
+/*! \brief Use the arena for new FLQuants made on this thread while this object is alive
+ *
+ * Scopes can be nested. When the outermost scope ends the arena gives up its chunks.
+ */
+class FLQuant_arena_scope {
+    public:
+        FLQuant_arena_scope();
+        ~FLQuant_arena_scope();
+        FLQuant_arena_scope(const FLQuant_arena_scope&) = delete;
+        FLQuant_arena_scope& operator = (const FLQuant_arena_scope&) = delete;
+};
+
+/*! \brief Allocator for the data of FLQuant_base
+ *
+ * Stateless - all instances are equal and blocks can be freed by any of them.
+ */
+template <typename T>
+class FLQuant_allocator {
+    public:
+        typedef T value_type;
+        typedef std::true_type propagate_on_container_move_assignment;
+        FLQuant_allocator() noexcept {}
+        template <typename U>
+        FLQuant_allocator(const FLQuant_allocator<U>&) noexcept {}
+        T* allocate(const std::size_t n){
+            return static_cast<T*>(FLQuant_arena::get().allocate(n * sizeof(T)));
+        }
+        void deallocate(T* block, const std::size_t){
+            FLQuant_arena::deallocate(block);
+        }
+};
+
+template <typename T, typename U>
+bool operator == (const FLQuant_allocator<T>&, const FLQuant_allocator<U>&){
+    return true;
+}
+
+template <typename T, typename U>
+bool operator != (const FLQuant_allocator<T>&, const FLQuant_allocator<U>&){
+    return false;
+}
+
@@ -7,6 +7,34 @@
 #include "cppad/cppad.hpp" // CppAD package http://www.coin-or.org/CppAD/
 
 #include <Rcpp.h>
+#include <array>
+#include <memory>
+#include <type_traits>
+
+#ifndef _FLQuant_simd_
+#define _FLQuant_simd_
+#include "FLQuant_simd.h"
+#endif
+
+#ifndef _FLQuant_arena_
+#define _FLQuant_arena_
+#include "FLQuant_arena.h"
+#endif
+
+#ifndef _FLQuant_data_
+#define _FLQuant_data_
+#include "FLQuant_data.h"
+#endif
+
+#ifndef _FLQuant_threads_
+#define _FLQuant_threads_
+#include "FLQuant_threads.h"
+#endif
+
+#ifndef _FLQuant_index_
+#define _FLQuant_index_
+#include "FLQuant_index.h"
+#endif
 
 #define _FLQuant_base_
 /*
@@ -34,34 +62,89 @@
 
 typedef CppAD::AD<double> adouble;
 
+template <typename T>
+class FLQuantView;
+template <typename E>
+class FLQuant_expr;
+template <typename T>
+class FLQuant_expr_leaf;
+
+/*! \brief The dimnames of an FLQuant
+ *
+ * The names of the 6 dimensions (e.g. age, year) and the names along each of them, held in C++ so that FLQuants can be made, copied and subset without using R.
+ * The names along each dimension are not changed once made and are shared between copies.
+ * A dimension can have blank names, e.g. in an FLQuant made from its dims. These are not stored.
+ * The dimnames are only turned into an R list when they are returned to R.
+ */
+class FLQuant_dimnames {
+    public:
+        typedef std::shared_ptr<const std::vector<std::string> > names_ptr;
+
+        /* Constructors */
+        FLQuant_dimnames(); // No dimensions
+        FLQuant_dimnames(const std::vector<unsigned int>& dim); // Blank names
+        FLQuant_dimnames(SEXP dimnames_sexp); // Used as intrusive 'as' - the dimnames list of an R array
+        operator SEXP() const; // Used as intrusive 'wrap' - returns a named list
+
+        /* Get accessors */
+        std::vector<unsigned int> get_dim() const;
+        std::string get_dim_name(const unsigned int dim_no) const;
+        std::vector<std::string> operator [] (const unsigned int dim_no) const; // The names along a dimension (starting at 0)
+
+        /* Set accessors */
+        void set_names(const unsigned int dim_no, const std::vector<std::string>& names_in);
+        void set_names(const unsigned int dim_no, const names_ptr& names_in);
+        void subset(const unsigned int dim_no, const unsigned int first, const unsigned int length); // Keep length names from the first (starting at 1)
+
+    private:
+        std::shared_ptr<const std::array<std::string, 6> > dim_names;
+        std::array<names_ptr, 6> names; // nullptr for blank names
+        std::array<unsigned int, 6> lengths;
+};
+
+const FLQuant_dimnames::names_ptr& summary_names(const unsigned int dim_no); // Names of the dimensions collapsed by the summary functions
+
 /*! \brief The FLQuant class
  *
  * This class is similar in dimension and behaviour to the R FLQuant class.
  * The values can either be of type double or adouble, the latter used with the CppAD library.
  * Basic FLQuant manipulation and mathematical operations are available.
+ * An FLQuant with 1 iter is iteration invariant and is broadcast over the iters of any FLQuant it is used with.
+ * The accessors, views, arithmetic (including the compound operators) and sweep_flq() recycle its values without copying them, so slots that are the same in all iters (e.g. wt, m, mat) only need to be stored once.
  *
  */
 template <typename T>
 class FLQuant_base {
 	public:
+        typedef FLQuant_data<T> data_type; // Small data is held inline, larger data is drawn from the arena while one is active (see FLQuant_data.h)
+
         /* Constructors */
 		FLQuant_base();
 		FLQuant_base(SEXP flq_sexp); // Used as intrusive 'as'
         operator SEXP() const; // Used as intrusive 'wrap'
 		FLQuant_base(const FLQuant_base& FLQuant_base_source); // copy constructor to ensure that copies (i.e. when passing to functions) are deep
 		FLQuant_base& operator = (const FLQuant_base& FLQuant_source); // Assignment operator for a deep copy
+		FLQuant_base(FLQuant_base&& FLQuant_source) noexcept; // move constructor so that temporaries are not copied
+		FLQuant_base& operator = (FLQuant_base&& FLQuant_source) noexcept; // Move assignment operator
         FLQuant_base(const unsigned int nquant, const unsigned int nyear, const unsigned int nunit, const unsigned int nseason, const unsigned int narea, const unsigned int niter, const T value=0.0); // Make an empty FLQuant
-        FLQuant_base(const std::vector<unsigned int> dims, const T value=0.0);
+        FLQuant_base(const std::vector<unsigned int>& dims, const T value=0.0);
 
         // Specialised constructor to make an FLQuantAD from an FLQuant
         template <typename T2>
 		FLQuant_base(const FLQuant_base<T2>& FLQuant_source); 
 
+        // Evaluate an arithmetic expression, e.g. FLQuant out = flq1 * flq2 + 1.0 (see FLQuant_expr.h)
+        // Only if the result can be held by T, i.e. not FLQuant = adouble expression
+        template <typename E, typename = typename std::enable_if<std::is_convertible<typename E::value_type, T>::value>::type>
+        FLQuant_base(const FLQuant_expr<E>& flq_expr);
+        template <typename E, typename = typename std::enable_if<std::is_convertible<typename E::value_type, T>::value>::type>
+        FLQuant_base& operator = (const FLQuant_expr<E>& flq_expr);
+
 		/* Get accessors */
-        std::vector<T> get_data() const;
-		std::string get_units() const;
-        std::vector<unsigned int> get_dim() const;
-        Rcpp::List get_dimnames() const;
+        const data_type& get_data() const;
+		const std::string& get_units() const;
+        const std::vector<unsigned int>& get_dim() const;
+        const FLQuant_dimnames& get_dimnames() const;
 		unsigned int get_size() const;
 		unsigned int get_nquant() const;
 		unsigned int get_nyear() const;
@@ -74,6 +157,7 @@ class FLQuant_base {
 
 		/* Set accessors */
 		void set_data(const std::vector<T>& data_in);
+        void set_dimnames(const FLQuant_dimnames& dimnames_in);
         void set_dimnames(const Rcpp::List& dimnames_in);
         void set_units(const std::string& units_in);
 
@@ -81,16 +165,18 @@ class FLQuant_base {
         /* Get single values */
 		T operator () (const unsigned int element) const; 
 		T operator () (const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const unsigned int iter) const; 
-		T operator () (const std::vector<unsigned int> indices) const; // For all the elements - must be of length 6 
+		T operator () (const Index6& indices) const; // For all the elements
         /* Get subset of FLQuant */
 		FLQuant_base<T> operator () (const unsigned int quant_min, const unsigned int quant_max, const unsigned int year_min, const unsigned int year_max, const unsigned int unit_min, const unsigned int unit_max, const unsigned int season_min, const unsigned int season_max, const unsigned int area_min, const unsigned int area_max, const unsigned int iter_min, unsigned int iter_max) const;
-        FLQuant_base<T> operator () (const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
+        FLQuant_base<T> operator () (const Index6& indices_min, const Index6& indices_max) const;
 		FLQuant_base<T> operator () (const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area) const; // Access all iters
+        /* Get a view of a subset of FLQuant - no data is copied */
+        FLQuantView<T> view(const Index6& indices_min, const Index6& indices_max) const;
 
         /* () get and set accessors - const not reinforced */
 		T& operator () (const unsigned int element); 
 		T& operator () (const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const unsigned int iter);
-		T& operator () (const std::vector<unsigned int> indices); // For all the elements - must be of length 6 
+		T& operator () (const Index6& indices); // For all the elements
 
         /* Fill methods */
         void fill(const T value);
@@ -98,7 +184,8 @@ class FLQuant_base {
         void fill(const T2 value); // specialisation to fill FLQuantAD with double
 
         /* Insert an entire FLQuant */
-        void insert(const FLQuant_base<T> flq, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max);
+        void insert(const FLQuant_base<T>& flq, const Index6& indices_min, const Index6& indices_max);
+        void insert(const FLQuantView<T>& flqv, const Index6& indices_min, const Index6& indices_max);
 
         /* Mathematical operators */
 
@@ -108,12 +195,9 @@ class FLQuant_base {
         // Special case of FLQuant_base<adouble> *= FLQuant_base<double>
         template <typename T2>
         FLQuant_base<T>& operator *= (const FLQuant_base<T2>& rhs);
-        // For the special case of FLQuant_base<adouble> *= double
-        template <typename T2>
+        // For the special case of FLQuant_base<adouble> *= double - not for expressions, which are converted to an FLQuant
+        template <typename T2, typename = typename std::enable_if<std::is_arithmetic<T2>::value>::type>
         FLQuant_base<T>& operator *= (const T2& rhs);
-        // Return same type as itself
-        FLQuant_base<T> operator * (const FLQuant_base<T>& rhs) const;
-        FLQuant_base<T> operator * (const T& rhs) const;
 
         // Division
         FLQuant_base<T>& operator /= (const FLQuant_base<T>& rhs);
@@ -122,11 +206,8 @@ class FLQuant_base {
         template <typename T2>
         FLQuant_base<T>& operator /= (const FLQuant_base<T2>& rhs);
         // Special case of FLQuant_base<adouble> *= double
-        template <typename T2>
+        template <typename T2, typename = typename std::enable_if<std::is_arithmetic<T2>::value>::type>
         FLQuant_base<T>& operator /= (const T2& rhs);
-        // Return same type as itself
-        FLQuant_base<T> operator / (const FLQuant_base<T>& rhs) const;
-        FLQuant_base<T> operator / (const T& rhs) const;
 
         // Subtraction
         FLQuant_base<T>& operator -= (const FLQuant_base<T>& rhs);
@@ -135,11 +216,8 @@ class FLQuant_base {
         template <typename T2>
         FLQuant_base<T>& operator -= (const FLQuant_base<T2>& rhs);
         // Special case of FLQuant_base<adouble> *= double
-        template <typename T2>
+        template <typename T2, typename = typename std::enable_if<std::is_arithmetic<T2>::value>::type>
         FLQuant_base<T>& operator -= (const T2& rhs);
-        // Return same type as itself
-        FLQuant_base<T> operator - (const FLQuant_base<T>& rhs) const;
-        FLQuant_base<T> operator - (const T& rhs) const;
 
         // Addition
         FLQuant_base<T>& operator += (const FLQuant_base<T>& rhs);
@@ -148,11 +226,8 @@ class FLQuant_base {
         template <typename T2>
         FLQuant_base<T>& operator += (const FLQuant_base<T2>& rhs);
         // Special case of FLQuant_base<adouble> *= double
-        template <typename T2>
+        template <typename T2, typename = typename std::enable_if<std::is_arithmetic<T2>::value>::type>
         FLQuant_base<T>& operator += (const T2& rhs);
-        // Return same type as itself
-        FLQuant_base<T> operator + (const FLQuant_base<T>& rhs) const;
-        FLQuant_base<T> operator + (const T& rhs) const;
 
         /* Other methods */
         int match_dims(const FLQuant_base<T>& flq) const;
@@ -161,143 +236,102 @@ class FLQuant_base {
         FLQuant_base<T> propagate_iters(const int iters) const;
 
         /* begin and end and const versions for iterators */
-        typedef typename std::vector<T>::iterator iterator;
+        typedef typename data_type::iterator iterator;
         iterator begin();
         iterator end();
-        typedef typename std::vector<T>::const_iterator const_iterator;
+        typedef typename data_type::const_iterator const_iterator;
         const_iterator begin() const;
         const_iterator end() const;
 
+        friend class FLQuantView<T>;
+        friend class FLQuant_expr_leaf<T>;
+
     protected:
-        std::vector<T> data;
+        data_type data;
 		std::string units;	
         std::vector<unsigned int> dim;
-        Rcpp::List dimnames;
+        FLQuant_dimnames dimnames;
 };
 
 
 typedef FLQuant_base<double> FLQuant;
 typedef FLQuant_base<adouble> FLQuantAD;
 
+/*! \brief A view of a subset of an FLQuant
+ *
+ * Holds the shape of the subset and the strides over the data of the parent FLQuant so no data is copied when subsetting.
+ * The quants of each year, unit, season, area and iter of the view are contiguous in the parent.
+ * The parent must outlive the view and must not be resized while the view is used.
+ * As with the subsetter, if the parent has 1 iter, asking for iters 1 to N gives a view with 1 iter.
+ */
+template <typename T>
+class FLQuantView {
+    public:
+        /* Constructors */
+        FLQuantView(const FLQuant_base<T>& flq); // All of the FLQuant
+        FLQuantView(const FLQuant_base<T>& flq, const Index6& indices_min, const Index6& indices_max);
+
+        /* Get accessors */
+        std::vector<unsigned int> get_dim() const;
+        unsigned int get_size() const;
+        unsigned int get_nquant() const;
+        unsigned int get_nyear() const;
+        unsigned int get_nunit() const;
+        unsigned int get_nseason() const;
+        unsigned int get_narea() const;
+        unsigned int get_niter() const;
+        std::string get_units() const;
+        FLQuant_dimnames get_dimnames() const; // The dimnames of the parent over the subset
+
+        /* Get single values - starts at 1. If the view has 1 iter, any iter gives the first one */
+		T operator () (const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, unsigned int iter) const; 
+        // Pointer to the contiguous quants of a year, unit, season, area and iter (starting at 1)
+        const T* quant_begin(const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const unsigned int iter) const;
+
+        FLQuant_base<T> to_FLQuant() const; // Copy the subset into a new FLQuant
+
+        friend class FLQuant_expr_leaf<T>;
+
+    private:
+        const FLQuant_base<T>* parent;
+        const T* first; // First element of the view in the data of the parent
+        std::array<unsigned int, 6> indices_min; // Position of the view in the parent
+        std::array<unsigned int, 6> dim;
+        std::array<unsigned int, 6> stride; // Distance between consecutive elements of each dimension in the data of the parent
+};
+
 //---------- Other useful functions ------------------------
 
-int dim_matcher(const std::vector<unsigned int> a, const std::vector<unsigned int> b);
-int dim5_matcher(const std::vector<unsigned int> a, const std::vector<unsigned int> b);
+int dim_matcher(const std::vector<unsigned int>& a, const std::vector<unsigned int>& b);
+int dim5_matcher(const std::vector<unsigned int>& a, const std::vector<unsigned int>& b);
 
 // Turn an FLPar (straight from R) into FLQuant
 FLQuant FLPar_to_FLQuant(SEXP flp); 
 
-//------------ Non-member arithmetic methods with mixed types --------------
-
-/* Canonical form: Type operator*(const Type &lhs, const Type &rhs); 
-* double gets swallowed up by whatever is multiplying it.
-* So operations involving a double need to be individually specified.
-* Need to be careful of ambiguities arise,
-* FLQuant_base<anything>  = FLQuant_base<double> * FLQuant_base<anything>
-* FLQuant = FLQuant * double
-* FLQuantAdolc = FLQuantAdolc * adouble
-* FLQuantAD = FLQuantAD * adouble
-* FLQuant_base<> = <> * FLQuant_base
-*/
-
-// Templated functions are instantiated at the bottom of FLQuant_base.cpp
-
-// Multiplication
-template <typename T>
-FLQuant_base<T> operator * (const FLQuant_base<double>& lhs, const FLQuant_base<T>& rhs);
-template <typename T>
-FLQuant_base<T> operator * (const FLQuant_base<T>& lhs, const FLQuant_base<double>& rhs);
-// No template - resolves ambiguity arising from double * FLQ<T> and <T> * FLQ<T> (if T is double, which one is called?)
-FLQuant_base<double> operator * (const double& lhs, const FLQuant_base<double>& rhs);
-// For FLQuant_base<adouble> = adouble * FLQuant_base<adouble>
-template <typename T>
-FLQuant_base<T> operator * (const T& lhs, const FLQuant_base<T>& rhs);
-// For FLQuant_base<adouble> = double * FLQuant_base<adouble>
-template <typename T>
-FLQuant_base<T> operator * (const double& lhs, const FLQuant_base<T>& rhs);
-template <typename T>
-FLQuant_base<T> operator * (const FLQuant_base<T>& lhs, const double& rhs);
-// For FLQuant_base<adouble> = FLQuant_base<double> * adouble
-template <typename T>
-FLQuant_base<T> operator * (const FLQuant_base<double>& lhs, const T& rhs);
-template <typename T>
-FLQuant_base<T> operator * (const T& lhs, const FLQuant_base<double>& rhs);
-
-// Division
-template <typename T>
-FLQuant_base<T> operator / (const FLQuant_base<double>& lhs, const FLQuant_base<T>& rhs);
-template <typename T>
-FLQuant_base<T> operator / (const FLQuant_base<T>& lhs, const FLQuant_base<double>& rhs);
-// No template - resolves ambiguity
-FLQuant_base<double> operator / (const double& lhs, const FLQuant_base<double>& rhs);
-// For FLQuant_base<adouble> = adouble / FLQuant_base<adouble>
-template <typename T>
-FLQuant_base<T> operator / (const T& lhs, const FLQuant_base<T>& rhs);
-// For FLQuant_base<adouble> = double / FLQuant_base<adouble>
-template <typename T>
-FLQuant_base<T> operator / (const double& lhs, const FLQuant_base<T>& rhs);
-template <typename T>
-FLQuant_base<T> operator / (const FLQuant_base<T>& lhs, const double& rhs);
-// For FLQuant_base<adouble> = FLQuant_base<double> / adouble
-template <typename T>
-FLQuant_base<T> operator / (const FLQuant_base<double>& lhs, const T& rhs);
-template <typename T>
-FLQuant_base<T> operator / (const T& lhs, const FLQuant_base<double>& rhs);
-
-// Subtraction
-template <typename T>
-FLQuant_base<T> operator - (const FLQuant_base<double>& lhs, const FLQuant_base<T>& rhs);
-template <typename T>
-FLQuant_base<T> operator - (const FLQuant_base<T>& lhs, const FLQuant_base<double>& rhs);
-// No template - resolves ambiguity
-FLQuant_base<double> operator - (const double& lhs, const FLQuant_base<double>& rhs);
-// For FLQuant_base<adouble> = adouble - FLQuant_base<adouble>
-template <typename T>
-FLQuant_base<T> operator - (const T& lhs, const FLQuant_base<T>& rhs);
-// For FLQuant_base<adouble> = double - FLQuant_base<adouble>
-template <typename T>
-FLQuant_base<T> operator - (const double& lhs, const FLQuant_base<T>& rhs);
-template <typename T>
-FLQuant_base<T> operator - (const FLQuant_base<T>& lhs, const double& rhs);
-// For FLQuant_base<adouble> = FLQuant_base<double> - adouble
-template <typename T>
-FLQuant_base<T> operator - (const FLQuant_base<double>& lhs, const T& rhs);
-template <typename T>
-FLQuant_base<T> operator - (const T& lhs, const FLQuant_base<double>& rhs);
-
-// Addition
-template <typename T>
-FLQuant_base<T> operator + (const FLQuant_base<double>& lhs, const FLQuant_base<T>& rhs);
-template <typename T>
-FLQuant_base<T> operator + (const FLQuant_base<T>& lhs, const FLQuant_base<double>& rhs);
-// No template - resolves ambiguity arising from double + FLQ<T> and <T> + FLQ<T> (if T is double, which one is called?)
-FLQuant_base<double> operator + (const double& lhs, const FLQuant_base<double>& rhs);
-// For FLQuant_base<adouble> = adouble + FLQuant_base<adouble>
-template <typename T>
-FLQuant_base<T> operator + (const T& lhs, const FLQuant_base<T>& rhs);
-// For FLQuant_base<adouble> = double + FLQuant_base<adouble>
-template <typename T>
-FLQuant_base<T> operator + (const double& lhs, const FLQuant_base<T>& rhs);
-template <typename T>
-FLQuant_base<T> operator + (const FLQuant_base<T>& lhs, const double& rhs);
-// For FLQuant_base<adouble> = FLQuant_base<double> * adouble
-template <typename T>
-FLQuant_base<T> operator + (const FLQuant_base<double>& lhs, const T& rhs);
-template <typename T>
-FLQuant_base<T> operator + (const T& lhs, const FLQuant_base<double>& rhs);
+//------------ Arithmetic --------------
 
-// Other arithmetic operations
-template <typename T>
-FLQuant_base<T> log(const FLQuant_base<T>& flq);
-template <typename T>
-FLQuant_base<T> exp(const FLQuant_base<T>& flq);
+// The * / + - operators, exp(), log() and pow() with FLQuants, views and scalars make lazy expressions
+// These are evaluated in a single loop when assigned to an FLQuant or summed
+#ifndef _FLQuant_expr_
+#define _FLQuant_expr_
+#include "FLQuant_expr.h"
+#endif
 
-// Power is a bit more complicated:
-// AD ^ AD = AD,  AD ^ D = AD, D ^ AD = AD, D ^ D = AD
-template <typename T>
-FLQuant_base<T> pow(const FLQuant_base<T>& flq, const T power);
-FLQuant_base<adouble> pow(const FLQuant_base<double>& flq, const adouble power);
-FLQuant_base<adouble> pow(const FLQuant_base<adouble>& flq, const double power);
+/*! \brief The shape of a sweep over 2 FLQuants
+ *
+ * The strides of both FLQuants over the dimensions of the output are worked out once.
+ * Dimensions of length 1 that are recycled have a stride of 0.
+ * Dimensions that are contiguous in the output and both inputs are collapsed into one so the innermost loop is as long as possible.
+ */
+class FLQuant_broadcast {
+    public:
+        FLQuant_broadcast(const std::vector<unsigned int>& dim1, const std::vector<unsigned int>& dim2);
+        std::vector<unsigned int> dim_out; // The dims of the output FLQuant
+        unsigned int ndim; // The number of dimensions after collapsing (at least 1)
+        std::array<unsigned int, 6> extent; // Length of each collapsed dimension
+        std::array<std::size_t, 6> stride1; // Strides over the data of the first FLQuant
+        std::array<std::size_t, 6> stride2; // Strides over the data of the second FLQuant
+};
 
 // Sweep methods (for applying mathematical operations on 2 different sized FLQuants)
 // T1 is the type of the function func (should be std::whatever<>)
@@ -333,6 +367,12 @@ FLQuant_base<T> quant_sum(const FLQuant_base<T>& flq);
 template <typename T>
 FLQuant_base<T> unit_sum(const FLQuant_base<T>& flq);
 
+template <typename T>
+FLQuant_base<T> quant_sum(const FLQuantView<T>& flqv);
+
+template <typename T>
+FLQuant_base<T> unit_sum(const FLQuantView<T>& flqv);
+
 // Means over various dimensions
 template <typename T>
 FLQuant_base<T> quant_mean(const FLQuant_base<T>& flq);  // collapse the quant dimension
@@ -0,0 +1,207 @@
+/*
+ * Copyright 2014 FLR Team. Distributed under the GPL 2 or later
+ * Maintainer: Finlay Scott, JRC
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifndef _FLQuant_arena_
+#define _FLQuant_arena_
+#include "FLQuant_arena.h"
+#endif
+
+#define _FLQuant_data_
+
+/*
+ * Storage for the data of an FLQuant
+ * Deterministic projections make lots of FLQuants with only a few values (e.g. the SRP of a unit, one age of spwn, a slice of effort).
+ * With a std::vector each of these needs its own allocation.
+ * FLQuant_data holds up to inline_size values inside the object itself and only allocates (from the arena, see FLQuant_arena.h) for more.
+ * It has the parts of the std::vector interface used by FLQuant_base. The iterators are pointers.
+ * Moving an FLQuant_data with inline values moves the values, not the pointer.
+ */
+
+/*! \brief Contiguous values, held inline if there are few of them
+ */
+template <typename T>
+class FLQuant_data {
+    public:
+        typedef T value_type;
+        typedef std::size_t size_type;
+        typedef T& reference;
+        typedef const T& const_reference;
+        typedef T* iterator;
+        typedef const T* const_iterator;
+        static const size_type inline_size = 8;
+
+        /* Constructors */
+        FLQuant_data() : first(inline_values()), length(0), capacity(inline_size) {}
+        explicit FLQuant_data(const size_type n) : FLQuant_data() {
+            resize(n);
+        }
+        FLQuant_data(const size_type n, const T& value) : FLQuant_data() {
+            assign(n, value);
+        }
+        FLQuant_data(const FLQuant_data& source) : FLQuant_data() {
+            assign(source.begin(), source.end());
+        }
+        FLQuant_data(FLQuant_data&& source) noexcept : FLQuant_data() {
+            take(source);
+        }
+        FLQuant_data& operator = (const FLQuant_data& source){
+            if (this != &source){
+                assign(source.begin(), source.end());
+            }
+            return *this;
+        }
+        FLQuant_data& operator = (FLQuant_data&& source) noexcept {
+            if (this != &source){
+                clear();
+                release();
+                take(source);
+            }
+            return *this;
+        }
+        ~FLQuant_data(){
+            clear();
+            release();
+        }
+
+        /* Accessors */
+        size_type size() const {
+            return length;
+        }
+        bool empty() const {
+            return length == 0;
+        }
+        bool is_inline() const {
+            return first == inline_values();
+        }
+        T* data() {
+            return first;
+        }
+        const T* data() const {
+            return first;
+        }
+        iterator begin() {
+            return first;
+        }
+        iterator end() {
+            return first + length;
+        }
+        const_iterator begin() const {
+            return first;
+        }
+        const_iterator end() const {
+            return first + length;
+        }
+        T& operator [] (const size_type element){
+            return first[element];
+        }
+        const T& operator [] (const size_type element) const {
+            return first[element];
+        }
+
+        /* Modifiers */
+        void reserve(const size_type n){
+            if (n <= capacity){
+                return;
+            }
+            T* new_first = FLQuant_allocator<T>().allocate(n);
+            for (size_type element = 0; element < length; ++element){
+                new (new_first + element) T(std::move(first[element]));
+                first[element].~T();
+            }
+            release();
+            first = new_first;
+            capacity = n;
+        }
+        void resize(const size_type n){
+            reserve(n);
+            destroy_from(n);
+            for (; length < n; ++length){
+                new (first + length) T();
+            }
+        }
+        void push_back(const T& value){
+            if (length == capacity){
+                reserve(2 * capacity);
+            }
+            new (first + length) T(value);
+            ++length;
+        }
+        void clear(){
+            destroy_from(0);
+        }
+        void assign(const size_type n, const T& value){
+            clear();
+            reserve(n);
+            std::uninitialized_fill_n(first, n, value);
+            length = n;
+        }
+        template <typename InputIt, typename = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+        void assign(InputIt from, InputIt to){
+            const size_type n = std::distance(from, to);
+            clear();
+            reserve(n);
+            for (size_type element = 0; element < n; ++element, ++from){
+                new (first + element) T(*from);
+            }
+            length = n;
+        }
+
+    private:
+        T* inline_values() {
+            return reinterpret_cast<T*>(buffer);
+        }
+        const T* inline_values() const {
+            return reinterpret_cast<const T*>(buffer);
+        }
+        // Destroy the values from n onwards
+        void destroy_from(const size_type n){
+            for (size_type element = n; element < length; ++element){
+                first[element].~T();
+            }
+            length = std::min(length, n);
+        }
+        // Give back the heap block, if any, and go back to the inline values
+        void release(){
+            if (!is_inline()){
+                FLQuant_allocator<T>().deallocate(first, capacity);
+            }
+            first = inline_values();
+            capacity = inline_size;
+        }
+        // Take the values of source, leaving it empty. This must be empty and inline
+        void take(FLQuant_data& source){
+            if (source.is_inline()){
+                for (size_type element = 0; element < source.length; ++element){
+                    new (first + element) T(std::move(source.first[element]));
+                }
+                length = source.length;
+                source.clear();
+            }
+            else {
+                first = source.first;
+                length = source.length;
+                capacity = source.capacity;
+                source.first = source.inline_values();
+                source.length = 0;
+                source.capacity = inline_size;
+            }
+        }
+        T* first;
+        size_type length;
+        size_type capacity;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type buffer[inline_size];
+};
+
+template <typename T>
+const typename FLQuant_data<T>::size_type FLQuant_data<T>::inline_size;
+
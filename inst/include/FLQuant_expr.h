@@ -0,0 +1,634 @@
+/*
+ * Copyright 2014 FLR Team. Distributed under the GPL 2 or later
+ * Maintainer: Finlay Scott, JRC
+ */
+
+#define _FLQuant_expr_
+
+/*
+ * Expression templates for FLQuant arithmetic
+ * The * / + - operators, exp(), log() and pow() with FLQuants, views and scalars do not evaluate anything.
+ * They return a light expression object that holds its operands (FLQuants and views by pointer, scalars by value).
+ * The expression is evaluated element by element, in a single loop, when it is assigned to an FLQuant or reduced with quant_sum() or unit_sum().
+ * This avoids a temporary FLQuant (with its data and dimnames) for every operator in expressions like quant_sum(n * wt * mat * exp(-z)).
+ *
+ * The rules are the same as the old eager operators:
+ * The dims 1-5 of the operands must match. If one operand has 1 iter and the other has more, the single iter is used with all iters.
+ * The result is double if all the operands are double, else adouble.
+ * The units and dimnames are those of the leftmost FLQuant (the iter names come from the operand with the most iters).
+ *
+ * Expressions of doubles with no recycled operands are evaluated in blocks with the vectorised kernels of FLQuant_simd.h.
+ * Each node evaluates a block of elements into a small buffer, that stays in cache, before the next node uses it.
+ *
+ * As the expression holds pointers to its operands it must be evaluated in the full-expression in which it is made.
+ * Do not store one with auto, e.g. auto x = a * b; use FLQuant x = a * b; instead.
+ *
+ * Unlike the rest of FLQuant_base, everything here is defined in the header as it is instantiated for every shape of expression.
+ */
+
+// Number of elements evaluated at a time by the vectorised kernels
+const unsigned int FLQuant_expr_block_size = 256;
+
+/*! \brief Base class of all expression nodes
+ *
+ * Uses the curiously recurring template pattern so that the node type is known at compile time and everything is inlined.
+ */
+template <typename E>
+class FLQuant_expr {
+    public:
+        const E& derived() const {
+            return static_cast<const E&>(*this);
+        }
+};
+
+/*! \brief Type of the result of an operation
+ *
+ * The result is double if both are double else adouble.
+ */
+template <typename T1, typename T2>
+struct FLQuant_result_type {
+    typedef adouble type;
+};
+template <>
+struct FLQuant_result_type<double, double> {
+    typedef double type;
+};
+
+/*! \brief Leaf of an expression: the data of an FLQuant or a view of an FLQuant
+ *
+ * An element is found from the strides over the data. The iter stride is 0 if there is only 1 iter so that it is recycled.
+ */
+template <typename T>
+class FLQuant_expr_leaf : public FLQuant_expr<FLQuant_expr_leaf<T> > {
+    public:
+        typedef T value_type;
+        static const bool is_scalar = false;
+
+        FLQuant_expr_leaf(const FLQuant_base<T>& flq) : flq_source(&flq), flqv_source(nullptr), first(flq.data.data()) {
+            dim = {{flq.get_nquant(), flq.get_nyear(), flq.get_nunit(), flq.get_nseason(), flq.get_narea(), flq.get_niter()}};
+            unsigned int parent_stride = 1;
+            for (int dim_counter = 0; dim_counter < 6; ++dim_counter){
+                stride[dim_counter] = (dim[dim_counter] == 1) ? 0 : parent_stride;
+                parent_stride *= dim[dim_counter];
+            }
+            contiguous = true;
+        }
+
+        FLQuant_expr_leaf(const FLQuantView<T>& flqv) : flq_source(nullptr), flqv_source(&flqv), first(flqv.first), dim(flqv.dim) {
+            // Contiguous if the view has the same layout as an FLQuant of its dims
+            unsigned int expected_stride = 1;
+            contiguous = true;
+            for (int dim_counter = 0; dim_counter < 6; ++dim_counter){
+                if ((dim[dim_counter] > 1) && (flqv.stride[dim_counter] != expected_stride)){
+                    contiguous = false;
+                }
+                stride[dim_counter] = (dim[dim_counter] == 1) ? 0 : flqv.stride[dim_counter];
+                expected_stride *= dim[dim_counter];
+            }
+        }
+
+        unsigned int get_dim(const unsigned int dim_no) const {
+            return dim[dim_no];
+        }
+
+        std::string get_units() const {
+            return (flq_source != nullptr) ? flq_source->get_units() : flqv_source->get_units();
+        }
+
+        FLQuant_dimnames get_dimnames() const {
+            return (flq_source != nullptr) ? flq_source->get_dimnames() : flqv_source->get_dimnames();
+        }
+
+        // Element of the result - indices start at 0
+        T eval(const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const unsigned int iter) const {
+            return first[quant + year * stride[1] + unit * stride[2] + season * stride[3] + area * stride[4] + iter * stride[5]];
+        }
+
+        // Can the element be found from its position in the data of the result
+        bool is_flat(const unsigned int niter) const {
+            return contiguous && (dim[5] == niter);
+        }
+
+        T eval_flat(const unsigned int element) const {
+            return first[element];
+        }
+
+        // Elements element to element + n - 1 of a flat expression: the data itself
+        const T* eval_block(const unsigned int element, const unsigned int, T*) const {
+            return first + element;
+        }
+
+    private:
+        const FLQuant_base<T>* flq_source;
+        const FLQuantView<T>* flqv_source;
+        const T* first;
+        std::array<unsigned int, 6> dim;
+        std::array<unsigned int, 6> stride;
+        bool contiguous;
+};
+
+/*! \brief Leaf of an expression: a scalar that is used with every element
+ */
+template <typename T>
+class FLQuant_expr_scalar : public FLQuant_expr<FLQuant_expr_scalar<T> > {
+    public:
+        typedef T value_type;
+        static const bool is_scalar = true;
+
+        FLQuant_expr_scalar(const T& value_ip) : value(value_ip) {}
+
+        unsigned int get_dim(const unsigned int) const {
+            return 1;
+        }
+        std::string get_units() const {
+            return "";
+        }
+        FLQuant_dimnames get_dimnames() const {
+            return FLQuant_dimnames();
+        }
+        T eval(const unsigned int, const unsigned int, const unsigned int, const unsigned int, const unsigned int, const unsigned int) const {
+            return value;
+        }
+        bool is_flat(const unsigned int) const {
+            return true;
+        }
+        T eval_flat(const unsigned int) const {
+            return value;
+        }
+        const T* eval_block(const unsigned int, const unsigned int n, T* buffer) const {
+            std::fill(buffer, buffer + n, value);
+            return buffer;
+        }
+        const T& get_value() const {
+            return value;
+        }
+
+    private:
+        T value;
+};
+
+// The elementwise operations
+// apply_block() is the operation on blocks of doubles, used when the expression is evaluated with the vectorised kernels
+template <simd_op op>
+struct FLQuant_expr_simd_op {
+    static void apply_block(const double* x, const double* y, double* out, const unsigned int n) { simd_binary(op, x, y, out, n); }
+    static void apply_block(const double* x, const double y, double* out, const unsigned int n) { simd_binary(op, x, y, out, n); }
+    static void apply_block(const double x, const double* y, double* out, const unsigned int n) { simd_binary(op, x, y, out, n); }
+};
+struct FLQuant_expr_multiplies : public FLQuant_expr_simd_op<simd_multiplies> {
+    static const char* name() { return "multiply"; }
+    template <typename T1, typename T2>
+    static typename FLQuant_result_type<T1,T2>::type apply(const T1& x, const T2& y) { return x * y; }
+};
+struct FLQuant_expr_divides : public FLQuant_expr_simd_op<simd_divides> {
+    static const char* name() { return "divide"; }
+    template <typename T1, typename T2>
+    static typename FLQuant_result_type<T1,T2>::type apply(const T1& x, const T2& y) { return x / y; }
+};
+struct FLQuant_expr_minus : public FLQuant_expr_simd_op<simd_minus> {
+    static const char* name() { return "subtract"; }
+    template <typename T1, typename T2>
+    static typename FLQuant_result_type<T1,T2>::type apply(const T1& x, const T2& y) { return x - y; }
+};
+struct FLQuant_expr_plus : public FLQuant_expr_simd_op<simd_plus> {
+    static const char* name() { return "add"; }
+    template <typename T1, typename T2>
+    static typename FLQuant_result_type<T1,T2>::type apply(const T1& x, const T2& y) { return x + y; }
+};
+struct FLQuant_expr_pow {
+    static const char* name() { return "raise"; }
+    template <typename T1, typename T2>
+    static typename FLQuant_result_type<T1,T2>::type apply(const T1& x, const T2& y) { using std::pow; return pow(x, y); }
+    // The power is always a scalar
+    static void apply_block(const double* x, const double y, double* out, const unsigned int n) {
+        for (unsigned int element = 0; element < n; ++element){
+            out[element] = std::pow(x[element], y);
+        }
+    }
+};
+struct FLQuant_expr_exp {
+    template <typename T>
+    static T apply(const T& x) { using std::exp; return exp(x); }
+    static void apply_block(const double* x, double* out, const unsigned int n) { simd_exp(x, out, n); }
+};
+struct FLQuant_expr_log {
+    template <typename T>
+    static T apply(const T& x) { using std::log; return log(x); }
+    static void apply_block(const double* x, double* out, const unsigned int n) { simd_log(x, out, n); }
+};
+
+// Apply a binary operation to blocks of two nodes
+// Scalars are passed to the kernels as they are
+template <typename F, typename L, typename R>
+void FLQuant_expr_apply_block(const L& lhs, const R& rhs, const unsigned int element, const unsigned int n, double* buffer){
+    double rhs_buffer[FLQuant_expr_block_size];
+    const double* x = lhs.eval_block(element, n, buffer);
+    const double* y = rhs.eval_block(element, n, rhs_buffer);
+    F::apply_block(x, y, buffer, n);
+}
+template <typename F, typename R>
+void FLQuant_expr_apply_block(const FLQuant_expr_scalar<double>& lhs, const R& rhs, const unsigned int element, const unsigned int n, double* buffer){
+    F::apply_block(lhs.get_value(), rhs.eval_block(element, n, buffer), buffer, n);
+}
+template <typename F, typename L>
+void FLQuant_expr_apply_block(const L& lhs, const FLQuant_expr_scalar<double>& rhs, const unsigned int element, const unsigned int n, double* buffer){
+    F::apply_block(lhs.eval_block(element, n, buffer), rhs.get_value(), buffer, n);
+}
+
+/*! \brief An elementwise binary operation on two expressions
+ *
+ * Checks the dims when it is made so that errors are raised where the operator is used.
+ */
+template <typename L, typename R, typename F>
+class FLQuant_expr_binary : public FLQuant_expr<FLQuant_expr_binary<L,R,F> > {
+    public:
+        typedef typename FLQuant_result_type<typename L::value_type, typename R::value_type>::type value_type;
+        static const bool is_scalar = false;
+
+        FLQuant_expr_binary(const L& lhs_ip, const R& rhs_ip) : lhs(lhs_ip), rhs(rhs_ip) {
+            if (!L::is_scalar && !R::is_scalar){
+                for (unsigned int dim_counter = 0; dim_counter < 5; ++dim_counter){
+                    if (lhs.get_dim(dim_counter) != rhs.get_dim(dim_counter)){
+                        Rcpp::stop(std::string("You cannot ") + F::name() + " FLQuants as dimensions 1-5 do not match.");
+                    }
+                }
+                if ((lhs.get_dim(5) != rhs.get_dim(5)) && (lhs.get_dim(5) != 1) && (rhs.get_dim(5) != 1)){
+                    Rcpp::stop(std::string("You cannot ") + F::name() + " FLQuants as the number of iters do not match and neither is 1.");
+                }
+            }
+        }
+
+        unsigned int get_dim(const unsigned int dim_no) const {
+            if (L::is_scalar){
+                return rhs.get_dim(dim_no);
+            }
+            if (R::is_scalar || (dim_no < 5)){
+                return lhs.get_dim(dim_no);
+            }
+            return std::max(lhs.get_dim(5), rhs.get_dim(5));
+        }
+
+        std::string get_units() const {
+            return L::is_scalar ? rhs.get_units() : lhs.get_units();
+        }
+
+        FLQuant_dimnames get_dimnames() const {
+            if (L::is_scalar){
+                return rhs.get_dimnames();
+            }
+            FLQuant_dimnames dimnames = lhs.get_dimnames();
+            if (!R::is_scalar && (rhs.get_dim(5) > lhs.get_dim(5))){
+                dimnames.set_names(5, rhs.get_dimnames()[5]);
+            }
+            return dimnames;
+        }
+
+        value_type eval(const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const unsigned int iter) const {
+            return F::apply(lhs.eval(quant, year, unit, season, area, iter), rhs.eval(quant, year, unit, season, area, iter));
+        }
+
+        bool is_flat(const unsigned int niter) const {
+            return lhs.is_flat(niter) && rhs.is_flat(niter);
+        }
+
+        value_type eval_flat(const unsigned int element) const {
+            return F::apply(lhs.eval_flat(element), rhs.eval_flat(element));
+        }
+
+        // Only for expressions of doubles. The result is written into the buffer.
+        const value_type* eval_block(const unsigned int element, const unsigned int n, value_type* buffer) const {
+            FLQuant_expr_apply_block<F>(lhs, rhs, element, n, buffer);
+            return buffer;
+        }
+
+    private:
+        L lhs;
+        R rhs;
+};
+
+/*! \brief An elementwise function of an expression
+ */
+template <typename E, typename F>
+class FLQuant_expr_unary : public FLQuant_expr<FLQuant_expr_unary<E,F> > {
+    public:
+        typedef typename E::value_type value_type;
+        static const bool is_scalar = false;
+
+        FLQuant_expr_unary(const E& arg_ip) : arg(arg_ip) {}
+
+        unsigned int get_dim(const unsigned int dim_no) const {
+            return arg.get_dim(dim_no);
+        }
+        std::string get_units() const {
+            return arg.get_units();
+        }
+        FLQuant_dimnames get_dimnames() const {
+            return arg.get_dimnames();
+        }
+        value_type eval(const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const unsigned int iter) const {
+            return F::apply(arg.eval(quant, year, unit, season, area, iter));
+        }
+        bool is_flat(const unsigned int niter) const {
+            return arg.is_flat(niter);
+        }
+        value_type eval_flat(const unsigned int element) const {
+            return F::apply(arg.eval_flat(element));
+        }
+        const value_type* eval_block(const unsigned int element, const unsigned int n, value_type* buffer) const {
+            F::apply_block(arg.eval_block(element, n, buffer), buffer, n);
+            return buffer;
+        }
+
+    private:
+        E arg;
+};
+
+/*! \brief What can be used in an expression and the node it becomes
+ *
+ * FLQuants and views become leaves, doubles and adoubles become scalars and expressions are used as they are.
+ * Anything else is not an operand so the operators below are not considered for it.
+ */
+template <typename X, typename Enable = void>
+struct FLQuant_operand {
+    static const bool is_operand = false;
+    static const bool is_array = false;
+};
+
+template <>
+struct FLQuant_operand<double> {
+    static const bool is_operand = true;
+    static const bool is_array = false;
+    typedef FLQuant_expr_scalar<double> node_type;
+    static node_type make(const double& x) { return node_type(x); }
+};
+
+template <>
+struct FLQuant_operand<adouble> {
+    static const bool is_operand = true;
+    static const bool is_array = false;
+    typedef FLQuant_expr_scalar<adouble> node_type;
+    static node_type make(const adouble& x) { return node_type(x); }
+};
+
+template <typename T>
+struct FLQuant_operand<FLQuant_base<T> > {
+    static const bool is_operand = true;
+    static const bool is_array = true;
+    typedef FLQuant_expr_leaf<T> node_type;
+    static node_type make(const FLQuant_base<T>& x) { return node_type(x); }
+};
+
+template <typename T>
+struct FLQuant_operand<FLQuantView<T> > {
+    static const bool is_operand = true;
+    static const bool is_array = true;
+    typedef FLQuant_expr_leaf<T> node_type;
+    static node_type make(const FLQuantView<T>& x) { return node_type(x); }
+};
+
+template <typename E>
+struct FLQuant_operand<E, typename std::enable_if<std::is_base_of<FLQuant_expr<E>, E>::value>::type> {
+    static const bool is_operand = true;
+    static const bool is_array = true;
+    typedef E node_type;
+    static const node_type& make(const E& x) { return x; }
+};
+
+// The type of an operation on two operands - only defined if at least one of them is an FLQuant, a view or an expression
+template <typename L, typename R, typename F, bool enable = FLQuant_operand<L>::is_operand && FLQuant_operand<R>::is_operand && (FLQuant_operand<L>::is_array || FLQuant_operand<R>::is_array)>
+struct FLQuant_expr_binary_type {
+};
+template <typename L, typename R, typename F>
+struct FLQuant_expr_binary_type<L, R, F, true> {
+    typedef FLQuant_expr_binary<typename FLQuant_operand<L>::node_type, typename FLQuant_operand<R>::node_type, F> type;
+};
+
+// The type of a function of an operand - only defined for FLQuants, views and expressions
+template <typename X, typename F, bool enable = FLQuant_operand<X>::is_array>
+struct FLQuant_expr_unary_type {
+};
+template <typename X, typename F>
+struct FLQuant_expr_unary_type<X, F, true> {
+    typedef FLQuant_expr_unary<typename FLQuant_operand<X>::node_type, F> type;
+};
+
+//------------ Arithmetic operators --------------
+
+template <typename L, typename R>
+typename FLQuant_expr_binary_type<L, R, FLQuant_expr_multiplies>::type operator * (const L& lhs, const R& rhs){
+    return typename FLQuant_expr_binary_type<L, R, FLQuant_expr_multiplies>::type(FLQuant_operand<L>::make(lhs), FLQuant_operand<R>::make(rhs));
+}
+
+template <typename L, typename R>
+typename FLQuant_expr_binary_type<L, R, FLQuant_expr_divides>::type operator / (const L& lhs, const R& rhs){
+    return typename FLQuant_expr_binary_type<L, R, FLQuant_expr_divides>::type(FLQuant_operand<L>::make(lhs), FLQuant_operand<R>::make(rhs));
+}
+
+template <typename L, typename R>
+typename FLQuant_expr_binary_type<L, R, FLQuant_expr_minus>::type operator - (const L& lhs, const R& rhs){
+    return typename FLQuant_expr_binary_type<L, R, FLQuant_expr_minus>::type(FLQuant_operand<L>::make(lhs), FLQuant_operand<R>::make(rhs));
+}
+
+template <typename L, typename R>
+typename FLQuant_expr_binary_type<L, R, FLQuant_expr_plus>::type operator + (const L& lhs, const R& rhs){
+    return typename FLQuant_expr_binary_type<L, R, FLQuant_expr_plus>::type(FLQuant_operand<L>::make(lhs), FLQuant_operand<R>::make(rhs));
+}
+
+// Power: AD ^ AD = AD,  AD ^ D = AD, D ^ AD = AD, D ^ D = D
+// Only with a scalar power, as before
+template <typename X, typename P>
+typename std::enable_if<FLQuant_operand<X>::is_array && !FLQuant_operand<P>::is_array, typename FLQuant_expr_binary_type<X, P, FLQuant_expr_pow>::type>::type pow(const X& flq, const P& power){
+    return typename FLQuant_expr_binary_type<X, P, FLQuant_expr_pow>::type(FLQuant_operand<X>::make(flq), FLQuant_operand<P>::make(power));
+}
+
+template <typename X>
+typename FLQuant_expr_unary_type<X, FLQuant_expr_exp>::type exp(const X& flq){
+    return typename FLQuant_expr_unary_type<X, FLQuant_expr_exp>::type(FLQuant_operand<X>::make(flq));
+}
+
+template <typename X>
+typename FLQuant_expr_unary_type<X, FLQuant_expr_log>::type log(const X& flq){
+    return typename FLQuant_expr_unary_type<X, FLQuant_expr_log>::type(FLQuant_operand<X>::make(flq));
+}
+
+//------------ Evaluation --------------
+
+/*! \brief Evaluate a flat expression into an array
+ *
+ * Element by element, or in blocks with the vectorised kernels if the expression and the array are double.
+ * The array must not be used by the expression.
+ */
+template <typename E, typename T>
+void FLQuant_expr_eval_flat(const E& expr, T* out, const unsigned int size){
+    for (unsigned int element = 0; element < size; ++element){
+        out[element] = expr.eval_flat(element);
+    }
+}
+
+template <typename E>
+typename std::enable_if<std::is_same<typename E::value_type, double>::value>::type FLQuant_expr_eval_flat(const E& expr, double* out, const unsigned int size){
+    const unsigned int nblocks = (size + FLQuant_expr_block_size - 1) / FLQuant_expr_block_size;
+    FLQuant_parallel_for<double>(nblocks, FLQuant_expr_block_size, [&] (std::size_t first, std::size_t last) {
+        for (unsigned int element = first * FLQuant_expr_block_size; element < std::min<std::size_t>(last * FLQuant_expr_block_size, size); element += FLQuant_expr_block_size){
+            const unsigned int n = std::min(FLQuant_expr_block_size, size - element);
+            const double* result = expr.eval_block(element, n, out + element);
+            if (result != out + element){
+                std::copy(result, result + n, out + element);
+            }
+        }
+    });
+}
+
+/*! \brief Evaluate a flat expression into an array that may also be used by the expression
+ *
+ * Each element, or block of elements, is evaluated before it is written.
+ */
+template <typename E, typename T>
+void FLQuant_expr_assign_flat(const E& expr, T* out, const unsigned int size){
+    FLQuant_expr_eval_flat(expr, out, size);
+}
+
+template <typename E>
+typename std::enable_if<std::is_same<typename E::value_type, double>::value>::type FLQuant_expr_assign_flat(const E& expr, double* out, const unsigned int size){
+    const unsigned int nblocks = (size + FLQuant_expr_block_size - 1) / FLQuant_expr_block_size;
+    FLQuant_parallel_for<double>(nblocks, FLQuant_expr_block_size, [&] (std::size_t first, std::size_t last) {
+        double buffer[FLQuant_expr_block_size];
+        for (unsigned int element = first * FLQuant_expr_block_size; element < std::min<std::size_t>(last * FLQuant_expr_block_size, size); element += FLQuant_expr_block_size){
+            const unsigned int n = std::min(FLQuant_expr_block_size, size - element);
+            const double* result = expr.eval_block(element, n, buffer);
+            std::copy(result, result + n, out + element);
+        }
+    });
+}
+
+/*! \brief Evaluate an expression into a new FLQuant
+ *
+ * The elements are evaluated in the order of the data in a single loop.
+ */
+template <typename T>
+template <typename E, typename>
+FLQuant_base<T>::FLQuant_base(const FLQuant_expr<E>& flq_expr){
+    const E& expr = flq_expr.derived();
+    dim.resize(6);
+    for (unsigned int dim_counter = 0; dim_counter < 6; ++dim_counter){
+        dim[dim_counter] = expr.get_dim(dim_counter);
+    }
+    units = expr.get_units();
+    dimnames = expr.get_dimnames();
+    const unsigned int size = dim[0] * dim[1] * dim[2] * dim[3] * dim[4] * dim[5];
+    if (expr.is_flat(dim[5])){
+        data.resize(size);
+        FLQuant_expr_eval_flat(expr, data.data(), size);
+        return;
+    }
+    data.reserve(size);
+    for (unsigned int iter = 0; iter < dim[5]; ++iter){
+        for (unsigned int area = 0; area < dim[4]; ++area){
+            for (unsigned int season = 0; season < dim[3]; ++season){
+                for (unsigned int unit = 0; unit < dim[2]; ++unit){
+                    for (unsigned int year = 0; year < dim[1]; ++year){
+                        for (unsigned int quant = 0; quant < dim[0]; ++quant){
+                            data.push_back(expr.eval(quant, year, unit, season, area, iter));
+    }}}}}}
+}
+
+/*! \brief Assign an expression to an FLQuant
+ *
+ * If the dims of the FLQuant are already those of the result, and no operand is recycled, the data is overwritten in place.
+ * This is safe even if the FLQuant is also an operand as each element only depends on the same element of the operands.
+ * Otherwise a new FLQuant is made and moved in.
+ */
+template <typename T>
+template <typename E, typename>
+FLQuant_base<T>& FLQuant_base<T>::operator = (const FLQuant_expr<E>& flq_expr){
+    const E& expr = flq_expr.derived();
+    bool same_dim = (dim.size() == 6);
+    for (unsigned int dim_counter = 0; same_dim && (dim_counter < 6); ++dim_counter){
+        same_dim = (dim[dim_counter] == expr.get_dim(dim_counter));
+    }
+    if (same_dim && expr.is_flat(dim[5])){
+        // Dimnames and units first as they may come from this FLQuant
+        FLQuant_dimnames new_dimnames = expr.get_dimnames();
+        units = expr.get_units();
+        dimnames = new_dimnames;
+        FLQuant_expr_assign_flat(expr, data.data(), data.size());
+        return *this;
+    }
+    return *this = FLQuant_base<T>(flq_expr);
+}
+
+/*! \brief Sum over the quant dimension of an expression
+ *
+ * The expression is evaluated as it is summed so no intermediate FLQuant is made.
+ */
+template <typename E>
+FLQuant_base<typename E::value_type> quant_sum(const FLQuant_expr<E>& flq_expr){
+    typedef typename E::value_type T;
+    const E& expr = flq_expr.derived();
+    std::vector<unsigned int> dim(6);
+    for (unsigned int dim_counter = 0; dim_counter < 6; ++dim_counter){
+        dim[dim_counter] = expr.get_dim(dim_counter);
+    }
+    FLQuant_base<T> sum_flq(1, dim[1], dim[2], dim[3], dim[4], dim[5]);
+    FLQuant_dimnames dimnames = expr.get_dimnames();
+    dimnames.set_names(0, summary_names(0));
+    sum_flq.set_dimnames(dimnames);
+    sum_flq.set_units(expr.get_units());
+    typename FLQuant_base<T>::iterator sum_iterator = sum_flq.begin();
+    const bool flat = expr.is_flat(dim[5]);
+    unsigned int element = 0;
+    for (unsigned int iter = 0; iter < dim[5]; ++iter){
+        for (unsigned int area = 0; area < dim[4]; ++area){
+            for (unsigned int season = 0; season < dim[3]; ++season){
+                for (unsigned int unit = 0; unit < dim[2]; ++unit){
+                    for (unsigned int year = 0; year < dim[1]; ++year){
+                        T sum = 0.0;
+                        if (flat){
+                            for (unsigned int quant = 0; quant < dim[0]; ++quant, ++element){
+                                sum += expr.eval_flat(element);
+                            }
+                        }
+                        else {
+                            for (unsigned int quant = 0; quant < dim[0]; ++quant){
+                                sum += expr.eval(quant, year, unit, season, area, iter);
+                            }
+                        }
+                        *sum_iterator = sum;
+                        ++sum_iterator;
+    }}}}}
+    return sum_flq;
+}
+
+/*! \brief Sum over the unit dimension of an expression
+ *
+ * The expression is evaluated as it is summed so no intermediate FLQuant is made.
+ */
+template <typename E>
+FLQuant_base<typename E::value_type> unit_sum(const FLQuant_expr<E>& flq_expr){
+    typedef typename E::value_type T;
+    const E& expr = flq_expr.derived();
+    std::vector<unsigned int> dim(6);
+    for (unsigned int dim_counter = 0; dim_counter < 6; ++dim_counter){
+        dim[dim_counter] = expr.get_dim(dim_counter);
+    }
+    FLQuant_base<T> sum_flq(dim[0], dim[1], 1, dim[3], dim[4], dim[5]);
+    FLQuant_dimnames dimnames = expr.get_dimnames();
+    dimnames.set_names(2, summary_names(2));
+    sum_flq.set_dimnames(dimnames);
+    sum_flq.set_units(expr.get_units());
+    typename FLQuant_base<T>::iterator sum_iterator = sum_flq.begin();
+    for (unsigned int iter = 0; iter < dim[5]; ++iter){
+        for (unsigned int area = 0; area < dim[4]; ++area){
+            for (unsigned int season = 0; season < dim[3]; ++season){
+                for (unsigned int year = 0; year < dim[1]; ++year){
+                    for (unsigned int quant = 0; quant < dim[0]; ++quant){
+                        T sum = 0.0;
+                        for (unsigned int unit = 0; unit < dim[2]; ++unit){
+                            sum += expr.eval(quant, year, unit, season, area, iter);
+                        }
+                        *sum_iterator = sum;
+                        ++sum_iterator;
+    }}}}}
+    return sum_flq;
+}
+
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2014 FLR Team. Distributed under the GPL 2 or later
+ * Maintainer: Finlay Scott, JRC
+ */
+
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+
+#include <Rcpp.h>
+
+#define _FLQuant_index_
+
+/*
+ * Fixed size indices into the dimensions of an FLQuant
+ * Index6 covers quant - iter, Index5 year - iter (used for values with no age structure, e.g. effort, SSB, revenue).
+ * The indices live on the stack so making and passing them does not allocate.
+ * A std::vector<unsigned int> of the right length converts to them, so code that builds vectors (e.g. from get_dim()) still works.
+ */
+
+template <unsigned int N> class FLQuant_index;
+template <typename... Args> struct FLQuant_index_args;
+
+// True if all the arguments can be used as an index
+template <>
+struct FLQuant_index_args<> : std::true_type {};
+template <typename Arg, typename... Args>
+struct FLQuant_index_args<Arg, Args...> : std::integral_constant<bool, std::is_integral<Arg>::value && FLQuant_index_args<Args...>::value> {};
+
+/*! \brief N indices into the dimensions of an FLQuant
+ *
+ * Indexing the values is the same as for a vector (starting at 0) but the values themselves start at 1, as everywhere else.
+ */
+template <unsigned int N>
+class FLQuant_index {
+    public:
+        FLQuant_index() : values() {} // All 0
+        // e.g. Index6 indices{1, year, 1, season, 1, niter}
+        template <typename... Args, typename = typename std::enable_if<(sizeof...(Args) == N) && FLQuant_index_args<Args...>::value>::type>
+        constexpr FLQuant_index(const Args... args) : values{static_cast<unsigned int>(args)...} {}
+        FLQuant_index(const std::vector<unsigned int>& indices){
+            if (indices.size() != N){
+                Rcpp::stop("In FLQuant_index. Indices not of length %i\n", N);
+            }
+            std::copy(indices.begin(), indices.end(), values);
+        }
+
+        static constexpr unsigned int size(){
+            return N;
+        }
+        constexpr unsigned int operator [] (const unsigned int i) const {
+            return values[i];
+        }
+        unsigned int& operator [] (const unsigned int i){
+            return values[i];
+        }
+        const unsigned int* begin() const {
+            return values;
+        }
+        const unsigned int* end() const {
+            return values + N;
+        }
+        unsigned int* begin(){
+            return values;
+        }
+        unsigned int* end(){
+            return values + N;
+        }
+        std::vector<unsigned int> to_vector() const {
+            return std::vector<unsigned int>(values, values + N);
+        }
+        bool operator == (const FLQuant_index& rhs) const {
+            return std::equal(values, values + N, rhs.values);
+        }
+        bool operator != (const FLQuant_index& rhs) const {
+            return !(*this == rhs);
+        }
+
+    private:
+        unsigned int values[N];
+};
+
+typedef FLQuant_index<5> Index5;
+typedef FLQuant_index<6> Index6;
+
+/*! \brief Add a quant index in front of year - iter indices
+ */
+inline Index6 add_quant(const unsigned int quant, const Index5& indices){
+    return Index6(quant, indices[0], indices[1], indices[2], indices[3], indices[4]);
+}
+
+/*! \brief Drop the quant index, e.g. of get_dim()
+ */
+inline Index5 drop_quant(const Index6& indices){
+    return Index5(indices[1], indices[2], indices[3], indices[4], indices[5]);
+}
+
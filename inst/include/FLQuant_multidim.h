@@ -6,10 +6,9 @@
 
 // Multidimensional FLQuant classes.
 // These add a 7th (and in the future 8th) dimension to the already 6th dimensional of the FLQuant class.
-// However, they are really just lists of FLQuant objects so the FLQuant objects do not have to be the same size.
-// Consequently, the sizes of the FLQuants are stored at the FLQuant level, not the FLQuant7 level.
+// The FLQuant objects do not have to be the same size, so the sizes are stored for each element (slice), not at the FLQuant7 level.
+// The values of all the slices are held contiguously in one block.
 // Useful for storing harvest rates for multiple stocks etc.
-// The extra dimensions are implemented using STL vector containers.
 
 #ifndef _FLQuant_base_
 #define _FLQuant_base_
@@ -20,31 +19,95 @@
 
 #define _FLQuant_multidim_
 
+/*! \brief The shape, units and dimnames of a slice of an FLQuant7
+ *
+ * Slices made together with the same dims share one header.
+ */
+struct FLQuant7_header {
+    std::vector<unsigned int> dim;
+    std::size_t size;
+    std::string units;
+    FLQuant_dimnames dimnames;
+};
+
+/*! \brief A view of one slice (7th dimension element) of an FLQuant7
+ *
+ * The values are those in the data of the FLQuant7, so changing them changes the FLQuant7.
+ * The FLQuant7 must outlive the slice and must not have slices added while the slice is used.
+ * As with an FLQuant, if the slice has 1 iter, any iter gives the first one.
+ */
+template <typename T>
+class FLQuant7_slice {
+    public:
+        FLQuant7_slice(T* first_in, const FLQuant7_header* header_in);
+
+        /* Get accessors */
+        const std::vector<unsigned int>& get_dim() const;
+        unsigned int get_size() const;
+        unsigned int get_niter() const;
+        const std::string& get_units() const;
+        const FLQuant_dimnames& get_dimnames() const;
+
+        /* Single values - starts at 1 */
+		T operator () (const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const unsigned int iter) const;
+		T& operator () (const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const unsigned int iter);
+
+        /* The contiguous values of the slice */
+        T* begin();
+        T* end();
+        const T* begin() const;
+        const T* end() const;
+
+        FLQuant_base<T> to_FLQuant() const; // Copy the slice into a new FLQuant
+        FLQuant7_slice& operator = (const FLQuant_base<T>& flq); // Overwrite the values of the slice. The dims must match.
+
+    private:
+        T* first;
+        const FLQuant7_header* header;
+};
+
+/*! \brief FLQuants stacked along a 7th dimension, e.g. one per biol
+ *
+ * The values of all the slices are held in one contiguous block, slice after slice, each in the order of an FLQuant.
+ * The slices can have different dims. The dims, units and dimnames of each slice are held in a header, shared between slices made together.
+ * Slices are got as FLQuant7_slice views, or copied out as FLQuants.
+ * Operations over all slices can work directly on the block (see get_data()).
+ */
 template <typename T>
 class FLQuant7_base {
 	public:
+        typedef std::vector<T, FLQuant_allocator<T> > data_type;
+
         /* Constructors */
 		FLQuant7_base();
 		FLQuant7_base(SEXP lst_sexp); // Used as intrusive 'as' - takes a List of FLQuant objects
-		FLQuant7_base(FLQuant_base<T> flq); // Constructor from an FLQuant
+		FLQuant7_base(const FLQuant_base<T>& flq); // Constructor from an FLQuant
+		FLQuant7_base(const std::vector<unsigned int>& dim, const unsigned int ndim7, const T value=0.0); // ndim7 slices of the same dims, sharing a header
         operator SEXP() const; // Used as intrusive 'wrap'
 
 		FLQuant7_base(const FLQuant7_base& FLQuant7_base_source); // copy constructor to ensure that copies (i.e. when passing to functions) are deep
 		FLQuant7_base& operator = (const FLQuant7_base& FLQuant7_source); // Assignment operator for a deep copy
+		FLQuant7_base(FLQuant7_base&& FLQuant7_source) noexcept; // move constructor so that temporaries are not copied
+		FLQuant7_base& operator = (FLQuant7_base&& FLQuant7_source) noexcept; // Move assignment operator
 
         /* () accessors */
-        // If accessing by single element, returns the FLQuant_base<T>
+        // If accessing by single element, returns the slice, as a copy if const or a view if not
         // If accessing by multiple elements, returns the T value
 		FLQuant_base<T> operator () (const unsigned int element=1) const; // only gets an FLQuant so const reinforced 
 		T operator () (const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const unsigned int iter, const unsigned int dim7=1) const; // only gets an element so const reinforced 
-		FLQuant_base<T>& operator () (const unsigned int element=1); // gets and sets an FLQuant so const not reinforced
+		FLQuant7_slice<T> operator () (const unsigned int element=1); // gets and sets the values of a slice so const not reinforced
 		T& operator () (const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const unsigned int iter, const unsigned int dim7=1); // gets and sets an element so const not reinforced
-        void operator() (const FLQuant_base<T> flq); // Add another FLQuant_base<T> to the data
+        void operator() (const FLQuant_base<T>& flq); // Add another FLQuant_base<T> as a new slice
         unsigned int get_ndim7() const;
+        const std::vector<unsigned int>& get_dim(const unsigned int element=1) const;
+        const data_type& get_data() const; // The values of all the slices
+        data_type& get_data();
 
     private:
-
-        std::vector<FLQuant_base<T> > data;
+        void check_element(const unsigned int element) const;
+        data_type data;
+        std::vector<std::size_t> offsets; // Start of each slice in data
+        std::vector<std::shared_ptr<const FLQuant7_header> > headers;
 };
 
 typedef FLQuant7_base<double> FLQuant7;
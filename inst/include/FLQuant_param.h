@@ -0,0 +1,174 @@
+/*
+ * Copyright 2014 FLR Team. Distributed under the GPL 2 or later
+ * Maintainer: Finlay Scott, JRC
+ */
+
+// Necessary check to avoid the redefinition of FLQuant_base in the RcppExports.cpp
+#ifndef _FLQuant_base_
+#define _FLQuant_base_
+#include "FLQuant_base.h"
+#endif
+
+#define _FLQuant_param_
+
+/*
+ * Storage of the parameter slots of the biols and catches (wt, m, spwn, fec, mat, landings.wt, discards.wt, catch.sel, price and catch.q)
+ * These are double slots that are only read during a projection.
+ * By default they are held in an FLQuant, as before.
+ * In single precision mode (see set_single_precision_params()) the values are held as floats, which halves their memory and traffic in stochastic OMs with many iters.
+ * The values are widened to double where they are read: by the element and subset accessors and, without copying, by views used in FLQuant expressions.
+ * The states (e.g. n, landings.n) and the solver are not affected. They are still double or adouble.
+ * The mode is read when a slot is made, i.e. when the biols and fisheries come in from R.
+ */
+
+class FLQuant_param_view;
+
+class FLQuant_param {
+    public:
+        typedef std::vector<float, FLQuant_allocator<float> > compact_type;
+
+        /* Constructors */
+        FLQuant_param();
+        FLQuant_param(SEXP flq_sexp); // Used as intrusive 'as', takes an FLQuant
+        FLQuant_param(const FLQuant& flq);
+        operator SEXP() const; // Used as intrusive 'wrap' - returns an FLQuant
+
+        /* Storage mode of the slots made from now on */
+        static void set_single(const bool single_in);
+        static bool get_single();
+
+        /* Get accessors */
+        bool is_single() const;
+        const std::vector<unsigned int>& get_dim() const;
+        unsigned int get_size() const;
+        const std::string& get_units() const;
+        const FLQuant_dimnames& get_dimnames() const;
+
+        /* Get single values - starts at 1 */
+        double operator () (const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const unsigned int iter) const;
+        double operator () (const Index6& indices) const;
+        /* Get a subset or all of the values as an FLQuant */
+        FLQuant operator () (const Index6& indices_min, const Index6& indices_max) const;
+        FLQuant to_FLQuant() const;
+        /* Get a view of a subset - no data is copied */
+        FLQuant_param_view view(const Index6& indices_min, const Index6& indices_max) const;
+
+        friend class FLQuant_param_view;
+
+    private:
+        unsigned int get_data_element(const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, unsigned int iter) const;
+        static bool single;
+        FLQuant full; // The values in double precision mode
+        compact_type compact; // The values in single precision mode
+        std::vector<unsigned int> dim;
+        std::string units;
+        FLQuant_dimnames dimnames;
+};
+
+/*! \brief A view of a subset of an FLQuant_param
+ *
+ * As FLQuantView, but over either storage mode. It can be used in FLQuant expressions, where the values are widened to double as they are read.
+ * The parent must outlive the view.
+ */
+class FLQuant_param_view {
+    public:
+        FLQuant_param_view(const FLQuant_param& param); // All of the FLQuant_param
+        FLQuant_param_view(const FLQuant_param& param, const Index6& indices_min, const Index6& indices_max);
+
+        /* Get accessors */
+        std::vector<unsigned int> get_dim() const;
+        std::string get_units() const;
+        FLQuant_dimnames get_dimnames() const; // The dimnames of the parent over the subset
+
+        FLQuant to_FLQuant() const; // Copy the subset into a new FLQuant
+
+        friend class FLQuant_expr_param_leaf;
+
+    private:
+        const FLQuant_param* parent;
+        const double* full_first; // First element of the view in the parent in double precision mode, else nullptr
+        const float* compact_first; // First element of the view in the parent in single precision mode, else nullptr
+        std::array<unsigned int, 6> indices_min; // Position of the view in the parent
+        std::array<unsigned int, 6> dim;
+        std::array<unsigned int, 6> stride; // Distance between consecutive elements of each dimension in the data of the parent
+};
+
+/*! \brief Leaf of an expression: an FLQuant_param or a view of one
+ *
+ * Like FLQuant_expr_leaf (see FLQuant_expr.h) but the values are widened to double. A block of floats is widened into the buffer.
+ * The view is held by value so that a whole FLQuant_param can be used in an expression.
+ */
+class FLQuant_expr_param_leaf : public FLQuant_expr<FLQuant_expr_param_leaf> {
+    public:
+        typedef double value_type;
+        static const bool is_scalar = false;
+
+        FLQuant_expr_param_leaf(const FLQuant_param_view& flqv) : flqv_source(flqv), full_first(flqv.full_first), compact_first(flqv.compact_first), dim(flqv.dim) {
+            unsigned int expected_stride = 1;
+            contiguous = true;
+            for (int dim_counter = 0; dim_counter < 6; ++dim_counter){
+                if ((dim[dim_counter] > 1) && (flqv.stride[dim_counter] != expected_stride)){
+                    contiguous = false;
+                }
+                stride[dim_counter] = (dim[dim_counter] == 1) ? 0 : flqv.stride[dim_counter];
+                expected_stride *= dim[dim_counter];
+            }
+        }
+
+        unsigned int get_dim(const unsigned int dim_no) const {
+            return dim[dim_no];
+        }
+
+        std::string get_units() const {
+            return flqv_source.get_units();
+        }
+
+        FLQuant_dimnames get_dimnames() const {
+            return flqv_source.get_dimnames();
+        }
+
+        double eval(const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const unsigned int iter) const {
+            return eval_flat(quant + year * stride[1] + unit * stride[2] + season * stride[3] + area * stride[4] + iter * stride[5]);
+        }
+
+        bool is_flat(const unsigned int niter) const {
+            return contiguous && (dim[5] == niter);
+        }
+
+        double eval_flat(const unsigned int element) const {
+            return (full_first != nullptr) ? full_first[element] : static_cast<double>(compact_first[element]);
+        }
+
+        const double* eval_block(const unsigned int element, const unsigned int n, double* buffer) const {
+            if (full_first != nullptr){
+                return full_first + element;
+            }
+            std::copy(compact_first + element, compact_first + element + n, buffer);
+            return buffer;
+        }
+
+    private:
+        FLQuant_param_view flqv_source;
+        const double* full_first;
+        const float* compact_first;
+        std::array<unsigned int, 6> dim;
+        std::array<unsigned int, 6> stride;
+        bool contiguous;
+};
+
+template <>
+struct FLQuant_operand<FLQuant_param> {
+    static const bool is_operand = true;
+    static const bool is_array = true;
+    typedef FLQuant_expr_param_leaf node_type;
+    static node_type make(const FLQuant_param& x) { return node_type(FLQuant_param_view(x)); }
+};
+
+template <>
+struct FLQuant_operand<FLQuant_param_view> {
+    static const bool is_operand = true;
+    static const bool is_array = true;
+    typedef FLQuant_expr_param_leaf node_type;
+    static node_type make(const FLQuant_param_view& x) { return node_type(x); }
+};
+
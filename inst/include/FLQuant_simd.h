@@ -0,0 +1,36 @@
+/*
+ * Copyright 2014 FLR Team. Distributed under the GPL 2 or later
+ * Maintainer: Finlay Scott, JRC
+ */
+
+#include <cstddef>
+#include <string>
+
+#define _FLQuant_simd_
+
+/*
+ * Vectorised kernels for contiguous arrays of doubles
+ * Used for the data of FLQuant_base<double> by the arithmetic operators, the expression templates, exp() and log().
+ * On x86 there are AVX-512, AVX2 and scalar versions of each kernel. The best one the CPU supports is chosen the first time a kernel is called.
+ * Everywhere else only the scalar versions are compiled.
+ * exp() and log() use the Cephes rational approximations (within 2 ulp of std::exp and std::log), at every level and for every element.
+ * Elements they do not cover (overflow, underflow, zero, negative, subnormal, NaN and infinite values) are passed to std::exp and std::log.
+ * The output can be the same array as an input.
+ */
+
+enum simd_op {simd_multiplies, simd_divides, simd_minus, simd_plus};
+enum simd_level {simd_scalar, simd_avx2, simd_avx512};
+
+// out = x op y
+void simd_binary(const simd_op op, const double* x, const double* y, double* out, const std::size_t n);
+// out = x op y where y is a scalar
+void simd_binary(const simd_op op, const double* x, const double y, double* out, const std::size_t n);
+// out = x op y where x is a scalar
+void simd_binary(const simd_op op, const double x, const double* y, double* out, const std::size_t n);
+void simd_exp(const double* x, double* out, const std::size_t n);
+void simd_log(const double* x, double* out, const std::size_t n);
+
+simd_level get_simd_level(); // The kernels in use
+std::string get_simd_level_name();
+void set_simd_level(const simd_level level); // Use a lower level than the CPU supports, e.g. for testing
+
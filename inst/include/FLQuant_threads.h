@@ -0,0 +1,80 @@
+/*
+ * Copyright 2014 FLR Team. Distributed under the GPL 2 or later
+ * Maintainer: Finlay Scott, JRC
+ */
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#define _FLQuant_threads_
+
+/*
+ * Pool of threads for the elementwise operations and reductions of large FLQuant_base<double>
+ * Only doubles are shared out. Operations on adoubles are recorded on the CppAD tape of the calling thread so they stay on it.
+ * The work is split into chunks whose size only depends on the size of the work (not on the number of threads) and each output element is worked out by one chunk, in the same order as the single threaded loops.
+ * The results are therefore the same, bit for bit, whatever the number of threads.
+ * Work smaller than min_size elements is done on the calling thread.
+ * The workers do not allocate FLQuants or call R.
+ */
+
+class FLQuant_threads {
+    public:
+        typedef std::function<void(std::size_t, std::size_t)> task_type; // Does the items [first, last)
+
+        ~FLQuant_threads();
+        FLQuant_threads(const FLQuant_threads&) = delete;
+        FLQuant_threads& operator = (const FLQuant_threads&) = delete;
+
+        static FLQuant_threads& get(); // The pool of the process
+        void set_nthreads(const unsigned int nthreads_in); // Including the calling thread
+        unsigned int get_nthreads() const;
+        void set_min_size(const std::size_t min_size_in);
+        std::size_t get_min_size() const;
+        bool use_threads(const std::size_t size) const;
+        void run(const std::size_t nitems, const std::size_t item_size, const task_type& task);
+
+    private:
+        FLQuant_threads();
+        void start(const unsigned int nworkers);
+        void stop();
+        void work();
+        bool do_chunk();
+        unsigned int nthreads;
+        std::size_t min_size;
+        std::vector<std::thread> workers;
+        std::mutex mutex;
+        std::condition_variable wake; // New job or stopping
+        std::condition_variable done; // All chunks of the job finished
+        bool stopping;
+        unsigned long job; // Counts jobs so that each worker joins a job once
+        // The current job
+        const task_type* task;
+        std::size_t nitems;
+        std::size_t chunk_items;
+        std::size_t next_chunk;
+        std::size_t nchunks;
+        std::size_t chunks_done;
+        std::exception_ptr error;
+};
+
+/*! \brief Do func(first, last) over the items [0, nitems), on the pool if T is double and there is enough work
+ *
+ * \param nitems The number of items, e.g. elements or output cells.
+ * \param item_size The number of elements worked on for each item.
+ * \param func Does the items [first, last). Each item must only write to its own output.
+ */
+template <typename T, typename F>
+void FLQuant_parallel_for(const std::size_t nitems, const std::size_t item_size, F func){
+    if (!std::is_same<T, double>::value || !FLQuant_threads::get().use_threads(nitems * item_size)){
+        func(std::size_t(0), nitems);
+        return;
+    }
+    FLQuant_threads::get().run(nitems, item_size, FLQuant_threads::task_type(func));
+}
+
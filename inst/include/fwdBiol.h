@@ -9,6 +9,11 @@
 #include "FLQuant_base.h"
 #endif
 
+#ifndef _FLQuant_param_
+#define _FLQuant_param_
+#include "FLQuant_param.h"
+#endif
+
 #ifndef _fwdSR_
 #define _fwdSR_
 #include "fwdSR.h"
@@ -20,6 +25,7 @@
  * fwdBiol class
  * Contains biological information (incuding abundance) by age for making projections
  * It's very similar to the FLBiol class in R but also includes SRR information
+ * Only n is templated. The other slots are only read during a projection and are held as FLQuant_param (see FLQuant_param.h)
  */
 
 /*-------------------------------------------------------------------*/
@@ -30,50 +36,56 @@ class fwdBiol_base {
 		fwdBiol_base();
 		fwdBiol_base(const SEXP flb_sexp); // Used as intrusive 'as', takes an FLBiolcpp but with no SRR deviances information
         fwdBiol_base(const SEXP flb_sexp, const fwdSR_base<T> srr_in);  // Pass in FLBiol and fwdSR
-        fwdBiol_base(const SEXP flb_sexp, const std::string model_name, const FLQuant params, const FLQuant deviances, const bool deviances_mult); // Pass in FLBiol and bits of fwdSR
-        fwdBiol_base(const SEXP flb_sexp, const FLQuant deviances, const bool deviances_mult); // Pass in FLBiol and bits of fwdSR
+        fwdBiol_base(const SEXP flb_sexp, const std::string& model_name, const FLQuant& params, const FLQuant& deviances, const bool deviances_mult); // Pass in FLBiol and bits of fwdSR
+        fwdBiol_base(const SEXP flb_sexp, const FLQuant& deviances, const bool deviances_mult); // Pass in FLBiol and bits of fwdSR
         
         operator SEXP() const; // Used as intrusive 'wrap' - returns an FLBiolcpp
 
 		fwdBiol_base(const fwdBiol_base& fwdBiol_base_source); // copy constructor to ensure that copy is a deep copy - used when passing FLSs into functions
 		fwdBiol_base& operator = (const fwdBiol_base& fwdBiol_base_source); // Assignment operator for a deep copy
+		fwdBiol_base(fwdBiol_base&& fwdBiol_base_source) noexcept; // move constructor so that temporaries are not copied
+		fwdBiol_base& operator = (fwdBiol_base&& fwdBiol_base_source) noexcept; // Move assignment operator
 
         // Get accessors with const reinforced
-        FLQuant_base<T> n() const;
-        FLQuant_base<T> n(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuant wt() const;
-        FLQuant wt(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuant m() const;
-        FLQuant m(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuant spwn() const;
-        FLQuant spwn(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuant fec() const;
-        FLQuant fec(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuant mat() const;
-        FLQuant mat(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
+        const FLQuant_base<T>& n() const;
+        FLQuant_base<T> n(const Index6& indices_min, const Index6& indices_max) const;
+        const FLQuant_param& wt() const;
+        FLQuant wt(const Index6& indices_min, const Index6& indices_max) const;
+        const FLQuant_param& m() const;
+        FLQuant m(const Index6& indices_min, const Index6& indices_max) const;
+        const FLQuant_param& spwn() const;
+        FLQuant spwn(const Index6& indices_min, const Index6& indices_max) const;
+        const FLQuant_param& fec() const;
+        FLQuant fec(const Index6& indices_min, const Index6& indices_max) const;
+        const FLQuant_param& mat() const;
+        FLQuant mat(const Index6& indices_min, const Index6& indices_max) const;
         std::string get_name() const;
         std::string get_desc() const;
         Rcpp::NumericVector get_range() const;
-        fwdSR_base<T> get_srr() const;
+        const fwdSR_base<T>& get_srr() const;
+        void set_srr_gradient(const std::string& gradient_formula);
+        void set_srr_lookup(const srrLookup lookup);
+        void set_srr_covariates(const std::vector<std::string>& covariate_names, const std::vector<FLQuant>& covariates);
+        void set_srr_deviance_generator(const srrDevianceGenerator deviance_generator);
 
         // Accessor methods (get and set) for the slots
         FLQuant_base<T>& n();
         // Set individual elements (faster than going through FLQuant get and set)
 		T& n(const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const unsigned int iter);
-        FLQuant& wt();
-        FLQuant& m();
-        FLQuant& spwn();
-        FLQuant& fec();
-        FLQuant& mat();
+        FLQuant_param& wt();
+        FLQuant_param& m();
+        FLQuant_param& spwn();
+        FLQuant_param& fec();
+        FLQuant_param& mat();
 
         // SRR accessors
-        FLQuant_base<T> predict_recruitment(const FLQuant_base<T> srp, const std::vector<unsigned int> initial_params_indices, const std::string model_name);
+        FLQuant_base<T> predict_recruitment(const FLQuant_base<T>& srp, const Index5& initial_params_indices) const;
         bool does_recruitment_happen(unsigned int unit, unsigned int year, unsigned int season) const;
         bool has_recruitment_happened(unsigned int unit, unsigned int year, unsigned int season) const;
 
         // Summary and other methods
         FLQuant_base<T> biomass() const;
-        FLQuant_base<T> biomass(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const; // subsetting
+        FLQuant_base<T> biomass(const Index5& indices_min, const Index5& indices_max) const; // subsetting
         unsigned int srp_timelag() const;
 
     private:
@@ -81,11 +93,11 @@ class fwdBiol_base {
         std::string desc;
         Rcpp::NumericVector range;
         FLQuant_base<T> n_flq;
-        FLQuant wt_flq;
-        FLQuant m_flq;
-        FLQuant spwn_flq;
-        FLQuant fec_flq;
-        FLQuant mat_flq;
+        FLQuant_param wt_flq;
+        FLQuant_param m_flq;
+        FLQuant_param spwn_flq;
+        FLQuant_param fec_flq;
+        FLQuant_param mat_flq;
         fwdSR_base<T> srr;
 };
 
@@ -105,11 +117,13 @@ class fwdBiols_base {
 
 		fwdBiols_base(const fwdBiols_base& fwdBiols_base_source); // copy constructor to ensure that copy is a deep copy 
 		fwdBiols_base& operator = (const fwdBiols_base& fwdBiols_base_source); // Assignment operator for a deep copy
+		fwdBiols_base(fwdBiols_base&& fwdBiols_base_source) noexcept; // move constructor so that temporaries are not copied
+		fwdBiols_base& operator = (fwdBiols_base&& fwdBiols_base_source) noexcept; // Move assignment operator
 
         operator SEXP() const; // Used as intrusive 'wrap' - returns an FLBiols
 
         // Accessors
-		fwdBiol_base<T> operator () (const unsigned int element = 1) const; // Only gets an fwdBiol so const reinforced. Default is the first element
+		const fwdBiol_base<T>& operator () (const unsigned int element = 1) const; // Only gets an fwdBiol so const reinforced. Default is the first element
 		fwdBiol_base<T>& operator () (const unsigned int element = 1); // Gets and sets an fwdBiol so const not reinforced
 
         void operator() (const fwdBiol_base<T>& flb); // Add another fwdBiol_base<T> to the data
@@ -46,6 +46,8 @@ class fwdControl {
         operator SEXP() const; // Used as intrusive 'wrap'
 		fwdControl(const fwdControl& fwdControl_source); // copy constructor to ensure that copies (i.e. when passing to functions) are deep
 		fwdControl& operator = (const fwdControl& fwdControl_source); // Assignment operator for a deep copy
+		fwdControl(fwdControl&& fwdControl_source) noexcept; // move constructor so that temporaries are not copied
+		fwdControl& operator = (fwdControl&& fwdControl_source) noexcept; // Move assignment operator
         // For mapping target string to type
         void init_target_map();
         // Accessors
@@ -56,18 +58,18 @@ class fwdControl {
         unsigned int get_target_row(unsigned int target_no, unsigned int sim_target_no) const;
         std::vector<unsigned int> get_target_row(unsigned int target_no) const;
         // Rcpp::IntegerVector to ensure that NA is properly handled (std::vector does not work properly with Rcpp::IntegerVector::is_na())
-        Rcpp::IntegerVector get_target_int_col(const int target_no, const std::string col) const;
-        unsigned int get_target_int_col(const int target_no, const int sim_target_no, const std::string col) const;
+        Rcpp::IntegerVector get_target_int_col(const int target_no, const std::string& col) const;
+        unsigned int get_target_int_col(const int target_no, const int sim_target_no, const std::string& col) const;
         // Rcpp::NumericVector to ensure that NA is properly handled (std::vector does not work properly with Rcpp::NumericVector::is_na())
-        Rcpp::NumericVector get_target_num_col(const int target_no, const std::string col) const;
-        double get_target_num_col(const int target_no, const int sim_target_no, const std::string col) const;
-        Rcpp::List get_target_list_int_col(const int target_no, const std::string col) const;
-        Rcpp::IntegerVector get_target_list_int_col(const int target_no, const int sim_target_no, const std::string col) const;
+        Rcpp::NumericVector get_target_num_col(const int target_no, const std::string& col) const;
+        double get_target_num_col(const int target_no, const int sim_target_no, const std::string& col) const;
+        Rcpp::List get_target_list_int_col(const int target_no, const std::string& col) const;
+        Rcpp::IntegerVector get_target_list_int_col(const int target_no, const int sim_target_no, const std::string& col) const;
         std::vector<double> get_target_value(const int target_no, const int col) const; // gets all iters for all simultaneous targets. col: 1 = min, 2 = value, 3 = max
         std::vector<double> get_target_value(const int target_no, const int sim_target_no, const int col) const; // gets all iters for one simultaneous target. col: 1 = min, 2 = value, 3 = max
         std::string get_target_quantity(const int target_no, const int sim_target_no, const bool relative=false) const;
         fwdControlTargetType get_target_type(const int target_no, const int sim_target_no, const bool relative=false) const;
-        fwdControlTargetType get_target_type(const std::string quantity) const;
+        fwdControlTargetType get_target_type(const std::string& quantity) const;
         std::vector<unsigned int> get_age_range(const unsigned int target_no, const unsigned int sim_target_no) const; // Returns the age range - just the values in target no calculation
         // FCB accessors
         Rcpp::IntegerMatrix get_FCB() const;
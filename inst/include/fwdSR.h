@@ -8,8 +8,78 @@
 #define _FLQuant_base_
 #include "FLQuant_base.h"
 #endif
+
+#ifndef _srr_formula_
+#define _srr_formula_
+#include "srr_formula.h"
+#endif
+
+#ifndef _srr_atomic_
+#define _srr_atomic_
+#include "srr_atomic.h"
+#endif
+
+#ifndef _srr_lookup_
+#define _srr_lookup_
+#include "srr_lookup.h"
+#endif
+
+#ifndef _srr_deviances_
+#define _srr_deviances_
+#include "srr_deviances.h"
+#endif
+
+#include <memory>
+
 #define _fwdSR_
 
+/*! \brief The parameters of the SR model for one year, unit, season, area and iter
+ *
+ * Points into the parameter table of fwdSR so no data is copied. It has the element access and size of a std::vector.
+ * A std::vector of parameters can be passed where an srrParams is expected.
+ */
+class srrParams {
+    public:
+        srrParams(const double* first_ip, const unsigned int size_ip) : first(first_ip), nparams(size_ip) {}
+        srrParams(const std::vector<double>& params) : first(params.data()), nparams(params.size()) {}
+        double operator [] (const unsigned int element) const { return first[element]; }
+        unsigned int size() const { return nparams; }
+        const double* begin() const { return first; }
+        const double* end() const { return first + nparams; }
+    private:
+        const double* first;
+        unsigned int nparams;
+};
+
+/*
+ * SRR plugins
+ * SR functions compiled outside of the package (e.g. with Rcpp::cppFunction and inlineCxxPlugin) and registered at run time.
+ * A plugin holds the double and adouble instantiations of the SR function so that it is evaluated natively with derivatives.
+ */
+
+struct srr_plugin {
+    double (*model_double)(const double, const srrParams&);
+    adouble (*model_adouble)(const adouble, const srrParams&);
+};
+
+std::map<std::string, srr_plugin>& get_srr_plugins(); // The registered plugins
+void register_srr_plugin(const std::string name, SEXP plugin);
+std::vector<std::string> registered_srr_plugins();
+
+/*! \brief Wrap the instantiations of an SR function as a plugin that can be passed to register_srr_plugin().
+ *
+ * Defined in the header so that it is compiled into the user's code.
+ * The SR function must have the same signature as the SR functions in the package, e.g.
+ * template <typename T> T my_srr(const T srp, const srrParams& params);
+ * return make_srr_plugin(&my_srr<double>, &my_srr<adouble>);
+ */
+inline SEXP make_srr_plugin(double (*model_double)(const double, const srrParams&), adouble (*model_adouble)(const adouble, const srrParams&)){
+    srr_plugin* plugin = new srr_plugin;
+    plugin->model_double = model_double;
+    plugin->model_adouble = model_adouble;
+    return Rcpp::XPtr<srr_plugin>(plugin, true);
+}
+
 /*
  * fwdSR class
  * Contains data and methods for stock-recruitment relationships
@@ -22,85 +92,117 @@ class fwdSR_base {
     public:
         // /* Constructors */
 		fwdSR_base();
-		fwdSR_base(const std::string model_name_ip, const FLQuant params_ip, const FLQuant deviances_ip, const bool deviances_mult_ip);  // Construct using model name
+		fwdSR_base(const std::string& model_name_ip, const FLQuant& params_ip, const FLQuant& deviances_ip, const bool deviances_mult_ip);  // Construct using model name
         operator SEXP() const; // Used as intrusive 'wrap' - returns a list
 		fwdSR_base(const fwdSR_base& fwdSR_base_source); // copy constructor to ensure that copy is a deep copy - used when passing into functions
 		fwdSR_base& operator = (const fwdSR_base& fwdSR_base_source); // Assignment operator for a deep copy
+		fwdSR_base(fwdSR_base&& fwdSR_base_source) noexcept; // move constructor so that temporaries are not copied
+		fwdSR_base& operator = (fwdSR_base&& fwdSR_base_source) noexcept; // Move assignment operator
 
         // Evaluate the model only 1 value at a time
-        T eval_model(const T srp, int year, int unit, int season, int area, int iter ,const std::string model_name) const;
-        T eval_model(const T srp, const std::vector<unsigned int> params_indices,const std::string model_name) const;
+        T eval_model(const T srp, int year, int unit, int season, int area, int iter) const;
+        T eval_model(const T srp, const Index5& params_indices) const;
 
         // Predict recruitment. As eval() but also applies the deviances
-        FLQuant_base<T> predict_recruitment(const FLQuant_base<T> srp, const std::vector<unsigned int> initial_params_indices ,const std::string model_name);
+        FLQuant_base<T> predict_recruitment(const FLQuant_base<T>& srp, const Index5& initial_params_indices) const;
         
         // Typedef for the SRR model functions
-        typedef T (*srr_model_ptr)(const T, const std::vector<double>, const std::string);
+        typedef T (*srr_model_ptr)(const T, const srrParams&);
         typedef std::map<std::string, srr_model_ptr> model_map_type;
         void init_model_map();
+        bool has_model(const std::string& name) const; // Is the SR function in the model map
 
         // Accessors and setters
-        FLQuant_base<double> get_params() const;
+        const FLQuant_base<double>& get_params() const;
         std::string get_model_name() const;
-        std::vector<double> get_params(unsigned int year, unsigned int unit, unsigned int season, unsigned int area, unsigned int iter) const;
         int get_nparams() const; // No of params in a time step - the length of the first dimension
-        FLQuant_base<double> get_deviances() const;
+        bool is_native() const; // Is the SRR evaluated without calling R
+        const FLQuant_base<double>& get_deviances() const;
         bool get_deviances_mult() const;
-        void set_deviances(const FLQuant_base<double> new_deviances);
+        void set_deviances(const FLQuant_base<double>& new_deviances);
         void set_deviances_mult(const bool new_deviances_mult);
+        void set_gradient(const std::string& gradient_formula); // Gradient of an SR model evaluated in R
+        void set_lookup(const srrLookup new_lookup); // Approximate an SR model evaluated in R by lookup tables
+        double get_lookup_error() const; // Largest relative error of the lookup tables - NA if there are none
+        void set_covariates(const std::vector<std::string>& covariate_names_ip, const std::vector<FLQuant>& covariates_ip);
+        std::vector<std::string> get_covariate_names() const;
+        void set_deviance_generator(const srrDevianceGenerator new_deviance_generator);
+        bool has_deviance_generator() const;
 
         bool does_recruitment_happen(unsigned int unit, unsigned int year, unsigned int season) const;
         bool has_recruitment_happened(unsigned int unit, unsigned int year, unsigned int season) const;
 
     private:
-        T (*model) (const T, const std::vector<double>,const std::string); // Pointer to SRR function
+        void make_r_atomic(); // Make the atomic operation for evaluating the SR model in R
+        void init_model(); // Set how the SR model is evaluated from the model name and the names of the parameters and covariates
+        void init_params_tables(); // Precompute the parameters of each cell and the recruitment schedule
+        double recycled_value(const FLQuant& flq, unsigned int quant, unsigned int year, unsigned int unit, unsigned int season, unsigned int area, unsigned int iter) const;
+        void init_sratio(); // Sex ratio from the unit names of the deviances
+        unsigned int params_cell(unsigned int year, unsigned int unit, unsigned int season, unsigned int area, unsigned int iter) const; // Position in the parameter tables
+        srrParams get_cell_params(const unsigned int cell) const; // Parameters and covariates of a cell of the parameter table
+        void recognise_model(const std::vector<std::string>& param_names); // Match the formula to an SRR function
+
+        srr_model_ptr model; // Pointer to SRR function - nullptr if the formula is evaluated as an expression tree or in R
+        std::vector<unsigned int> model_params_order; // Positions in params of the parameters of the SRR function - empty if in the same order
         std::string model_name;
         FLQuant_base<double> params;
         FLQuant_base<double> deviances;
         bool deviances_mult;
         model_map_type map_model_name_to_function; // Map for the SRR models
+        std::shared_ptr<const srrFormula> formula; // The model compiled from the formula string - shared by copies as it does not change
+        Rcpp::RObject r_expression; // The parsed formula if it is evaluated in R
+        Rcpp::RObject r_gradient_expression; // The parsed gradient formula - NULL if derivatives are from central differences
+        Rcpp::Environment r_env; // The environment the formula is evaluated in
+        std::vector<std::string> covariate_names;
+        std::vector<FLQuant> covariates; // Covariates of the SR model, e.g. environmental drivers
+        bool pass_covariates; // Are the covariates passed to the SR model after the parameters
+        std::vector<unsigned int> table_dim; // Dimensions of the parameter tables - the largest of the params and covariates
+        std::vector<double> cell_params; // Parameters and covariates of each year, unit, season, area and iter, in the order passed to the SR model - cell_nparams values per cell
+        unsigned int cell_nparams; // Number of values in each cell of cell_params
+        std::vector<bool> cell_params_na; // Are any of the parameters of that cell NA
+        std::vector<bool> recruitment_happens; // Does recruitment happen in each year, unit and season of the params
+        std::vector<bool> recruitment_happened; // Has recruitment happened by the end of each year, unit and season of the params
+        double sratio; // Sex ratio of recruitment
+        srrDevianceGenerator deviance_generator; // Generates multiplicative deviances on top of the deviances member, if active
+        std::shared_ptr<srrLookup> lookup; // Lookup tables of the SR model evaluated in R, if used - shared by copies so the tables are kept
+        std::shared_ptr<srrAtomic> r_atomic; // Evaluates the formula in R and records it on the tape - shared by copies so the cache is kept
 };
 
 typedef fwdSR_base<double> fwdSR;
 typedef fwdSR_base<adouble> fwdSRAD;
-// 
-// //------------------------------------------------------------------
-// // SRR functions
-// 
+
+//------------------------------------------------------------------
+// SRR functions
+
+template <typename T>
+T bevholt(const T srp, const srrParams& params);
+
+template <typename T>
+T bevholtDa(const T srp, const srrParams& params);
+
+template <typename T>
+T ricker(const T srp, const srrParams& params);
+
+template <typename T>
+T constant(const T srp, const srrParams& params);
+
+template <typename T>
+T bevholtSS3(const T srp, const srrParams& params);
+
+template <typename T>
+T cushing(const T srp, const srrParams& params);
+
+template <typename T>
+T segreg(const T srp, const srrParams& params);
+
+template <typename T>
+T segregDa(const T srp, const srrParams& params);
+
+template <typename T>
+T survsrr(const T srp, const srrParams& params);
+
+template <typename T>
+T bevholtsig(const T srp, const srrParams& params);
+
 template <typename T>
-T customSRR(const T srp, const std::vector<double> params,const std::string model_name);
-// 
-// template <typename T>
-// T customSRR(const T srp, const std::vector<double> params, char *f_name[]);
-// 
-// // double customSRR(const srp, const std::vector<double> params, char *f_name[]);
-// 
-// template <typename T>
-// T bevholt(const T srp, const std::vector<double> params);
-// 
-// template <typename T>
-// T bevholtDa(const T srp, const std::vector<double> params);
-// 
-// template <typename T>
-// T constant(const T srp, const std::vector<double> params);
-// 
-// template <typename T>
-// T bevholtSS3(const T srp, const std::vector<double> params);
-// 
-// template <typename T>
-// T cushing(const T srp, const std::vector<double> params);
-// 
-// template <typename T>
-// T segreg(const T srp, const std::vector<double> params);
-// 
-// template <typename T>
-// T segregDa(const T srp, const std::vector<double> params);
-// 
-// template <typename T>
-// T survsrr(const T srp, const std::vector<double> params);
-// 
-// template <typename T>
-// T bevholtsig(const T srp, const std::vector<double> params);
-// 
-// template <typename T>
-// T mixedsrr(const T srp, const std::vector<double> params);
+T mixedsrr(const T srp, const srrParams& params);
@@ -39,35 +39,39 @@ class operatingModel {
         /* Constructors */
         /* Not really possible to write an 'as' as there is no corresponding class in FLR - need to write wrapper function - see bottom of cpp script */
 		operatingModel();
-        operatingModel(const FLFisheriesAD fisheries_in, const fwdBiolsAD biols_in, const fwdControl ctrl_in);
+        operatingModel(const FLFisheriesAD& fisheries_in, const fwdBiolsAD& biols_in, const fwdControl& ctrl_in);
 		operatingModel(const operatingModel& operatingModel_source); // copy constructor to ensure that copy is a deep copy - used when passing FLSs into functions
 		operatingModel& operator = (const operatingModel& operatingModel_source); // Assignment operator for a deep copy
+		operatingModel(operatingModel&& operatingModel_source) noexcept; // move constructor so that temporaries are not copied
+		operatingModel& operator = (operatingModel&& operatingModel_source) noexcept; // Move assignment operator
         operator SEXP() const; // Used as intrusive 'wrap' - returns a list of stuff
 
         // Methods
         unsigned int get_niter() const;
-        FLQuantAD srp(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuantAD total_srp(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuantAD ssf(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuant f_prop_spwn(const int fishery_no, const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuantAD get_exp_z_pre_spwn(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        bool spawn_before_fishing(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        bool fishing_before_spawn(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
+        FLQuantAD srp(const int biol_no, const Index5& indices_min, const Index5& indices_max) const;
+        FLQuantAD total_srp(const int biol_no, const Index5& indices_min, const Index5& indices_max) const;
+        FLQuantAD ssf(const int biol_no, const Index5& indices_min, const Index5& indices_max) const;
+        FLQuant f_prop_spwn(const int fishery_no, const int biol_no, const Index5& indices_min, const Index5& indices_max) const;
+        FLQuantAD get_exp_z_pre_spwn(const int biol_no, const Index6& indices_min, const Index6& indices_max) const;
+        bool spawn_before_fishing(const int biol_no, const Index5& indices_min, const Index5& indices_max) const;
+        bool fishing_before_spawn(const int biol_no, const Index5& indices_min, const Index5& indices_max) const;
         std::vector<adouble> calc_rec(const unsigned int biol_no, const unsigned int unit, const unsigned int rec_timestep) const;
-        FLQuantAD get_f(const int fishery_no, const int catch_no, const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
+        FLQuantAD get_f(const int fishery_no, const int catch_no, const int biol_no, const Index6& indices_min, const Index6& indices_max) const;
         FLQuantAD get_f(const int fishery_no, const int catch_no, const int biol_no) const; 
-        FLQuantAD get_f(const unsigned int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
+        FLQuantAD get_f(const unsigned int biol_no, const Index6& indices_min, const Index6& indices_max) const;
         FLQuantAD get_f(const int biol_no) const;
-        FLQuantAD get_nunit_z(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuantAD get_nunit_f(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuantAD get_nunit_f(const int fishery_no, const int catch_no, const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuantAD survivors(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const; 
+        FLQuantAD get_nunit_z(const int biol_no, const Index6& indices_min, const Index6& indices_max) const;
+        FLQuantAD get_nunit_f(const int biol_no, const Index6& indices_min, const Index6& indices_max) const;
+        FLQuantAD get_nunit_f(const int fishery_no, const int catch_no, const int biol_no, const Index6& indices_min, const Index6& indices_max) const;
+        FLQuantAD survivors(const int biol_no, const Index6& indices_min, const Index6& indices_max) const; 
         void project_biols(const int timestep); // Uses effort in previous timestep
         void project_fisheries(const int timestep); // Uses effort in that timestep
+        std::vector<double> srr_lookup_errors() const; // Largest relative error of the SRR lookup tables of each biol
+        Rcpp::NumericMatrix get_arena_counters() const; // FLQuant arena use of each target in the last run
         Rcpp::IntegerMatrix run(const double effort_mult_initial, std::vector<double> effort_max, const double indep_min, const double indep_max, const unsigned int nr_iters = 50); 
 
         // Sorting out target values - these are not const as eval_om may need to change spwn() member if SRP / SSB target 
-        FLQuantAD eval_om(const fwdControlTargetType target_type, const int fishery_no, const int catch_no, const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max); // const is relaxed as ssb_flash and biomass_flash may need to project again and update biol
+        FLQuantAD eval_om(const fwdControlTargetType target_type, const int fishery_no, const int catch_no, const int biol_no, const std::vector<unsigned int>& indices_min, const std::vector<unsigned int>& indices_max); // const is relaxed as ssb_flash and biomass_flash may need to project again and update biol
         // The actual current target values in the OM - to be compared to the desired values
         std::vector<adouble> get_target_value_hat(const int target_no); 
         std::vector<adouble> get_target_value_hat(const int target_no, const int sim_target_no); 
@@ -78,32 +82,33 @@ class operatingModel {
         
         // The target value calculations
         // Partial fbar of a single catch on a single biol
-        FLQuantAD fbar(const int fishery_no, const int catch_no, const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
+        FLQuantAD fbar(const int fishery_no, const int catch_no, const int biol_no, const Index6& indices_min, const Index6& indices_max) const;
         // Total fbar on a biol (possibly from multiple catches)
-        FLQuantAD fbar(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuantAD ssb_start(const int biol_no,  const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuantAD biomass_start(const int biol_no,  const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuantAD ssb_end(const int biol_no,  const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuantAD inmb_end(const int biol_no,  const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuantAD indb(const int biol_no,  const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuantAD biomass_end(const int biol_no,  const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuantAD ssb_spawn(const int biol_no,  const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuantAD biomass_spawn(const int biol_no,  const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuantAD ssb_flash(const int biol_no,  const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max); // not const as projects
-        FLQuantAD biomass_flash(const int biol_no,  const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max); // not const as projects
+        FLQuantAD fbar(const int biol_no, const Index6& indices_min, const Index6& indices_max) const;
+        FLQuantAD ssb_start(const int biol_no,  const Index5& indices_min, const Index5& indices_max) const;
+        FLQuantAD biomass_start(const int biol_no,  const Index5& indices_min, const Index5& indices_max) const;
+        FLQuantAD ssb_end(const int biol_no,  const Index5& indices_min, const Index5& indices_max) const;
+        FLQuantAD inmb_end(const int biol_no,  const Index5& indices_min, const Index5& indices_max) const;
+        FLQuantAD indb(const int biol_no,  const Index5& indices_min, const Index5& indices_max) const;
+        FLQuantAD biomass_end(const int biol_no,  const Index5& indices_min, const Index5& indices_max) const;
+        FLQuantAD ssb_spawn(const int biol_no,  const Index5& indices_min, const Index5& indices_max) const;
+        FLQuantAD biomass_spawn(const int biol_no,  const Index5& indices_min, const Index5& indices_max) const;
+        FLQuantAD ssb_flash(const int biol_no,  const Index5& indices_min, const Index5& indices_max); // not const as projects
+        FLQuantAD biomass_flash(const int biol_no,  const Index5& indices_min, const Index5& indices_max); // not const as projects
 
         // Extract total catches / landings / discards from a biol - not calculated from effort
-        FLQuantAD landings(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuantAD discards(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuantAD catches(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuantAD landings_n(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuantAD discards_n(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
-        FLQuantAD catch_n(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const;
+        FLQuantAD landings(const int biol_no, const Index5& indices_min, const Index5& indices_max) const;
+        FLQuantAD discards(const int biol_no, const Index5& indices_min, const Index5& indices_max) const;
+        FLQuantAD catches(const int biol_no, const Index5& indices_min, const Index5& indices_max) const;
+        FLQuantAD landings_n(const int biol_no, const Index6& indices_min, const Index6& indices_max) const;
+        FLQuantAD discards_n(const int biol_no, const Index6& indices_min, const Index6& indices_max) const;
+        FLQuantAD catch_n(const int biol_no, const Index6& indices_min, const Index6& indices_max) const;
 
     private:
         FLFisheriesAD fisheries;
         fwdControl ctrl;
         fwdBiolsAD biols;
+        std::vector<FLQuant_arena_counters> arena_counters; // One per target, filled by run()
 };
 
 
@@ -0,0 +1,71 @@
+/*
+ * Copyright 2014 FLR Team. Distributed under the GPL 2 or later
+ * Maintainer: Finlay Scott, JRC
+ */
+
+#include "cppad/cppad.hpp" // CppAD package http://www.coin-or.org/CppAD/
+#include <Rcpp.h>
+#include <functional>
+#include <set>
+
+#define _srr_atomic_
+
+/*
+ * srrAtomic class
+ * Recruitment from an SRR that is evaluated outside of CppAD (i.e. in R), recorded on the tape as a single atomic operation.
+ * The inputs of the operation are the SRP values followed by the SR parameters of each SRP value.
+ * The derivatives of recruitment with respect to the SRP come from a gradient function if there is one,
+ * else from central differences which are cached until the SRP or the parameters change.
+ * The parameters are never independent variables so their derivatives are 0.
+ */
+
+typedef CppAD::AD<double> adouble;
+
+/*-------------------------------------------------------------------*/
+
+class srrAtomic : public CppAD::atomic_base<double> {
+    public:
+        // Evaluates the SRR (or its gradient) for a batch of SRP values. The params have the parameters varying fastest.
+        typedef std::function<std::vector<double>(const std::vector<double>&, const std::vector<double>&)> batch_function_type;
+
+        /* Constructors */
+        srrAtomic(const std::string& name, const batch_function_type rec_function_ip, const batch_function_type gradient_function_ip = batch_function_type());
+
+        // Evaluate recruitment for a batch of SRP values - with adouble one operation is recorded on the tape
+        template <typename T>
+        std::vector<T> eval(const std::vector<T>& srp, const std::vector<double>& params);
+
+        bool has_gradient_function() const;
+
+        // CppAD atomic_base interface - first order only
+        virtual bool forward(size_t p, size_t q, const CppAD::vector<bool>& vx, CppAD::vector<bool>& vy, const CppAD::vector<double>& tx, CppAD::vector<double>& ty);
+        virtual bool reverse(size_t q, const CppAD::vector<double>& tx, const CppAD::vector<double>& ty, CppAD::vector<double>& px, const CppAD::vector<double>& py);
+        virtual bool for_sparse_jac(size_t q, const CppAD::vector<bool>& r, CppAD::vector<bool>& s, const CppAD::vector<double>& x);
+        virtual bool for_sparse_jac(size_t q, const CppAD::vectorBool& r, CppAD::vectorBool& s, const CppAD::vector<double>& x);
+        virtual bool for_sparse_jac(size_t q, const CppAD::vector<std::set<size_t> >& r, CppAD::vector<std::set<size_t> >& s, const CppAD::vector<double>& x);
+        virtual bool rev_sparse_jac(size_t q, const CppAD::vector<bool>& rt, CppAD::vector<bool>& st, const CppAD::vector<double>& x);
+        virtual bool rev_sparse_jac(size_t q, const CppAD::vectorBool& rt, CppAD::vectorBool& st, const CppAD::vector<double>& x);
+        virtual bool rev_sparse_jac(size_t q, const CppAD::vector<std::set<size_t> >& rt, CppAD::vector<std::set<size_t> >& st, const CppAD::vector<double>& x);
+
+    private:
+        // Values and derivatives at the order 0 Taylor coefficients, using the cache
+        void update_values(const std::vector<double>& srp, const std::vector<double>& params);
+        void update_gradient(const std::vector<double>& srp, const std::vector<double>& params);
+        void split_inputs(const size_t nvalues, const size_t order, const CppAD::vector<double>& tx, std::vector<double>& srp, std::vector<double>& params) const;
+
+        batch_function_type rec_function;
+        batch_function_type gradient_function;
+        // Cache of the last evaluation
+        std::vector<double> cached_srp;
+        std::vector<double> cached_params;
+        std::vector<double> cached_rec;
+        std::vector<double> cached_gradient;
+        bool rec_cached;
+        bool gradient_cached;
+};
+
+template <>
+std::vector<double> srrAtomic::eval(const std::vector<double>& srp, const std::vector<double>& params);
+template <>
+std::vector<adouble> srrAtomic::eval(const std::vector<adouble>& srp, const std::vector<double>& params);
+
@@ -0,0 +1,42 @@
+/*
+ * Copyright 2014 FLR Team. Distributed under the GPL 2 or later
+ * Maintainer: Finlay Scott, JRC
+ */
+
+#include <Rcpp.h>
+#include <cstdint>
+
+#define _srr_deviances_
+
+/*
+ * srrDevianceGenerator class
+ * Generates lognormal stock-recruitment deviances, with optional AR(1) autocorrelation between years, when they are needed
+ * instead of storing them for every year, unit, season, area and iteration.
+ * The random numbers come from a counter-based generator: each normal deviate is a hash of the seed and its indices,
+ * so any deviance can be generated on its own, in any order, and always gives the same value.
+ */
+
+/*-------------------------------------------------------------------*/
+
+class srrDevianceGenerator {
+    public:
+        /* Constructors */
+        srrDevianceGenerator(); // Not active
+        srrDevianceGenerator(const double sd_ip, const double rho_ip, const double seed_ip, const bool bias_correct_ip, const std::vector<unsigned int>& iters_ip);
+        srrDevianceGenerator(const SEXP generator_sexp); // Used as intrusive 'as', takes a list with sd, rho, seed, bias_correct and iters
+
+        bool is_active() const;
+        // The multiplicative deviance (indices start at 1)
+        double deviance(const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const unsigned int iter) const;
+
+    private:
+        double normal(const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const std::uint64_t iter) const;
+
+        bool active;
+        double sd;
+        double rho;
+        std::uint64_t seed;
+        bool bias_correct;
+        std::vector<unsigned int> iters; // The original iteration numbers (e.g. before iterations with no targets were dropped) - empty if 1 to n
+};
+
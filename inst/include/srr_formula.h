@@ -0,0 +1,100 @@
+/*
+ * Copyright 2014 FLR Team. Distributed under the GPL 2 or later
+ * Maintainer: Finlay Scott, JRC
+ */
+
+#include "cppad/cppad.hpp" // CppAD package http://www.coin-or.org/CppAD/
+#include <Rcpp.h>
+
+#define _srr_formula_
+
+/*
+ * srrFormula class
+ * A native, compiled version of the right hand side of an R stock-recruitment formula (e.g. a * ssb / (b + ssb)).
+ * The formula string is parsed once into a flat expression tree that can then be evaluated with double or adouble values
+ * so that recruitment is recorded on the CppAD tape (no calls to the R interpreter).
+ * Formulas that use anything the parser does not know about are flagged as not native and are left to R.
+ */
+
+typedef CppAD::AD<double> adouble;
+
+/*-------------------------------------------------------------------*/
+
+class srrFormula {
+    public:
+        /* Constructors */
+        srrFormula();
+        srrFormula(const std::string& formula_ip, const std::vector<std::string>& param_names_ip); // Parse and compile the formula
+
+        bool is_native() const; // Was the formula compiled
+        std::string get_formula() const;
+        std::vector<std::string> get_param_names() const;
+        bool is_same(const srrFormula& other) const; // Do two compiled formulas have the same expression tree
+
+        // Evaluate the compiled formula
+        template <typename T>
+        T eval(const T srp, const double* params) const;
+
+    private:
+        // Operations in the expression tree
+        enum node_type {
+            node_constant,
+            node_srp,
+            node_param,
+            node_add,
+            node_sub,
+            node_mult,
+            node_div,
+            node_pow,
+            node_neg,
+            node_exp,
+            node_log,
+            node_log10,
+            node_sqrt,
+            node_abs,
+            node_min,
+            node_max,
+            node_lt,
+            node_le,
+            node_gt,
+            node_ge,
+            node_eq,
+            node_ne,
+            node_and,
+            node_or,
+            node_not,
+            node_ifelse,
+            node_unknown // Something R knows about but we don't - the formula cannot be compiled
+        };
+        struct node {
+            node_type type;
+            double value; // Used by node_constant
+            unsigned int param; // Used by node_param (starting at 0)
+            int child[3]; // Positions of the operands in nodes (-1 if not used)
+        };
+
+        template <typename T>
+        T eval_node(const int node_no, const T& srp, const double* params) const;
+
+        // Parser - recursive descent over the R operator precedence
+        int parse_or(const std::string& text, unsigned int& pos);
+        int parse_and(const std::string& text, unsigned int& pos);
+        int parse_not(const std::string& text, unsigned int& pos);
+        int parse_comparison(const std::string& text, unsigned int& pos);
+        int parse_additive(const std::string& text, unsigned int& pos);
+        int parse_multiplicative(const std::string& text, unsigned int& pos);
+        int parse_unary(const std::string& text, unsigned int& pos);
+        int parse_power(const std::string& text, unsigned int& pos);
+        int parse_primary(const std::string& text, unsigned int& pos);
+        int parse_call(const std::string& name, const std::string& text, unsigned int& pos);
+        int add_node(const node_type type, const int child1 = -1, const int child2 = -1, const int child3 = -1, const double value = 0.0, const unsigned int param = 0);
+        bool check_node(const int node_no) const;
+        bool same_node(const int node_no, const srrFormula& other, const int other_node_no) const;
+
+        std::string formula;
+        std::vector<std::string> param_names;
+        std::vector<node> nodes;
+        int root;
+        bool native;
+};
+
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2014 FLR Team. Distributed under the GPL 2 or later
+ * Maintainer: Finlay Scott, JRC
+ */
+
+#include <Rcpp.h>
+#include <functional>
+#include <map>
+
+#define _srr_lookup_
+
+/*
+ * srrLookup class
+ * Approximates an expensive SRR (e.g. evaluated in R) by a lookup table for each parameter set.
+ * The SRR is tabulated once over an adaptive grid of SRP values, from 0 to an upper limit that is extended if needed,
+ * and interpolated with a monotone piecewise cubic Hermite spline (Fritsch-Carlson) with an analytic derivative.
+ * The grid is refined at the midpoints of the intervals until the error there, relative to the largest recruitment in the table,
+ * is below the tolerance or the maximum number of points is reached.
+ */
+
+/*-------------------------------------------------------------------*/
+
+class srrLookup {
+    public:
+        // Evaluates the SRR for a batch of SRP values. The params have the parameters varying fastest.
+        typedef std::function<std::vector<double>(const std::vector<double>&, const std::vector<double>&)> batch_function_type;
+
+        /* Constructors */
+        srrLookup();
+        srrLookup(const double tolerance_ip, const unsigned int max_points_ip, const double srp_max_ip);
+        srrLookup(const SEXP lookup_sexp); // From an R list with elements tolerance, max_points and srp_max
+
+        void set_rec_function(const batch_function_type rec_function_ip); // Also empties the tables
+
+        // Recruitment and its derivative with respect to the SRP, for a batch of SRP values
+        std::vector<double> eval(const std::vector<double>& srp, const std::vector<double>& params);
+        std::vector<double> gradient(const std::vector<double>& srp, const std::vector<double>& params);
+
+        double get_max_error() const; // Largest relative error at the check points of all the tables
+        unsigned int get_ntables() const;
+
+    private:
+        struct table {
+            std::vector<double> srp;
+            std::vector<double> rec;
+            std::vector<double> slope; // Derivative of the spline at each point
+            double max_error;
+        };
+
+        const table& get_table(const std::vector<double>& params, const double srp);
+        table build_table(const std::vector<double>& params, const double srp_upper) const;
+        void eval_table(const table& lookup_table, const double srp, double& rec, double& drec) const;
+
+        batch_function_type rec_function;
+        double tolerance;
+        unsigned int max_points;
+        double srp_max; // Initial upper limit of the grid - 0 to set it from the first SRP values
+        std::map<std::vector<double>, table> tables; // One table for each parameter set
+};
+
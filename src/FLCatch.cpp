@@ -18,11 +18,11 @@ FLCatch_base<T>::FLCatch_base(){
     landings_n_flq = FLQuant_base<T>();
     discards_n_flq = FLQuant_base<T>();
     discards_ratio_flq = FLQuant_base<T>();
-    landings_wt_flq = FLQuant();
-    discards_wt_flq = FLQuant();
-    catch_sel_flq = FLQuant();
-    price_flq = FLQuant();
-    catch_q_flq = FLQuant();
+    landings_wt_flq = FLQuant_param();
+    discards_wt_flq = FLQuant_param();
+    catch_sel_flq = FLQuant_param();
+    price_flq = FLQuant_param();
+    catch_q_flq = FLQuant_param();
 }
 
 // Constructor from a SEXP S4 FLCatch
@@ -82,6 +82,43 @@ FLCatch_base<T>& FLCatch_base<T>::operator = (const FLCatch_base<T>& FLCatch_sou
 	return *this;
 }
 
+// Move constructor - takes the members of a temporary instead of copying them
+template <typename T>
+FLCatch_base<T>::FLCatch_base(FLCatch_base<T>&& FLCatch_source) noexcept{
+    name = std::move(FLCatch_source.name);
+    desc = std::move(FLCatch_source.desc);
+    range = std::move(FLCatch_source.range);
+    landings_n_flq = std::move(FLCatch_source.landings_n_flq);
+    discards_n_flq = std::move(FLCatch_source.discards_n_flq);
+    discards_ratio_flq = std::move(FLCatch_source.discards_ratio_flq);
+    landings_wt_flq = std::move(FLCatch_source.landings_wt_flq);
+    discards_wt_flq = std::move(FLCatch_source.discards_wt_flq);
+    catch_sel_flq = std::move(FLCatch_source.catch_sel_flq);
+    price_flq = std::move(FLCatch_source.price_flq);
+    catch_q_flq = std::move(FLCatch_source.catch_q_flq);
+    catch_q_orig = std::move(FLCatch_source.catch_q_orig);
+}
+
+// Move assignment operator
+template <typename T>
+FLCatch_base<T>& FLCatch_base<T>::operator = (FLCatch_base<T>&& FLCatch_source) noexcept{
+	if (this != &FLCatch_source){
+        name = std::move(FLCatch_source.name);
+        desc = std::move(FLCatch_source.desc);
+        range = std::move(FLCatch_source.range);
+        landings_n_flq = std::move(FLCatch_source.landings_n_flq);
+        discards_n_flq = std::move(FLCatch_source.discards_n_flq);
+        discards_ratio_flq = std::move(FLCatch_source.discards_ratio_flq);
+        landings_wt_flq = std::move(FLCatch_source.landings_wt_flq);
+        discards_wt_flq = std::move(FLCatch_source.discards_wt_flq);
+        catch_sel_flq = std::move(FLCatch_source.catch_sel_flq);
+        price_flq = std::move(FLCatch_source.price_flq);
+        catch_q_flq = std::move(FLCatch_source.catch_q_flq);
+        catch_q_orig = std::move(FLCatch_source.catch_q_orig);
+	}
+	return *this;
+}
+
 /* Intrusive 'wrap' */
 template <typename T>
 FLCatch_base<T>::operator SEXP() const{
@@ -103,78 +140,78 @@ FLCatch_base<T>::operator SEXP() const{
 // Accessors
 // Get only
 template <typename T>
-FLQuant_base<T> FLCatch_base<T>::landings_n() const {
+const FLQuant_base<T>& FLCatch_base<T>::landings_n() const {
     return landings_n_flq;
 }
 
 template <typename T>
-FLQuant_base<T> FLCatch_base<T>::landings_n(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
+FLQuant_base<T> FLCatch_base<T>::landings_n(const Index6& indices_min, const Index6& indices_max) const {
     return landings_n_flq(indices_min, indices_max);
 }
 
 template <typename T>
-FLQuant_base<T> FLCatch_base<T>::discards_n() const {
+const FLQuant_base<T>& FLCatch_base<T>::discards_n() const {
     return discards_n_flq;
 }
 
 template <typename T>
-FLQuant_base<T> FLCatch_base<T>::discards_n(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
+FLQuant_base<T> FLCatch_base<T>::discards_n(const Index6& indices_min, const Index6& indices_max) const {
     return discards_n_flq(indices_min, indices_max);
 }
 
 template <typename T>
-FLQuant FLCatch_base<T>::landings_wt() const {
+const FLQuant_param& FLCatch_base<T>::landings_wt() const {
     return landings_wt_flq;
 }
 
 template <typename T>
-FLQuant FLCatch_base<T>::landings_wt(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
+FLQuant FLCatch_base<T>::landings_wt(const Index6& indices_min, const Index6& indices_max) const {
     return landings_wt_flq(indices_min, indices_max);
 }
 
 template <typename T>
-FLQuant FLCatch_base<T>::discards_wt() const {
+const FLQuant_param& FLCatch_base<T>::discards_wt() const {
     return discards_wt_flq;
 }
 
 template <typename T>
-FLQuant FLCatch_base<T>::discards_wt(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
+FLQuant FLCatch_base<T>::discards_wt(const Index6& indices_min, const Index6& indices_max) const {
     return discards_wt_flq(indices_min, indices_max);
 }
 
 template <typename T>
-FLQuant FLCatch_base<T>::catch_sel() const {
+const FLQuant_param& FLCatch_base<T>::catch_sel() const {
     return catch_sel_flq;
 }
 
 template <typename T>
-FLQuant FLCatch_base<T>::catch_sel(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
+FLQuant FLCatch_base<T>::catch_sel(const Index6& indices_min, const Index6& indices_max) const {
     return catch_sel_flq(indices_min, indices_max);
 }
 
 template <typename T>
-FLQuant FLCatch_base<T>::price() const {
+const FLQuant_param& FLCatch_base<T>::price() const {
     return price_flq;
 }
 
 template <typename T>
-FLQuant FLCatch_base<T>::price(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
+FLQuant FLCatch_base<T>::price(const Index6& indices_min, const Index6& indices_max) const {
     return price_flq(indices_min, indices_max);
 }
 
 
 template <typename T>
-FLQuant_base<T> FLCatch_base<T>::discards_ratio() const {
+const FLQuant_base<T>& FLCatch_base<T>::discards_ratio() const {
     return discards_ratio_flq;
 }
 
 template <typename T>
-FLQuant_base<T> FLCatch_base<T>::discards_ratio(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
+FLQuant_base<T> FLCatch_base<T>::discards_ratio(const Index6& indices_min, const Index6& indices_max) const {
     return discards_ratio_flq(indices_min, indices_max);
 }
 
 template <typename T>
-FLQuant FLCatch_base<T>::catch_q_params() const {
+const FLQuant_param& FLCatch_base<T>::catch_q_params() const {
     return catch_q_flq;
 }
 
@@ -187,11 +224,7 @@ FLQuant FLCatch_base<T>::catch_q_params() const {
  * \param indices_max maximum indices for dimensions quant - iter (length 6)
  */
 template <typename T>
-FLQuant FLCatch_base<T>::catch_q_params(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
-    // Check dims are length 6
-    if ((indices_min.size() != 6) | (indices_max.size() != 6)){
-        Rcpp::stop("In FLCatch catch_q_params subsetter. Indices not of length 6\n");
-    }
+FLQuant FLCatch_base<T>::catch_q_params(const Index6& indices_min, const Index6& indices_max) const {
     // Checking first dimension (parameter) range
     std::vector<unsigned int> qdims = catch_q_flq.get_dim();
     if ((indices_min[0] < 1) | (indices_max[0] > qdims[0])){
@@ -205,9 +238,9 @@ FLQuant FLCatch_base<T>::catch_q_params(const std::vector<unsigned int> indices_
         }
     }
     // Build new FLQuant to store catch_q_params in
-    std::vector<unsigned int> new_dims {indices_max[0] - indices_min[0] + 1, indices_max[1] - indices_min[1] + 1, indices_max[2] - indices_min[2] + 1, indices_max[3] - indices_min[3] + 1, indices_max[4] - indices_min[4] + 1, indices_max[5] - indices_min[5] + 1};
+    Index6 new_dims{indices_max[0] - indices_min[0] + 1, indices_max[1] - indices_min[1] + 1, indices_max[2] - indices_min[2] + 1, indices_max[3] - indices_min[3] + 1, indices_max[4] - indices_min[4] + 1, indices_max[5] - indices_min[5] + 1};
     FLQuant q_params(new_dims[0], new_dims[1], new_dims[2], new_dims[3], new_dims[4], new_dims[5]);
-    std::vector<unsigned int> q_params_indices{1,1,1,1,1,1};
+    Index6 q_params_indices{1,1,1,1,1,1};
     for (unsigned int quant_count = 1; quant_count <= new_dims[0]; ++quant_count){
         q_params_indices[0] = quant_count + indices_min[0] - 1;
         for (unsigned int year_count = 1; year_count <= new_dims[1]; ++year_count){
@@ -276,27 +309,27 @@ FLQuant_base<T>& FLCatch_base<T>::discards_n() {
 }
 
 template <typename T>
-FLQuant& FLCatch_base<T>::landings_wt() {
+FLQuant_param& FLCatch_base<T>::landings_wt() {
     return landings_wt_flq;
 }
 
 template <typename T>
-FLQuant& FLCatch_base<T>::discards_wt() {
+FLQuant_param& FLCatch_base<T>::discards_wt() {
     return discards_wt_flq;
 }
 
 template <typename T>
-FLQuant& FLCatch_base<T>::catch_sel() {
+FLQuant_param& FLCatch_base<T>::catch_sel() {
     return catch_sel_flq;
 }
 
 template <typename T>
-FLQuant& FLCatch_base<T>::price() {
+FLQuant_param& FLCatch_base<T>::price() {
     return price_flq;
 }
 
 template <typename T>
-FLQuant& FLCatch_base<T>::catch_q_params() {
+FLQuant_param& FLCatch_base<T>::catch_q_params() {
     return catch_q_flq;
 }
 
@@ -304,24 +337,18 @@ FLQuant& FLCatch_base<T>::catch_q_params() {
 template <typename T>
 FLQuant_base<T> FLCatch_base<T>::revenue() const {
     // Call to revenue has indices only 5 long - no age
-    std::vector<unsigned int> indices_min {1,1,1,1,1};
-    std::vector<unsigned int> indices_max = landings_wt_flq.get_dim();
-    indices_max.erase(indices_max.begin());
+    Index5 indices_min{1,1,1,1,1};
+    Index5 indices_max = drop_quant(landings_wt_flq.get_dim());
     return revenue(indices_min, indices_max);
 }
 
 template <typename T>
-FLQuant_base<T> FLCatch_base<T>::revenue(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
+FLQuant_base<T> FLCatch_base<T>::revenue(const Index5& indices_min, const Index5& indices_max) const {
     // Revenue is not age structured
-    if((indices_min.size() != 5) | (indices_max.size() != 5)){
-        Rcpp::stop("In FLCatch revenue indices subsetter. indices_min and max must be of length 5\n");
-    }
     // price * landings.n * landings.wt are all age structured so need to add age dim to indices_min and max
-    std::vector<unsigned int> quant_indices_min = indices_min;
-    quant_indices_min.insert(quant_indices_min.begin(), 1);
-    std::vector<unsigned int> quant_indices_max = indices_max;
-    std::vector<unsigned int> dims = landings_wt_flq.get_dim();
-    quant_indices_max.insert(quant_indices_max.begin(), dims[0]);
+    Index6 quant_indices_min = add_quant(1, indices_min);
+    const std::vector<unsigned int>& dims = landings_wt_flq.get_dim();
+    Index6 quant_indices_max = add_quant(dims[0], indices_max);
     // Summed over all ages and requested unit range
     FLQuant_base<T> revenue = quant_sum(price(quant_indices_min, quant_indices_max) * landings_n(quant_indices_min, quant_indices_max) * landings_wt(quant_indices_min, quant_indices_max));
     return revenue;
@@ -329,92 +356,74 @@ FLQuant_base<T> FLCatch_base<T>::revenue(const std::vector<unsigned int> indices
 
 template <typename T>
 FLQuant_base<T> FLCatch_base<T>::landings() const {
-    std::vector<unsigned int> indices_min {1,1,1,1,1};
-    std::vector<unsigned int> indices_max = landings_wt_flq.get_dim();
-    indices_max.erase(indices_max.begin());
+    Index5 indices_min{1,1,1,1,1};
+    Index5 indices_max = drop_quant(landings_wt_flq.get_dim());
     return landings(indices_min, indices_max);
 }
 
 template <typename T>
-FLQuant_base<T> FLCatch_base<T>::landings(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
-    if((indices_min.size() != 5) | (indices_max.size() != 5)){
-        Rcpp::stop("In FLCatch landings indices subsetter. indices_min and max must be of length 5\n");
-    }
-    std::vector<unsigned int> quant_indices_min = indices_min;
-    quant_indices_min.insert(quant_indices_min.begin(), 1);
-    std::vector<unsigned int> quant_indices_max = indices_max;
-    std::vector<unsigned int> dims = landings_wt_flq.get_dim();
-    quant_indices_max.insert(quant_indices_max.begin(), dims[0]);
+FLQuant_base<T> FLCatch_base<T>::landings(const Index5& indices_min, const Index5& indices_max) const {
+    Index6 quant_indices_min = add_quant(1, indices_min);
+    const std::vector<unsigned int>& dims = landings_wt_flq.get_dim();
+    Index6 quant_indices_max = add_quant(dims[0], indices_max);
     FLQuant_base<T> landings = quant_sum(landings_n(quant_indices_min, quant_indices_max) * landings_wt(quant_indices_min, quant_indices_max));
     return landings;
 }
 
 template <typename T>
 FLQuant_base<T> FLCatch_base<T>::discards() const {
-    std::vector<unsigned int> indices_min {1,1,1,1,1};
-    std::vector<unsigned int> indices_max = discards_wt_flq.get_dim();
-    indices_max.erase(indices_max.begin());
+    Index5 indices_min{1,1,1,1,1};
+    Index5 indices_max = drop_quant(discards_wt_flq.get_dim());
     return discards(indices_min, indices_max);
 }
 
 template <typename T>
-FLQuant_base<T> FLCatch_base<T>::discards(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
-    if((indices_min.size() != 5) | (indices_max.size() != 5)){
-        Rcpp::stop("In FLCatch discards indices subsetter. indices_min and max must be of length 5\n");
-    }
-    std::vector<unsigned int> quant_indices_min = indices_min;
-    quant_indices_min.insert(quant_indices_min.begin(), 1);
-    std::vector<unsigned int> quant_indices_max = indices_max;
-    std::vector<unsigned int> dims = discards_wt_flq.get_dim();
-    quant_indices_max.insert(quant_indices_max.begin(), dims[0]);
+FLQuant_base<T> FLCatch_base<T>::discards(const Index5& indices_min, const Index5& indices_max) const {
+    Index6 quant_indices_min = add_quant(1, indices_min);
+    const std::vector<unsigned int>& dims = discards_wt_flq.get_dim();
+    Index6 quant_indices_max = add_quant(dims[0], indices_max);
     FLQuant_base<T> discards = quant_sum(discards_n(quant_indices_min, quant_indices_max) * discards_wt(quant_indices_min, quant_indices_max));
     return discards;
 }
 
 template <typename T>
 FLQuant_base<T> FLCatch_base<T>::catch_n() const {
-    std::vector<unsigned int> indices_min {1,1,1,1,1,1};
-    std::vector<unsigned int> indices_max = landings_wt_flq.get_dim();
+    Index6 indices_min{1,1,1,1,1,1};
+    Index6 indices_max = landings_wt_flq.get_dim();
     return catch_n(indices_min, indices_max);
 }
 
 template <typename T>
-FLQuant_base<T> FLCatch_base<T>::catch_n(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
+FLQuant_base<T> FLCatch_base<T>::catch_n(const Index6& indices_min, const Index6& indices_max) const {
     FLQuant_base<T> catch_n = discards_n(indices_min, indices_max) + landings_n(indices_min, indices_max);
     return catch_n;
 }
 
 template <typename T>
 FLQuant_base<T> FLCatch_base<T>::catches() const {
-    std::vector<unsigned int> indices_min {1,1,1,1,1};
-    std::vector<unsigned int> indices_max = discards_wt_flq.get_dim();
-    indices_max.erase(indices_max.begin());
+    Index5 indices_min{1,1,1,1,1};
+    Index5 indices_max = drop_quant(discards_wt_flq.get_dim());
     return catches(indices_min, indices_max);
 }
 
 template <typename T>
-FLQuant_base<T> FLCatch_base<T>::catches(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
-    if((indices_min.size() != 5) | (indices_max.size() != 5)){
-        Rcpp::stop("In FLCatch catches indices subsetter. indices_min and max must be of length 5\n");
-    }
-    std::vector<unsigned int> quant_indices_min = indices_min;
-    quant_indices_min.insert(quant_indices_min.begin(), 1);
-    std::vector<unsigned int> quant_indices_max = indices_max;
-    std::vector<unsigned int> dims = discards_wt_flq.get_dim();
-    quant_indices_max.insert(quant_indices_max.begin(), dims[0]);
+FLQuant_base<T> FLCatch_base<T>::catches(const Index5& indices_min, const Index5& indices_max) const {
+    Index6 quant_indices_min = add_quant(1, indices_min);
+    const std::vector<unsigned int>& dims = discards_wt_flq.get_dim();
+    Index6 quant_indices_max = add_quant(dims[0], indices_max);
     FLQuant_base<T> catches = quant_sum((discards_n(quant_indices_min, quant_indices_max) * discards_wt(quant_indices_min, quant_indices_max))  + (landings_n(quant_indices_min, quant_indices_max) * landings_wt(quant_indices_min, quant_indices_max)));
     return catches;
 }
 
 template <typename T>
 FLQuant_base<T> FLCatch_base<T>::catch_wt() const {
-    std::vector<unsigned int> indices_min {1,1,1,1,1,1};
-    std::vector<unsigned int> indices_max = landings_wt_flq.get_dim();
+    Index6 indices_min{1,1,1,1,1,1};
+    Index6 indices_max = landings_wt_flq.get_dim();
     return catch_wt(indices_min, indices_max);
 }
 
 template <typename T>
-FLQuant_base<T> FLCatch_base<T>::catch_wt(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
+FLQuant_base<T> FLCatch_base<T>::catch_wt(const Index6& indices_min, const Index6& indices_max) const {
     FLQuant_base<T> catch_wt = ((landings_wt(indices_min, indices_max) * landings_n(indices_min, indices_max)) + (discards_wt(indices_min, indices_max) * discards_n(indices_min, indices_max))) / (landings_n(indices_min, indices_max) + discards_n(indices_min, indices_max));
     return catch_wt;
 }
@@ -505,6 +514,25 @@ FLCatches_base<T>& FLCatches_base<T>::operator = (const FLCatches_base<T>& FLCat
 	return *this;
 }
 
+// Move constructor - takes the members of a temporary instead of copying them
+template<typename T>
+FLCatches_base<T>::FLCatches_base(FLCatches_base<T>&& FLCatches_source) noexcept{
+	catches  = std::move(FLCatches_source.catches);
+    desc = std::move(FLCatches_source.desc);
+    names = std::move(FLCatches_source.names);
+}
+
+// Move assignment operator
+template<typename T>
+FLCatches_base<T>& FLCatches_base<T>::operator = (FLCatches_base<T>&& FLCatches_source) noexcept{
+	if (this != &FLCatches_source){
+        catches  = std::move(FLCatches_source.catches);
+        desc = std::move(FLCatches_source.desc);
+        names = std::move(FLCatches_source.names);
+	}
+	return *this;
+}
+
 template<typename T>
 unsigned int FLCatches_base<T>::get_ncatches() const {
     return catches.size();
@@ -518,7 +546,7 @@ void FLCatches_base<T>::operator() (const FLCatch_base<T>& flc){
 
 // Get only data accessor - single element - starts at 1
 template <typename T>
-FLCatch_base<T> FLCatches_base<T>::operator () (const unsigned int element) const{
+const FLCatch_base<T>& FLCatches_base<T>::operator () (const unsigned int element) const{
     if (element > get_ncatches()){
         Rcpp::stop("FLCatches_base: Trying to access element larger than data size.");
     }
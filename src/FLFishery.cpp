@@ -82,33 +82,56 @@ FLFishery_base<T>& FLFishery_base<T>::operator = (const FLFishery_base<T>& FLFis
 	return *this;
 }
 
+// Move constructor - takes the members of a temporary instead of copying them
+template <typename T>
+FLFishery_base<T>::FLFishery_base(FLFishery_base<T>&& FLFishery_source) noexcept : FLCatches_base<T>(std::move(FLFishery_source)){
+    name = std::move(FLFishery_source.name);
+    effort_flq = std::move(FLFishery_source.effort_flq);
+    vcost_flq = std::move(FLFishery_source.vcost_flq);
+    fcost_flq = std::move(FLFishery_source.fcost_flq);
+    hperiod_flq = std::move(FLFishery_source.hperiod_flq);
+    range = std::move(FLFishery_source.range);
+}
+
+// Move assignment operator
+template <typename T>
+FLFishery_base<T>& FLFishery_base<T>::operator = (FLFishery_base<T>&& FLFishery_source) noexcept{
+	if (this != &FLFishery_source){
+        FLCatches_base<T>::operator=(std::move(FLFishery_source));
+        name = std::move(FLFishery_source.name);
+        effort_flq = std::move(FLFishery_source.effort_flq);
+        vcost_flq = std::move(FLFishery_source.vcost_flq);
+        fcost_flq = std::move(FLFishery_source.fcost_flq);
+        hperiod_flq = std::move(FLFishery_source.hperiod_flq);
+        range = std::move(FLFishery_source.range);
+	}
+	return *this;
+}
+
 // Accessors of economic slots
 template <typename T>
-FLQuant_base<T> FLFishery_base<T>::effort(std::vector<unsigned int> indices_min, std::vector<unsigned int> indices_max) const {
-    if ((indices_min.size() != 5) | (indices_min.size() != 5)){
-        Rcpp::stop("In FLFishery effort subsetter. Indices not of length 5\n");
-    }
+FLQuant_base<T> FLFishery_base<T>::effort(const Index5& indices_min, const Index5& indices_max) const {
     FLQuant_base<T> effort_out = effort_flq(1, 1, indices_min[0], indices_max[0], indices_min[1], indices_max[1], indices_min[2], indices_max[2], indices_min[3], indices_max[3], indices_min[4], indices_max[4]); 
     return effort_out;
 }
 
 template <typename T>
-FLQuant_base<T> FLFishery_base<T>::effort() const {
+const FLQuant_base<T>& FLFishery_base<T>::effort() const {
     return effort_flq;
 }
 
 template <typename T>
-FLQuant FLFishery_base<T>::vcost() const {
+const FLQuant& FLFishery_base<T>::vcost() const {
     return vcost_flq;
 }
 
 template <typename T>
-FLQuant FLFishery_base<T>::fcost() const {
+const FLQuant& FLFishery_base<T>::fcost() const {
     return fcost_flq;
 }
 
 template <typename T>
-FLQuant FLFishery_base<T>::hperiod() const {
+const FLQuant& FLFishery_base<T>::hperiod() const {
     return hperiod_flq;
 }
 
@@ -135,21 +158,17 @@ FLQuant& FLFishery_base<T>::hperiod() {
 // Methods
 template <typename T>
 FLQuant_base<T> FLFishery_base<T>::revenue() const {
-    std::vector<unsigned int> indices_min {1,1,1,1,1};
+    Index5 indices_min{1,1,1,1,1};
     // Get full dimension and knock the first one (age) off
-    std::vector<unsigned int> indices_max = (*this)(1).landings_wt().get_dim();
-    indices_max.erase(indices_max.begin());
+    Index5 indices_max = drop_quant((*this)(1).landings_wt().get_dim());
     return revenue(indices_min, indices_max);
 }
 
 // Sum over unit range
 template <typename T>
-FLQuant_base<T> FLFishery_base<T>::revenue(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
+FLQuant_base<T> FLFishery_base<T>::revenue(const Index5& indices_min, const Index5& indices_max) const {
     //indices_min and max are 5d
     // Revenue is not age structured
-    if((indices_min.size() != 5) | (indices_max.size() != 5)){
-        Rcpp::stop("In FLFishery revenue indices subsetter. indices_min and max must be of length 5 (no age dimension)\n");
-    }
     // Revenue had no age structure
     FLQuant_base<T> revenue(1,indices_max[0]-indices_min[0]+1, indices_max[1]-indices_min[1]+1, indices_max[2]-indices_min[2]+1, indices_max[3]-indices_min[3]+1, indices_max[4]-indices_min[4]+1, 0.0);
     // Set dimnames - based on effort - need to set unit range to 1
@@ -227,6 +246,25 @@ FLFisheries_base<T>& FLFisheries_base<T>::operator = (const FLFisheries_base<T>&
 	return *this;
 }
 
+// Move constructor - takes the members of a temporary instead of copying them
+template<typename T>
+FLFisheries_base<T>::FLFisheries_base(FLFisheries_base<T>&& FLFisheries_source) noexcept{
+	fisheries  = std::move(FLFisheries_source.fisheries);
+    desc = std::move(FLFisheries_source.desc);
+    names = std::move(FLFisheries_source.names);
+}
+
+// Move assignment operator
+template<typename T>
+FLFisheries_base<T>& FLFisheries_base<T>::operator = (FLFisheries_base<T>&& FLFisheries_source) noexcept{
+	if (this != &FLFisheries_source){
+        fisheries  = std::move(FLFisheries_source.fisheries);
+        desc = std::move(FLFisheries_source.desc);
+        names = std::move(FLFisheries_source.names);
+	}
+	return *this;
+}
+
 // Accessors
 template<typename T>
 unsigned int FLFisheries_base<T>::get_nfisheries() const {
@@ -235,7 +273,7 @@ unsigned int FLFisheries_base<T>::get_nfisheries() const {
 
 // Get only data accessor - single element - starts at 1
 template <typename T>
-FLFishery_base<T> FLFisheries_base<T>::operator () (const unsigned int fishery) const{
+const FLFishery_base<T>& FLFisheries_base<T>::operator () (const unsigned int fishery) const{
     if (fishery > get_nfisheries()){
         Rcpp::stop("FLFisheries_base: Trying to access fishery larger than data size.");
     }
@@ -253,7 +291,7 @@ FLFishery_base<T>& FLFisheries_base<T>::operator () (const unsigned int fishery)
 
 // Get only data accessor - two elements - both start at 1
 template <typename T>
-FLCatch_base<T> FLFisheries_base<T>::operator () (const unsigned int fishery, const unsigned int catches) const{
+const FLCatch_base<T>& FLFisheries_base<T>::operator () (const unsigned int fishery, const unsigned int catches) const{
     if (fishery > get_nfisheries()){
         Rcpp::stop("FLFisheries_base: Trying to access fishery larger than data size.");
     }
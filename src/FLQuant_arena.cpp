@@ -0,0 +1,183 @@
+/*
+ * Copyright 2014 FLR Team. Distributed under the GPL 2 or later
+ * Maintainer: Finlay Scott, JRC
+ */
+
+#include "../inst/include/FLQuant_arena.h"
+#include <algorithm>
+#include <new>
+
+namespace {
+// Blocks are 16 byte aligned, the same as operator new on 64 bit platforms
+const std::size_t arena_alignment = 16;
+// The header in front of each block
+const std::size_t arena_header_size = 16;
+// The smallest chunk
+const std::size_t arena_min_chunk_size = 1 << 20;
+// Blocks larger than this go to the heap
+const std::size_t arena_max_block_size = 1 << 26;
+
+std::size_t round_up(const std::size_t bytes){
+    return (bytes + arena_alignment - 1) / arena_alignment * arena_alignment;
+}
+}
+
+/*! \brief A chunk of memory that blocks are bump allocated from
+ *
+ * live counts the blocks in the chunk that have not been freed, plus 1 while the chunk is owned by an arena.
+ * Whoever brings live to 0 frees the chunk.
+ */
+struct FLQuant_arena::chunk {
+    char* memory;
+    std::size_t size;
+    std::size_t used;
+    std::atomic<std::size_t> live;
+};
+
+FLQuant_arena::FLQuant_arena() : active(0) {
+    counters = FLQuant_arena_counters{0, 0, 0};
+}
+
+FLQuant_arena::~FLQuant_arena(){
+    clear();
+}
+
+FLQuant_arena& FLQuant_arena::get(){
+    static thread_local FLQuant_arena arena;
+    return arena;
+}
+
+bool FLQuant_arena::is_active() const{
+    return active > 0;
+}
+
+FLQuant_arena_counters FLQuant_arena::get_counters() const{
+    return counters;
+}
+
+// Drop one reference to a chunk and free it if it was the last
+void FLQuant_arena::release(chunk* chunk_ptr){
+    if (chunk_ptr->live.fetch_sub(1, std::memory_order_acq_rel) == 1){
+        ::operator delete(chunk_ptr->memory);
+        delete chunk_ptr;
+    }
+}
+
+// Chunks at least double the memory held by the arena so only a few are made before the arena settles on the size of a timestep
+FLQuant_arena::chunk* FLQuant_arena::new_chunk(const std::size_t min_bytes){
+    std::size_t held = 0;
+    for (auto chunk_ptr : chunks){
+        held += chunk_ptr->size;
+    }
+    const std::size_t size = std::max(std::max(min_bytes, held), arena_min_chunk_size);
+    chunk* chunk_ptr = new chunk;
+    chunk_ptr->memory = static_cast<char*>(::operator new(size));
+    chunk_ptr->size = size;
+    chunk_ptr->used = 0;
+    chunk_ptr->live.store(1, std::memory_order_relaxed);
+    chunks.push_back(chunk_ptr);
+    return chunk_ptr;
+}
+
+/*! \brief Get a block of memory
+ *
+ * From the current chunk if the arena is active, else from the heap.
+ * \param bytes The size of the block.
+ */
+void* FLQuant_arena::allocate(const std::size_t bytes){
+    const std::size_t block_size = arena_header_size + round_up(bytes);
+    if (!is_active() || (block_size > arena_max_block_size)){
+        if (is_active()){
+            ++counters.heap_allocations;
+        }
+        char* block = static_cast<char*>(::operator new(block_size));
+        *reinterpret_cast<chunk**>(block) = nullptr;
+        return block + arena_header_size;
+    }
+    chunk* chunk_ptr = chunks.empty() ? nullptr : chunks.back();
+    if ((chunk_ptr == nullptr) || (chunk_ptr->size - chunk_ptr->used < block_size)){
+        chunk_ptr = new_chunk(block_size);
+    }
+    char* block = chunk_ptr->memory + chunk_ptr->used;
+    chunk_ptr->used += block_size;
+    chunk_ptr->live.fetch_add(1, std::memory_order_relaxed);
+    *reinterpret_cast<chunk**>(block) = chunk_ptr;
+    ++counters.allocations;
+    counters.bytes += bytes;
+    return block + arena_header_size;
+}
+
+/*! \brief Free a block from any arena or the heap
+ *
+ * \param block The block returned by allocate().
+ */
+void FLQuant_arena::deallocate(void* block){
+    if (block == nullptr){
+        return;
+    }
+    char* start = static_cast<char*>(block) - arena_header_size;
+    chunk* chunk_ptr = *reinterpret_cast<chunk**>(start);
+    if (chunk_ptr == nullptr){
+        ::operator delete(start);
+    }
+    else {
+        release(chunk_ptr);
+    }
+}
+
+/*! \brief Rewind the arena, e.g. between timesteps
+ *
+ * Chunks with no live blocks are reused. If there is more than one, they are replaced by a single chunk of the same total size so that the next timestep is contiguous.
+ * Chunks with live blocks are handed over to those blocks.
+ * The counters are set to 0.
+ */
+void FLQuant_arena::reset(){
+    std::vector<chunk*> free_chunks;
+    std::size_t free_size = 0;
+    for (auto chunk_ptr : chunks){
+        // Only this arena can add blocks so if there are none they cannot appear while we look
+        if (chunk_ptr->live.load(std::memory_order_acquire) == 1){
+            free_chunks.push_back(chunk_ptr);
+            free_size += chunk_ptr->size;
+        }
+        else {
+            release(chunk_ptr);
+        }
+    }
+    chunks.clear();
+    if (free_chunks.size() == 1){
+        free_chunks[0]->used = 0;
+        chunks.push_back(free_chunks[0]);
+    }
+    else if (free_chunks.size() > 1){
+        for (auto chunk_ptr : free_chunks){
+            release(chunk_ptr);
+        }
+        new_chunk(free_size);
+    }
+    counters = FLQuant_arena_counters{0, 0, 0};
+}
+
+/*! \brief Give up all the chunks
+ *
+ * Chunks with live blocks are freed with their last block.
+ */
+void FLQuant_arena::clear(){
+    for (auto chunk_ptr : chunks){
+        release(chunk_ptr);
+    }
+    chunks.clear();
+    counters = FLQuant_arena_counters{0, 0, 0};
+}
+
+FLQuant_arena_scope::FLQuant_arena_scope(){
+    ++FLQuant_arena::get().active;
+}
+
+FLQuant_arena_scope::~FLQuant_arena_scope(){
+    FLQuant_arena& arena = FLQuant_arena::get();
+    if (--arena.active == 0){
+        arena.clear();
+    }
+}
+
@@ -6,16 +6,164 @@
 #include <time.h> // included for some basic profiling
 #include "../inst/include/FLQuant_base.h"
 
+//------------------ FLQuant_dimnames ---------------------------------
+
+// The default names of the dimensions - made once and shared
+const std::shared_ptr<const std::array<std::string, 6> >& default_dim_names(){
+    static const std::shared_ptr<const std::array<std::string, 6> > dim_names = std::make_shared<const std::array<std::string, 6> >(std::array<std::string, 6>{{"quant", "year", "unit", "season", "area", "iter"}});
+    return dim_names;
+}
+
+/*! \brief Dimnames with no dimensions
+ */
+FLQuant_dimnames::FLQuant_dimnames() : dim_names(default_dim_names()) {
+    lengths.fill(0);
+}
+
+/*! \brief Blank dimnames
+ *
+ * No names are stored.
+ * \param dim The dimensions (length 6).
+ */
+FLQuant_dimnames::FLQuant_dimnames(const std::vector<unsigned int>& dim) : dim_names(default_dim_names()) {
+    if (dim.size() != 6){
+        Rcpp::stop("In FLQuant_dimnames constructor. dim not of length 6.\n");
+    }
+    std::copy(dim.begin(), dim.end(), lengths.begin());
+}
+
+/*! \brief Generic SEXP constructor used as intrusive as
+ *
+ * \param dimnames_sexp The dimnames list of an R array with 6 dimensions, e.g. an FLQuant.
+ */
+FLQuant_dimnames::FLQuant_dimnames(SEXP dimnames_sexp){
+    Rcpp::List dimnames_list(dimnames_sexp);
+    if (dimnames_list.size() != 6){
+        Rcpp::stop("In FLQuant_dimnames constructor. dimnames not of length 6.\n");
+    }
+    Rcpp::RObject list_names = dimnames_list.attr("names");
+    if (list_names.isNULL()){
+        dim_names = default_dim_names();
+    }
+    else {
+        std::array<std::string, 6> dim_names_in;
+        std::vector<std::string> list_names_vec = Rcpp::as<std::vector<std::string> >(list_names);
+        std::copy(list_names_vec.begin(), list_names_vec.end(), dim_names_in.begin());
+        dim_names = std::make_shared<const std::array<std::string, 6> >(dim_names_in);
+    }
+    for (unsigned int dim_no = 0; dim_no < 6; ++dim_no){
+        Rcpp::RObject dim_names_sexp = dimnames_list[dim_no];
+        if (dim_names_sexp.isNULL()){
+            Rcpp::stop("In FLQuant_dimnames constructor. Names of a dimension are NULL.\n");
+        }
+        set_names(dim_no, Rcpp::as<std::vector<std::string> >(dim_names_sexp));
+    }
+}
+
+/*! \brief Used as generic intrusive wrap to return the dimnames to R
+ *
+ * Blank names are returned as empty strings.
+ */
+FLQuant_dimnames::operator SEXP() const{
+    Rcpp::List dimnames_list(6);
+    for (unsigned int dim_no = 0; dim_no < 6; ++dim_no){
+        dimnames_list[dim_no] = (*this)[dim_no];
+    }
+    dimnames_list.attr("names") = std::vector<std::string>(dim_names->begin(), dim_names->end());
+    return Rcpp::wrap(dimnames_list);
+}
+
+std::vector<unsigned int> FLQuant_dimnames::get_dim() const{
+    return std::vector<unsigned int>(lengths.begin(), lengths.end());
+}
+
+std::string FLQuant_dimnames::get_dim_name(const unsigned int dim_no) const{
+    if (dim_no > 5){
+        Rcpp::stop("In FLQuant_dimnames. dim_no must be less than 6.\n");
+    }
+    return (*dim_names)[dim_no];
+}
+
+std::vector<std::string> FLQuant_dimnames::operator [] (const unsigned int dim_no) const{
+    if (dim_no > 5){
+        Rcpp::stop("In FLQuant_dimnames. dim_no must be less than 6.\n");
+    }
+    if (names[dim_no]){
+        return *names[dim_no];
+    }
+    return std::vector<std::string>(lengths[dim_no]);
+}
+
+/*! \brief Replace the names along a dimension
+ *
+ * The length of the dimension becomes the number of names.
+ * \param dim_no The dimension (starting at 0).
+ * \param names_in The new names.
+ */
+void FLQuant_dimnames::set_names(const unsigned int dim_no, const std::vector<std::string>& names_in){
+    set_names(dim_no, std::make_shared<const std::vector<std::string> >(names_in));
+}
+
+/*! \brief Replace the names along a dimension with names that are shared
+ *
+ * \param dim_no The dimension (starting at 0).
+ * \param names_in The new names.
+ */
+void FLQuant_dimnames::set_names(const unsigned int dim_no, const names_ptr& names_in){
+    if (dim_no > 5){
+        Rcpp::stop("In FLQuant_dimnames. dim_no must be less than 6.\n");
+    }
+    names[dim_no] = names_in;
+    lengths[dim_no] = names_in->size();
+}
+
+/*! \brief Subset the names along a dimension
+ *
+ * The names are only copied if they are not blank and the subset is not the whole dimension.
+ * \param dim_no The dimension (starting at 0).
+ * \param first The first name to keep (starting at 1).
+ * \param length The number of names to keep.
+ */
+void FLQuant_dimnames::subset(const unsigned int dim_no, const unsigned int first, const unsigned int length){
+    if (dim_no > 5){
+        Rcpp::stop("In FLQuant_dimnames. dim_no must be less than 6.\n");
+    }
+    if ((first < 1) || ((first + length - 1) > lengths[dim_no])){
+        Rcpp::stop("In FLQuant_dimnames subset. Subset is outside of the dimension.\n");
+    }
+    if ((first == 1) && (length == lengths[dim_no])){
+        return;
+    }
+    if (names[dim_no]){
+        names[dim_no] = std::make_shared<const std::vector<std::string> >(names[dim_no]->begin() + first - 1, names[dim_no]->begin() + first - 1 + length);
+    }
+    lengths[dim_no] = length;
+}
+
+// Names of the dimensions collapsed by the summary functions - made once and shared
+const FLQuant_dimnames::names_ptr& summary_names(const unsigned int dim_no){
+    static const FLQuant_dimnames::names_ptr all_names = std::make_shared<const std::vector<std::string> >(1, "all");
+    static const FLQuant_dimnames::names_ptr year_names = std::make_shared<const std::vector<std::string> >(1, "1");
+    static const FLQuant_dimnames::names_ptr unit_names = std::make_shared<const std::vector<std::string> >(1, "unique");
+    if (dim_no == 1){
+        return year_names;
+    }
+    if (dim_no == 2){
+        return unit_names;
+    }
+    return all_names;
+}
+
 /*! \brief Default constructor 
  *
  * Creates an empty FLQuant with no dims, dimnames or units
  */
 template <typename T>
 FLQuant_base<T>::FLQuant_base(){
-    data = std::vector<T>();
+    data = data_type();
 	  units = std::string(); 
     dim = std::vector<unsigned int>();
-    dimnames = Rcpp::List();
+    dimnames = FLQuant_dimnames();
 }
 
 // Need to add check that the SEXP is an FLQuant
@@ -35,12 +183,12 @@ FLQuant_base<T>::FLQuant_base(SEXP flq_sexp){
     // SEXP Quant = R_do_slot(flq_sexp, Rf_install(".Data"));
     // Other FLQuant bits
     dim = Rcpp::as<std::vector<unsigned int>>(data_nv.attr("dim"));
-	dimnames = data_nv.attr("dimnames");
+	dimnames = FLQuant_dimnames(static_cast<SEXP>(data_nv.attr("dimnames")));
 	units = Rcpp::as<std::string>(flq_s4.slot("units"));
     // Sort out data - need to copy across as maybe AD
     // Initialise data to the correct size
     data.reserve(std::accumulate(dim.begin(), dim.end(), 1, std::multiplies<unsigned int>()));
-    data.insert(data.begin(), data_nv.begin(), data_nv.end());
+    data.assign(data_nv.begin(), data_nv.end());
 }
 
 /*! \brief Creates an FLQuant of a certain size filled with 0
@@ -68,23 +216,15 @@ FLQuant_base<T>::FLQuant_base(const unsigned int nquant, const unsigned int nyea
  */
 template <typename T>
 //FLQuant_base<T>::FLQuant_base(const std::vector<unsigned int> dims, const T value) : FLQuant_base<T>(dims[0], dims[1], dims[2], dims[3], dims[4], dims[5], value) { // Call other constructor
-FLQuant_base<T>::FLQuant_base(const std::vector<unsigned int> dims, const T value) { // Call other constructor
+FLQuant_base<T>::FLQuant_base(const std::vector<unsigned int>& dims, const T value) { // Call other constructor
     if (dims.size() != 6){
         Rcpp::stop("In FLQuant integer vector constructor. Vector not of length 6.\n");
     }
 	units = std::string(); // Empty string - just ""
     dim = dims;
-    data = std::vector<T>(dims[0] * dims[1] * dims[2] * dims[3] * dims[4] * dims[5], value);
-    // How to fill dimnames up appropriately?
-    // Just of the right size at the moment.
-    // Could use ::create to pass in actual characters, but then do we want just 1:nage, 1:nyear etc?
-    dimnames = Rcpp::List::create(
-      Rcpp::Named("quant", Rcpp::CharacterVector(dims[0])),
-      Rcpp::Named("year", Rcpp::CharacterVector(dims[1])),
-      Rcpp::Named("unit", Rcpp::CharacterVector(dims[2])),
-      Rcpp::Named("season", Rcpp::CharacterVector(dims[3])),
-      Rcpp::Named("area", Rcpp::CharacterVector(dims[4])),
-      Rcpp::Named("iter", Rcpp::CharacterVector(dims[5])));
+    data = data_type(dims[0] * dims[1] * dims[2] * dims[3] * dims[4] * dims[5], value);
+    // Blank dimnames of the right size - nothing is stored
+    dimnames = FLQuant_dimnames(dims);
 }
 
 /*! \brief Used as generic intrusive wrap to return FLQuant to R
@@ -116,7 +256,7 @@ FLQuant_base<double>::operator SEXP() const{
         [](double x) { return x; } );
     // Apply dims and dimnames
 	data_nv.attr("dim") = dim;
-	data_nv.attr("dimnames") = dimnames;
+	data_nv.attr("dimnames") = static_cast<SEXP>(dimnames);
     // Fill the slots
     flq_s4.slot(".Data") = data_nv;
     flq_s4.slot("units") = units;
@@ -140,7 +280,7 @@ FLQuant_base<adouble>::operator SEXP() const{
         [](adouble x) { return Value(x); } );
     // Apply dims and dimnames
 	data_nv.attr("dim") = dim;
-	data_nv.attr("dimnames") = dimnames;
+	data_nv.attr("dimnames") = static_cast<SEXP>(dimnames);
     // Fill the slots
     flq_s4.slot(".Data") = data_nv;
     flq_s4.slot("units") = units;
@@ -150,10 +290,10 @@ FLQuant_base<adouble>::operator SEXP() const{
 // Copy constructor - else 'data' can be pointed at by multiple instances
 template<typename T>
 FLQuant_base<T>::FLQuant_base(const FLQuant_base<T>& FLQuant_source){
-	data  = FLQuant_source.data; // std::vector always does deep copy
+	data  = FLQuant_source.data; // FLQuant_data always does deep copy
 	units = FLQuant_source.units; // std::string always does deep copy
 	dim  = FLQuant_source.dim; // std::vector always does deep copy
-    dimnames = Rcpp::clone<Rcpp::List>(FLQuant_source.dimnames);
+    dimnames = FLQuant_source.dimnames; // The names are shared and never changed
 }
 
 // Assignment operator to ensure deep copy - else 'data' can be pointed at by multiple instances
@@ -161,11 +301,28 @@ template<typename T>
 FLQuant_base<T>& FLQuant_base<T>::operator = (const FLQuant_base<T>& FLQuant_source){
     //Rprintf("In FLQuant_base<T> assignment operator\n");
 	if (this != &FLQuant_source){
-        data  = FLQuant_source.data; // std::vector always does deep copy
+        data  = FLQuant_source.data; // FLQuant_data always does deep copy
         units = FLQuant_source.units; // std::string always does deep copy
         dim = FLQuant_source.dim; // std::string always does deep copy
         //dim = Rcpp::clone<Rcpp::IntegerVector>(FLQuant_source.dim);
-        dimnames = Rcpp::clone<Rcpp::List>(FLQuant_source.dimnames);
+        dimnames = FLQuant_source.dimnames; // The names are shared and never changed
+	}
+	return *this;
+}
+
+// Move constructor - takes the data of a temporary, e.g. a returned FLQuant, instead of copying it
+template<typename T>
+FLQuant_base<T>::FLQuant_base(FLQuant_base<T>&& FLQuant_source) noexcept : data(std::move(FLQuant_source.data)), units(std::move(FLQuant_source.units)), dim(std::move(FLQuant_source.dim)), dimnames(std::move(FLQuant_source.dimnames)){
+}
+
+// Move assignment operator
+template<typename T>
+FLQuant_base<T>& FLQuant_base<T>::operator = (FLQuant_base<T>&& FLQuant_source) noexcept{
+	if (this != &FLQuant_source){
+        data  = std::move(FLQuant_source.data);
+        units = std::move(FLQuant_source.units);
+        dim = std::move(FLQuant_source.dim);
+        dimnames = std::move(FLQuant_source.dimnames);
 	}
 	return *this;
 }
@@ -187,8 +344,7 @@ FLQuant_base<adouble>::FLQuant_base(const FLQuant_base<double>& FLQuant_source){
     units = FLQuant_source.get_units(); // std::string always does deep copy
     dim = FLQuant_source.get_dim();
     dimnames = FLQuant_source.get_dimnames(); 
-    std::vector<double> source_data = FLQuant_source.get_data();
-    data.insert(data.begin(), source_data.begin(), source_data.end());
+    data.assign(FLQuant_source.begin(), FLQuant_source.end());
 }
 
 // Specialise the FLQuant_base<T>(FLQuant_base<T2>) constructor 
@@ -199,11 +355,9 @@ FLQuant_base<double>::FLQuant_base(const FLQuant_base<adouble>& FLQuant_source){
     units = FLQuant_source.get_units(); // std::string always does deep copy
     dim = FLQuant_source.get_dim();
     dimnames = FLQuant_source.get_dimnames(); 
-    std::vector<adouble> source_data = FLQuant_source.get_data();
-    std::vector<double> new_data(FLQuant_source.get_size());
-    std::transform(FLQuant_source.begin(), FLQuant_source.end(), new_data.begin(), 
-            [] (adouble x) {return Value(x);});
-    data = new_data;
+    data = data_type(FLQuant_source.get_size());
+    std::transform(FLQuant_source.begin(), FLQuant_source.end(), data.begin(), 
+            [] (const adouble& x) {return Value(x);});
 }
 
 //------------------ begin and end ---------------------------------
@@ -232,23 +386,23 @@ typename FLQuant_base<T>::const_iterator FLQuant_base<T>::end() const {
 //------------------ Accessors ---------------------------------
 
 template <typename T>
-std::vector<T> FLQuant_base<T>::get_data() const{
+const typename FLQuant_base<T>::data_type& FLQuant_base<T>::get_data() const{
 	return data;
 }
 
 template <typename T>
-std::string FLQuant_base<T>::get_units() const{
+const std::string& FLQuant_base<T>::get_units() const{
 	return units;
 }
 
 template <typename T>
-std::vector<unsigned int> FLQuant_base<T>::get_dim() const{
+const std::vector<unsigned int>& FLQuant_base<T>::get_dim() const{
     return dim;
 }
 
 template <typename T>
-Rcpp::List FLQuant_base<T>::get_dimnames() const{
-	return Rcpp::clone<Rcpp::List>(dimnames);
+const FLQuant_dimnames& FLQuant_base<T>::get_dimnames() const{
+	return dimnames;
 }
 
 template <typename T>
@@ -293,7 +447,6 @@ unsigned int FLQuant_base<T>::get_data_element(const unsigned int quant, const u
     if ((quant <= 0) || (year <= 0) || (unit <= 0) || (season <= 0) || (area <= 0) || (iter <= 0)){
             Rcpp::stop("In FLQuant accessor. quant etc must be > 0\n");
     }
-    std::vector<unsigned int> dim = get_dim();
     if ((quant > dim[0]) || (year > dim[1]) || (unit > dim[2]) || (season > dim[3]) || (area > dim[4])){
             Rcpp::stop("Trying to access element outside of quant, year, unit, season or area dim range.");
     }
@@ -321,7 +474,7 @@ template <typename T>
 int FLQuant_base<T>::get_first_age() const{
     //std::vector<std::string> age_names = Rcpp::as<std::vector<std::string> >(n_flq.get_dimnames()[0]);
     //std::string first_age_str = age_names[0];
-    std::string test = (Rcpp::as<std::vector<std::string> >(get_dimnames()[0]))[0];
+    std::string test = dimnames[0][0];
     int first_age = std::stoi(test);
     return first_age;
 }
@@ -364,89 +517,23 @@ T& FLQuant_base<T>::operator () (const unsigned int quant, const unsigned int ye
 
 // Get data accessor - all dims with an integer vector
 template <typename T>
-T FLQuant_base<T>::operator () (const std::vector<unsigned int> indices) const {
-    if (indices.size() > 6){
-        Rcpp::stop("FLQuant indices accessor - indices longer than 6.");
-    }
-    if (indices.size() < 6){
-        Rcpp::stop("FLQuant indices accessor - indices shorter than 6.");
-    }
+T FLQuant_base<T>::operator () (const Index6& indices) const {
 	unsigned int element = get_data_element(indices[0],indices[1],indices[2],indices[3],indices[4],indices[5]);
 	return data[element];
 }
 
 // Data accessor - all dims with an integer vector
 template <typename T>
-T& FLQuant_base<T>::operator () (const std::vector<unsigned int> indices) {
-    if (indices.size() > 6){
-        Rcpp::stop("FLQuant indices accessor - indices longer than 6.");
-    }
-    if (indices.size() < 6){
-        Rcpp::stop("FLQuant indices accessor - indices shorter than 6.");
-    }
+T& FLQuant_base<T>::operator () (const Index6& indices) {
 	unsigned int element = get_data_element(indices[0],indices[1],indices[2],indices[3],indices[4],indices[5]);
 	return data[element];
 }
 
 // Subset - max_iter is not const as can be changed due to 1 or N
+// The checks are made by the view
 template <typename T>
 FLQuant_base<T> FLQuant_base<T>::operator () (const unsigned int quant_min, const unsigned int quant_max, const unsigned int year_min, const unsigned int year_max, const unsigned int unit_min, const unsigned int unit_max, const unsigned int season_min, const unsigned int season_max, const unsigned int area_min, const unsigned int area_max, const unsigned int iter_min, unsigned int iter_max) const {
-    // Check ranges
-    if ((quant_min < 1) || (year_min < 1)|| (unit_min < 1)|| (season_min < 1)|| (area_min < 1)|| (iter_min < 1)) {
-        Rcpp::stop("In FLQuant subsetter: requested min dimensions are less than 1.\n");
-    }
-    // Check max >= min
-    if ((quant_max < quant_min) || (year_max < year_min) || (unit_max < unit_min) || (season_max < season_min) || (area_max < area_min) || (iter_max < iter_min)){
-        Rcpp::stop("In FLQuant subsetter: min dim > max\n");
-    }
-
-    // Check asked for indices are not greater than allowed - iter is a special case
-    if ((quant_max > get_nquant()) || (year_max > get_nyear()) || (unit_max > get_nunit()) || (season_max > get_nseason()) || (area_max > get_narea())){
-        Rcpp::stop("In FLQuant subsetter: requested subset dimensions are outside of FLQuant bounds.\n");
-    }
-    // Iterations are a special case: Allowed 1 or N. If FLQ has 1 iter and you ask for more, you get the 1. As R.
-    if (iter_max > get_niter()){
-        // If only 1 iter in FLQuant, and asking for subset 1 to N, return 1 to 1
-        if ((iter_min==1) & (get_niter()==1)){
-            iter_max = 1;
-        }
-        else {
-            Rcpp::stop("In FLQuant subsetter: Max iter > Niters. Only allowed if FLQuant has 1 iter. Even then subset can only be 1:1 or 1:N iters.\n");
-        }
-    }
-
-    // Using brace initialiser
-    std::vector<unsigned int> new_dim{quant_max - quant_min + 1, year_max - year_min + 1, unit_max - unit_min + 1, season_max - season_min + 1, area_max - area_min + 1, iter_max - iter_min + 1};
-
-    FLQuant_base<T> out(new_dim[0], new_dim[1], new_dim[2], new_dim[3], new_dim[4], new_dim[5]);
-    out.set_units(get_units());
-    for (unsigned int quant_count = 1; quant_count <= new_dim[0]; ++quant_count){
-        for (unsigned int year_count = 1; year_count <= new_dim[1]; ++year_count){
-            for (unsigned int unit_count = 1; unit_count <= new_dim[2]; ++unit_count){
-                for (unsigned int season_count = 1; season_count <= new_dim[3]; ++season_count){
-                    for (unsigned int area_count = 1; area_count <= new_dim[4]; ++area_count){
-                        for (unsigned int iter_count = 1; iter_count <= new_dim[5]; ++iter_count){
-                            unsigned int element_orig = get_data_element(quant_count + quant_min - 1, year_count + year_min - 1, unit_count + unit_min - 1, season_count + season_min - 1, area_count + area_min - 1, iter_count + iter_min - 1);
-                            out(quant_count, year_count, unit_count, season_count, area_count, iter_count) = data[element_orig];
-    }}}}}}
-
-    // Sorting out dimnames - not a speed issue
-    std::vector<unsigned int> min_dim{quant_min, year_min, unit_min, season_min, area_min, iter_min};
-    Rcpp::List old_dimnames = get_dimnames();
-    Rcpp::List new_dimnames = get_dimnames();
-    std::vector<std::string> temp_old_dimname;
-    std::vector<std::string> temp_new_dimname;
-
-    for (int dim_counter = 0; dim_counter < 6; ++dim_counter){ // counts over dims
-        temp_old_dimname = Rcpp::as<std::vector<std::string> >(old_dimnames[dim_counter]);
-        temp_new_dimname.resize(new_dim[dim_counter]); 
-        for (unsigned int counter = 0; counter < new_dim[dim_counter]; ++counter){ // counts along dims
-            temp_new_dimname[counter] = temp_old_dimname[counter + min_dim[dim_counter] - 1];
-        }
-        new_dimnames[dim_counter] = temp_new_dimname;
-    }
-    out.set_dimnames(new_dimnames);
-    return out;
+    return view({quant_min, year_min, unit_min, season_min, area_min, iter_min}, {quant_max, year_max, unit_max, season_max, area_max, iter_max}).to_FLQuant();
 }
 
 /*! \brief Subsets an FLQuant
@@ -456,10 +543,7 @@ FLQuant_base<T> FLQuant_base<T>::operator () (const unsigned int quant_min, cons
  * \param indices_max A vector of length 6 with the maximum indices of the 6 dimensions
  */
 template <typename T>
-FLQuant_base<T> FLQuant_base<T>::operator () (const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
-    if ((indices_min.size() != 6) | (indices_max.size() != 6)){
-        Rcpp::stop("In neat FLQuant subsetter. Size of indices_min or max not equal to 6\n");
-    }
+FLQuant_base<T> FLQuant_base<T>::operator () (const Index6& indices_min, const Index6& indices_max) const {
     return (*this)(indices_min[0], indices_max[0], indices_min[1], indices_max[1], indices_min[2], indices_max[2], indices_min[3], indices_max[3], indices_min[4], indices_max[4], indices_min[5], indices_max[5]);
 }
 
@@ -469,6 +553,17 @@ FLQuant_base<T> FLQuant_base<T>::operator () (const unsigned int quant, const un
     return out;
 }
 
+/*! \brief A view of a subset of an FLQuant
+ *
+ * No data is copied. The view is only valid while the FLQuant exists and is not resized.
+ * \param indices_min A vector of length 6 with the minimum indices of the 6 dimensions
+ * \param indices_max A vector of length 6 with the maximum indices of the 6 dimensions
+ */
+template <typename T>
+FLQuantView<T> FLQuant_base<T>::view(const Index6& indices_min, const Index6& indices_max) const {
+    return FLQuantView<T>(*this, indices_min, indices_max);
+}
+
 //------------- Setting methods ----------------
 
 template <typename T>
@@ -479,24 +574,24 @@ void FLQuant_base<T>::set_data(const std::vector<T>& data_in){
     if(dim_prod != data_in.size()){
         Rcpp::stop("Cannot set data. Data size does not match dims.\n");
     }
-    data = data_in;
+    data.assign(data_in.begin(), data_in.end());
 }
 
 // Checks if dimnames dimensions fit current dim
 template <typename T>
-void FLQuant_base<T>::set_dimnames(const Rcpp::List& dimnames_in){
-    Rcpp::CharacterVector name;
-    unsigned int dim_length = 0;
-    for (int i = 0; i <= 5; ++i){
-        name = dimnames_in[i];
-        dim_length = name.size();
-        if (dim_length != dim[i]){
-            Rcpp::stop("Cannot set dimnames as new dimnames are different size to current dimensions\n");
-        }
+void FLQuant_base<T>::set_dimnames(const FLQuant_dimnames& dimnames_in){
+    if (dimnames_in.get_dim() != dim){
+        Rcpp::stop("Cannot set dimnames as new dimnames are different size to current dimensions\n");
     }
     dimnames = dimnames_in;
 }
 
+// From an R list of dimnames
+template <typename T>
+void FLQuant_base<T>::set_dimnames(const Rcpp::List& dimnames_in){
+    set_dimnames(FLQuant_dimnames(static_cast<SEXP>(dimnames_in)));
+}
+
 template <typename T>
 void FLQuant_base<T>::set_units(const std::string& units_in){
     units = units_in;
@@ -508,7 +603,7 @@ FLQuant_base<T> FLQuant_base<T>::propagate_iters(const int iters) const{
         Rcpp::stop("In FLQuant_base.extend_iters: only works if original data has 1 iter.\n");
     }
     const int new_size = data.size() * iters; 
-    std::vector<T> new_data(new_size);
+    data_type new_data(new_size);
     std::vector<std::string> iter_dimnames(iters);
     // Copy data
     for (int iter_counter = 0; iter_counter < iters; ++iter_counter){
@@ -519,9 +614,9 @@ FLQuant_base<T> FLQuant_base<T>::propagate_iters(const int iters) const{
     }
     // Make new object and return
     FLQuant_base<T> out = *this;
-    out.data = new_data;
+    out.data = std::move(new_data);
     out.dim[5] = iters;
-    out.dimnames[5] = iter_dimnames;
+    out.dimnames.set_names(5, iter_dimnames);
     return out;
 }
 
@@ -548,13 +643,10 @@ void FLQuant_base<adouble>::fill(const double value){
  * \param indices_max Vector of length 6 determining where to finish inserting.
  */
 template<typename T>
-void FLQuant_base<T>::insert(const FLQuant_base<T> flq, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max){
-    if ((indices_min.size() != 6) | (indices_max.size() != 6)){
-        Rcpp::stop("In neat FLQuant subsetter. Size of indices_min or max not equal to 6\n");
-    }
+void FLQuant_base<T>::insert(const FLQuant_base<T>& flq, const Index6& indices_min, const Index6& indices_max){
     auto dim = get_dim();
     auto flq_dim = flq.get_dim();
-    std::vector<unsigned int> dim_in(6);
+    Index6 dim_in;
     std::transform(indices_max.begin(), indices_max.end(), indices_min.begin(), dim_in.begin(), [] (unsigned int x, unsigned int y) {return x - y + 1;});
     for (int i=0; i<6; ++i){
         if (dim[i] < flq_dim[i]){
@@ -575,6 +667,88 @@ void FLQuant_base<T>::insert(const FLQuant_base<T> flq, const std::vector<unsign
     }}}}}}
 }
 
+/*! \brief Insert a view of an FLQuant into a bigger one
+ *
+ * The quants of each year, unit, season, area and iter are copied as a block.
+ * \param flqv The view to be inserted.
+ * \param indices_min Vector of length 6 determining where to start inserting.
+ * \param indices_max Vector of length 6 determining where to finish inserting.
+ */
+template<typename T>
+void FLQuant_base<T>::insert(const FLQuantView<T>& flqv, const Index6& indices_min, const Index6& indices_max){
+    std::vector<unsigned int> flqv_dim = flqv.get_dim();
+    for (int i=0; i<6; ++i){
+        if ((indices_min[i] < 1) || (indices_max[i] > dim[i])){
+            Rcpp::stop("In FLQuant insert(). Inserted FLQuant is larger than destination FLQuant\n");
+        }
+        if (flqv_dim[i] != (indices_max[i] - indices_min[i] + 1)){
+            Rcpp::stop("In FLQuant insert(). Dim of inserted FLQuant does not match indices_min and indices_max arguments\n");
+        }
+    }
+    for (unsigned int icount=1; icount <= flqv_dim[5]; ++icount){
+        for (unsigned int acount=1; acount <= flqv_dim[4]; ++acount){
+            for (unsigned int scount=1; scount <= flqv_dim[3]; ++scount){
+                for (unsigned int ucount=1; ucount <= flqv_dim[2]; ++ucount){
+                    for (unsigned int ycount=1; ycount <= flqv_dim[1]; ++ycount){
+                        const T* quants = flqv.quant_begin(ycount, ucount, scount, acount, icount);
+                        unsigned int element = get_data_element(indices_min[0], ycount + indices_min[1] - 1, ucount + indices_min[2] - 1, scount + indices_min[3] - 1, acount + indices_min[4] - 1, icount + indices_min[5] - 1);
+                        std::copy(quants, quants + flqv_dim[0], data.begin() + element);
+    }}}}}
+}
+
+/*! \brief Elementwise operation on the data in place
+ *
+ * The data of FLQuant_base<double> use the vectorised kernels in FLQuant_simd.cpp.
+ * If the rhs has 1 iter and the lhs has many, the rhs is applied to each iter of the lhs in turn (iters are the slowest dimension so each is a contiguous block).
+ * \param data The data of the lhs, which is overwritten.
+ * \param rhs The data of the rhs, of the same size, the size of 1 iter of the lhs, or a scalar.
+ * \param func The operation, with the scalar rhs bound.
+ * \param op The same operation for the vectorised kernels.
+ */
+template <typename T, typename T2, typename F>
+void transform_data(FLQuant_data<T>& data, const FLQuant_data<T2>& rhs, F func, const simd_op){
+    if (rhs.empty()){
+        return;
+    }
+    for (auto block = data.begin(); block != data.end(); block += rhs.size()){
+        std::transform(block, block + rhs.size(), rhs.begin(), block, func);
+    }
+}
+
+template <typename F>
+void transform_data(FLQuant_data<double>& data, const FLQuant_data<double>& rhs, F, const simd_op op){
+    if (rhs.empty()){
+        return;
+    }
+    double* lhs_data = data.data();
+    const double* rhs_data = rhs.data();
+    if (rhs.size() == data.size()){
+        FLQuant_parallel_for<double>(data.size(), 1, [&] (std::size_t first, std::size_t last) {
+            simd_binary(op, lhs_data + first, rhs_data + first, lhs_data + first, last - first);
+        });
+        return;
+    }
+    const std::size_t block_size = rhs.size();
+    FLQuant_parallel_for<double>(data.size() / block_size, block_size, [&] (std::size_t first, std::size_t last) {
+        for (std::size_t block = first; block < last; ++block){
+            simd_binary(op, lhs_data + block * block_size, rhs_data, lhs_data + block * block_size, block_size);
+        }
+    });
+}
+
+template <typename T, typename F>
+void transform_data(FLQuant_data<T>& data, const T&, F func, const simd_op){
+    std::transform(data.begin(), data.end(), data.begin(), func);
+}
+
+template <typename F>
+void transform_data(FLQuant_data<double>& data, const double& rhs, F, const simd_op op){
+    double* lhs_data = data.data();
+    FLQuant_parallel_for<double>(data.size(), 1, [&] (std::size_t first, std::size_t last) {
+        simd_binary(op, lhs_data + first, rhs, lhs_data + first, last - first);
+    });
+}
+
 //------------------ Multiplication operators -------------------
 /*  * Need to consider what happens with the combinations FLQuant<T1> * / + - FLQuant<T2>, i.e. what is the output type?
  *  adouble *  double = adouble
@@ -589,16 +763,15 @@ FLQuant_base<T>& FLQuant_base<T>::operator *= (const FLQuant_base<T>& rhs){
     if (dim5_matcher(get_dim(), rhs.get_dim()) != 1){
         Rcpp::stop("You cannot multiply FLQuants as dimensions 1-5 do not match.");
     }
-    FLQuant_base<T> new_rhs = rhs;
-    if (get_niter() > rhs.get_niter()){
-        // Blow up rhs 
-        new_rhs = rhs.propagate_iters(get_niter() - rhs.get_niter() + 1);
+    // An rhs with 1 iter is broadcast over the iters of this, not copied
+    if ((rhs.get_niter() > 1) && (rhs.get_niter() < get_niter())){
+        Rcpp::stop("In FLQuant arithmetic. The rhs must have 1 iter or the same number of iters as the lhs.\n");
     }
     if (rhs.get_niter() > get_niter()){
         // Blow up this
         *this = (*this).propagate_iters(rhs.get_niter() - get_niter() + 1);
     }
-    std::transform((*this).data.begin(), (*this).data.end(), new_rhs.data.begin(), (*this).data.begin(), std::multiplies<T>());
+    transform_data((*this).data, rhs.data, std::multiplies<T>(), simd_multiplies);
     return *this;
 }
 // Special case of multiplication assignment 
@@ -608,27 +781,18 @@ FLQuant_base<T>& FLQuant_base<T>::operator *= (const FLQuant_base<T>& rhs){
 template <typename T>
 template <typename T2>
 FLQuant_base<T>& FLQuant_base<T>::operator *= (const FLQuant_base<T2>& rhs){
-
     if (dim5_matcher(get_dim(), rhs.get_dim()) != 1){
         Rcpp::stop("You cannot multiply FLQuants as dimensions 1-5 do not match.");
     }
-    FLQuant_base<T2> new_rhs = rhs;
-    if (get_niter() > rhs.get_niter()){
-        // Blow up rhs 
-        new_rhs = rhs.propagate_iters(get_niter() - rhs.get_niter() + 1);
+    // An rhs with 1 iter is broadcast over the iters of this, not copied
+    if ((rhs.get_niter() > 1) && (rhs.get_niter() < get_niter())){
+        Rcpp::stop("In FLQuant arithmetic. The rhs must have 1 iter or the same number of iters as the lhs.\n");
     }
     if (rhs.get_niter() > get_niter()){
         // Blow up this
         *this = (*this).propagate_iters(rhs.get_niter() - get_niter() + 1);
     }
-    std::vector<T2> new_rhs_data = new_rhs.get_data();
-
-    std::transform((*this).data.begin(), (*this).data.end(), new_rhs_data.begin(), (*this).data.begin(), std::multiplies<T>());
-
-    //std::vector<T2> rhs_data = rhs.get_data();
-    //for (unsigned int i = 0; i < rhs.get_size(); ++i){
-    //    data[i] = data[i] * rhs_data[i];
-    //}
+    transform_data((*this).data, rhs.get_data(), std::multiplies<T>(), simd_multiplies);
     return *this;
 }
 
@@ -637,7 +801,7 @@ FLQuant_base<T>& FLQuant_base<T>::operator *= (const FLQuant_base<T2>& rhs){
 template <typename T>
 FLQuant_base<T>& FLQuant_base<T>::operator *= (const T& rhs){
     //Rprintf("In scalar T=*T multiplication assignment\n");
-    std::transform((*this).data.begin(), (*this).data.end(), (*this).data.begin(), std::bind1st(std::multiplies<T>(),rhs)); 
+    transform_data((*this).data, rhs, std::bind1st(std::multiplies<T>(),rhs), simd_multiplies);
     return *this;
 }
 
@@ -645,99 +809,13 @@ FLQuant_base<T>& FLQuant_base<T>::operator *= (const T& rhs){
 // Used for FLQuantAdolc / CppAD *= double
 // Needs to be instanitated due to extra template class, T2
 template <typename T>
-template <typename T2>
+template <typename T2, typename>
 FLQuant_base<T>& FLQuant_base<T>::operator *= (const T2& rhs){
     //Rprintf("In scalar T=*T2 multiplication assignment\n");
     std::transform((*this).data.begin(), (*this).data.end(), (*this).data.begin(), std::bind1st(std::multiplies<T>(),rhs)); 
     return *this;
 }
 
-// General multiplication
-// FLQuant_base<T> * FLQuant_base<T>
-template <typename T>
-FLQuant_base<T> FLQuant_base<T>::operator * (const FLQuant_base<T>& rhs) const{
-    //Rprintf("In self multiplication\n");
-    //if (match_dims(rhs) != 1){
-    //    Rcpp::stop("You cannot multiply FLQuants as your dimensions do not match.");
-    //}
-    FLQuant_base<T> out = *this; // Copy myself
-    out *= rhs;
-    return out;
-}
-
-// FLQuant_base<T> * T
-template <typename T>
-FLQuant_base<T> FLQuant_base<T>::operator * (const T& rhs) const{
-    FLQuant_base<T> out = *this; // Copy myself
-    out *= rhs;
-    return out;
-}
-
-// Outside of class
-template <typename T>
-FLQuant_base<T> operator * (const FLQuant_base<double>& lhs, const FLQuant_base<T>& rhs){
-    //Rprintf("FLQuant_base<double> * FLQuant_base<T>\n");
-    //if (lhs.match_dims(rhs) != 1){
-    //    Rcpp::stop("You cannot multiply FLQuants as your dimensions do not match.");
-    //}
-    FLQuant_base<T> out = rhs;
-    out *= lhs;
-    return out;
-
-}
-
-template <typename T>
-FLQuant_base<T> operator * (const FLQuant_base<T>& lhs, const FLQuant_base<double>& rhs){
-    //Rprintf("FLQuant_base<T> * FLQuant_base<double>\n");
-    //if (lhs.match_dims(rhs) != 1){
-    //    Rcpp::stop("You cannot multiply FLQuants as your dimensions do not match.");
-    //}
-    FLQuant_base<T> out = lhs;
-    out *= rhs;
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator * (const T& lhs, const FLQuant_base<T>& rhs){
-    FLQuant_base<T> out = rhs;
-    out *= lhs;
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator * (const double& lhs, const FLQuant_base<T>& rhs){
-    FLQuant_base<T> out = rhs;
-    out *= lhs;
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator * (const FLQuant_base<T>& lhs, const double& rhs){
-    FLQuant_base<T> out = lhs;
-    out *= rhs;
-    return out;
-}
-
-FLQuant_base<double> operator * (const double& lhs, const FLQuant_base<double>& rhs){
-    FLQuant_base<double> out = rhs;
-    out *= lhs;
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator * (const FLQuant_base<double>& lhs, const T& rhs){
-    FLQuant_base<T> out(lhs);
-    out *= rhs;
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator * (const T& lhs, const FLQuant_base<double>& rhs){
-    FLQuant_base<T> out(rhs);
-    out *= lhs;
-    return out;
-}
-
 //------------------ Division operators -------------------
 
 // Division self assignment
@@ -746,16 +824,15 @@ FLQuant_base<T>& FLQuant_base<T>::operator /= (const FLQuant_base<T>& rhs){
     if (dim5_matcher(get_dim(), rhs.get_dim()) != 1){
         Rcpp::stop("You cannot divide FLQuants as dimensions 1-5 do not match.");
     }
-    FLQuant_base<T> new_rhs = rhs;
-    if (get_niter() > rhs.get_niter()){
-        // Blow up rhs 
-        new_rhs = rhs.propagate_iters(get_niter() - rhs.get_niter() + 1);
+    // An rhs with 1 iter is broadcast over the iters of this, not copied
+    if ((rhs.get_niter() > 1) && (rhs.get_niter() < get_niter())){
+        Rcpp::stop("In FLQuant arithmetic. The rhs must have 1 iter or the same number of iters as the lhs.\n");
     }
     if (rhs.get_niter() > get_niter()){
         // Blow up this
         *this = (*this).propagate_iters(rhs.get_niter() - get_niter() + 1);
     }
-    std::transform((*this).data.begin(), (*this).data.end(), new_rhs.data.begin(), (*this).data.begin(), std::divides<T>());
+    transform_data((*this).data, rhs.data, std::divides<T>(), simd_divides);
     return *this;
 }
 // Special case of division assignment 
@@ -766,17 +843,15 @@ FLQuant_base<T>& FLQuant_base<T>::operator /= (const FLQuant_base<T2>& rhs){
     if (dim5_matcher(get_dim(), rhs.get_dim()) != 1){
         Rcpp::stop("You cannot divide FLQuants as dimensions 1-5 do not match.");
     }
-    FLQuant_base<T2> new_rhs = rhs;
-    if (get_niter() > rhs.get_niter()){
-        // Blow up rhs 
-        new_rhs = rhs.propagate_iters(get_niter() - rhs.get_niter() + 1);
+    // An rhs with 1 iter is broadcast over the iters of this, not copied
+    if ((rhs.get_niter() > 1) && (rhs.get_niter() < get_niter())){
+        Rcpp::stop("In FLQuant arithmetic. The rhs must have 1 iter or the same number of iters as the lhs.\n");
     }
     if (rhs.get_niter() > get_niter()){
         // Blow up this
         *this = (*this).propagate_iters(rhs.get_niter() - get_niter() + 1);
     }
-    std::vector<T2> new_rhs_data = new_rhs.get_data();
-    std::transform((*this).data.begin(), (*this).data.end(), new_rhs_data.begin(), (*this).data.begin(), std::divides<T>());
+    transform_data((*this).data, rhs.get_data(), std::divides<T>(), simd_divides);
     return *this;
 }
 
@@ -784,7 +859,7 @@ FLQuant_base<T>& FLQuant_base<T>::operator /= (const FLQuant_base<T2>& rhs){
 // FLQuantAdolc / CppAD /= adouble
 template <typename T>
 FLQuant_base<T>& FLQuant_base<T>::operator /= (const T& rhs){
-    std::transform((*this).data.begin(), (*this).data.end(), (*this).data.begin(), std::bind2nd(std::divides<T>(),rhs)); 
+    transform_data((*this).data, rhs, std::bind2nd(std::divides<T>(),rhs), simd_divides);
     return *this;
 }
 
@@ -792,93 +867,12 @@ FLQuant_base<T>& FLQuant_base<T>::operator /= (const T& rhs){
 // Used for FLQuantAdolc / CppAD /= double
 // Needs to be instanitated due to extra template class, T2
 template <typename T>
-template <typename T2>
+template <typename T2, typename>
 FLQuant_base<T>& FLQuant_base<T>::operator /= (const T2& rhs){
     std::transform((*this).data.begin(), (*this).data.end(), (*this).data.begin(), std::bind2nd(std::divides<T>(),rhs)); 
     return *this;
 }
 
-// General division 
-// FLQuant_base<T> / FLQuant_base<T>
-template <typename T>
-FLQuant_base<T> FLQuant_base<T>::operator / (const FLQuant_base<T>& rhs) const{
-    FLQuant_base<T> out = *this; // Copy myself
-    out /= rhs;
-    return out;
-}
-
-// FLQuant_base<T> / T
-template <typename T>
-FLQuant_base<T> FLQuant_base<T>::operator / (const T& rhs) const{
-    FLQuant_base<T> out = *this; // Copy myself
-    out /= rhs;
-    return out;
-}
-
-// Declared outside of class
-template <typename T>
-FLQuant_base<T> operator / (const FLQuant_base<double>& lhs, const FLQuant_base<T>& rhs){
-    FLQuant_base<T> out(lhs);
-    out /= rhs;
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator / (const FLQuant_base<T>& lhs, const FLQuant_base<double>& rhs){
-    FLQuant_base<T> out = lhs;
-    out /= rhs;
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator / (const T& lhs, const FLQuant_base<T>& rhs){
-    FLQuant_base<T> out = rhs;
-    std::vector<T> out_data = out.get_data();
-    std::transform(out_data.begin(), out_data.end(), out_data.begin(), std::bind1st(std::divides<T>(),lhs)); 
-    out.set_data(out_data);
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator / (const double& lhs, const FLQuant_base<T>& rhs){
-    FLQuant_base<T> out = rhs;
-    std::vector<T> out_data = out.get_data();
-    std::transform(out_data.begin(), out_data.end(), out_data.begin(), std::bind1st(std::divides<T>(),lhs)); 
-    out.set_data(out_data);
-    return out;
-}
-
-FLQuant_base<double> operator / (const double& lhs, const FLQuant_base<double>& rhs){
-    FLQuant_base<double> out = rhs;
-    std::vector<double> out_data = out.get_data();
-    std::transform(out_data.begin(), out_data.end(), out_data.begin(), std::bind1st(std::divides<double>(),lhs)); 
-    out.set_data(out_data);
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator / (const FLQuant_base<T>& lhs, const double& rhs){
-    FLQuant_base<T> out = lhs;
-    out /= rhs;
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator / (const FLQuant_base<double>& lhs, const T& rhs){
-    FLQuant_base<T> out(lhs);
-    out /= rhs;
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator / (const T& lhs, const FLQuant_base<double>& rhs){
-    FLQuant_base<T> out(rhs);
-    std::vector<T> out_data = out.get_data();
-    std::transform(out_data.begin(), out_data.end(), out_data.begin(), std::bind1st(std::divides<T>(),lhs)); 
-    out.set_data(out_data);
-    return out;
-}
-
 //------------------ Subtraction operators -------------------
 
 // Subtraction self assignment
@@ -887,16 +881,15 @@ FLQuant_base<T>& FLQuant_base<T>::operator -= (const FLQuant_base<T>& rhs){
     if (dim5_matcher(get_dim(), rhs.get_dim()) != 1){
         Rcpp::stop("You cannot subtract FLQuants as dimensions 1-5 do not match.");
     }
-    FLQuant_base<T> new_rhs = rhs;
-    if (get_niter() > rhs.get_niter()){
-        // Blow up rhs 
-        new_rhs = rhs.propagate_iters(get_niter() - rhs.get_niter() + 1);
+    // An rhs with 1 iter is broadcast over the iters of this, not copied
+    if ((rhs.get_niter() > 1) && (rhs.get_niter() < get_niter())){
+        Rcpp::stop("In FLQuant arithmetic. The rhs must have 1 iter or the same number of iters as the lhs.\n");
     }
     if (rhs.get_niter() > get_niter()){
         // Blow up this
         *this = (*this).propagate_iters(rhs.get_niter() - get_niter() + 1);
     }
-    std::transform((*this).data.begin(), (*this).data.end(), new_rhs.data.begin(), (*this).data.begin(), std::minus<T>());
+    transform_data((*this).data, rhs.data, std::minus<T>(), simd_minus);
     return *this;
 }
 // Special case of subtraction assignment 
@@ -907,17 +900,15 @@ FLQuant_base<T>& FLQuant_base<T>::operator -= (const FLQuant_base<T2>& rhs){
     if (dim5_matcher(get_dim(), rhs.get_dim()) != 1){
         Rcpp::stop("You cannot subtract FLQuants as dimensions 1-5 do not match.");
     }
-    FLQuant_base<T2> new_rhs = rhs;
-    if (get_niter() > rhs.get_niter()){
-        // Blow up rhs 
-        new_rhs = rhs.propagate_iters(get_niter() - rhs.get_niter() + 1);
+    // An rhs with 1 iter is broadcast over the iters of this, not copied
+    if ((rhs.get_niter() > 1) && (rhs.get_niter() < get_niter())){
+        Rcpp::stop("In FLQuant arithmetic. The rhs must have 1 iter or the same number of iters as the lhs.\n");
     }
     if (rhs.get_niter() > get_niter()){
         // Blow up this
         *this = (*this).propagate_iters(rhs.get_niter() - get_niter() + 1);
     }
-    std::vector<T2> new_rhs_data = new_rhs.get_data();
-    std::transform((*this).data.begin(), (*this).data.end(), new_rhs_data.begin(), (*this).data.begin(), std::minus<T>());
+    transform_data((*this).data, rhs.get_data(), std::minus<T>(), simd_minus);
     return *this;
 }
 
@@ -925,7 +916,7 @@ FLQuant_base<T>& FLQuant_base<T>::operator -= (const FLQuant_base<T2>& rhs){
 // FLQuantAdolc / CppAD -= adouble
 template <typename T>
 FLQuant_base<T>& FLQuant_base<T>::operator -= (const T& rhs){
-    std::transform((*this).data.begin(), (*this).data.end(), (*this).data.begin(), std::bind2nd(std::minus<T>(),rhs)); 
+    transform_data((*this).data, rhs, std::bind2nd(std::minus<T>(),rhs), simd_minus);
     return *this;
 }
 
@@ -933,93 +924,12 @@ FLQuant_base<T>& FLQuant_base<T>::operator -= (const T& rhs){
 // Used for FLQuantAdolc / CppAD -= double
 // Needs to be instanitated due to extra template class, T2
 template <typename T>
-template <typename T2>
+template <typename T2, typename>
 FLQuant_base<T>& FLQuant_base<T>::operator -= (const T2& rhs){
     std::transform((*this).data.begin(), (*this).data.end(), (*this).data.begin(), std::bind2nd(std::minus<T>(),rhs)); 
     return *this;
 }
 
-// General 
-// FLQuant_base<T> - FLQuant_base<T>
-template <typename T>
-FLQuant_base<T> FLQuant_base<T>::operator - (const FLQuant_base<T>& rhs) const{
-    FLQuant_base<T> out = *this; // Copy myself
-    out -= rhs;
-    return out;
-}
-
-// FLQuant_base<T> - T
-template <typename T>
-FLQuant_base<T> FLQuant_base<T>::operator - (const T& rhs) const{
-    FLQuant_base<T> out = *this; // Copy myself
-    out -= rhs;
-    return out;
-}
-
-// Declared outside of class
-template <typename T>
-FLQuant_base<T> operator - (const FLQuant_base<double>& lhs, const FLQuant_base<T>& rhs){
-    FLQuant_base<T> out(lhs);
-    out -= rhs;
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator - (const FLQuant_base<T>& lhs, const FLQuant_base<double>& rhs){
-    FLQuant_base<T> out = lhs;
-    out -= rhs;
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator - (const T& lhs, const FLQuant_base<T>& rhs){
-    FLQuant_base<T> out = rhs;
-    std::vector<T> out_data = out.get_data();
-    std::transform(out_data.begin(), out_data.end(), out_data.begin(), std::bind1st(std::minus<T>(),lhs)); 
-    out.set_data(out_data);
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator - (const double& lhs, const FLQuant_base<T>& rhs){
-    FLQuant_base<T> out = rhs;
-    std::vector<T> out_data = out.get_data();
-    std::transform(out_data.begin(), out_data.end(), out_data.begin(), std::bind1st(std::minus<T>(),lhs)); 
-    out.set_data(out_data);
-    return out;
-}
-
-FLQuant_base<double> operator - (const double& lhs, const FLQuant_base<double>& rhs){
-    FLQuant_base<double> out = rhs;
-    std::vector<double> out_data = out.get_data();
-    std::transform(out_data.begin(), out_data.end(), out_data.begin(), std::bind1st(std::minus<double>(),lhs)); 
-    out.set_data(out_data);
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator - (const FLQuant_base<T>& lhs, const double& rhs){
-    FLQuant_base<T> out = lhs;
-    out -= rhs;
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator - (const FLQuant_base<double>& lhs, const T& rhs){
-    FLQuant_base<T> out(lhs);
-    out -= rhs;
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator - (const T& lhs, const FLQuant_base<double>& rhs){
-    FLQuant_base<T> out(rhs);
-    std::vector<T> out_data = out.get_data();
-    std::transform(out_data.begin(), out_data.end(), out_data.begin(), std::bind1st(std::minus<T>(),lhs)); 
-    out.set_data(out_data);
-    return out;
-}
-
 //------------------ Addition operators -------------------
 
 // Addition self assignment
@@ -1028,16 +938,15 @@ FLQuant_base<T>& FLQuant_base<T>::operator += (const FLQuant_base<T>& rhs){
     if (dim5_matcher(get_dim(), rhs.get_dim()) != 1){
         Rcpp::stop("You cannot add FLQuants as dimensions 1-5 do not match.");
     }
-    FLQuant_base<T> new_rhs = rhs;
-    if (get_niter() > rhs.get_niter()){
-        // Blow up rhs 
-        new_rhs = rhs.propagate_iters(get_niter() - rhs.get_niter() + 1);
+    // An rhs with 1 iter is broadcast over the iters of this, not copied
+    if ((rhs.get_niter() > 1) && (rhs.get_niter() < get_niter())){
+        Rcpp::stop("In FLQuant arithmetic. The rhs must have 1 iter or the same number of iters as the lhs.\n");
     }
     if (rhs.get_niter() > get_niter()){
         // Blow up this
         *this = (*this).propagate_iters(rhs.get_niter() - get_niter() + 1);
     }
-    std::transform((*this).data.begin(), (*this).data.end(), new_rhs.data.begin(), (*this).data.begin(), std::plus<T>());
+    transform_data((*this).data, rhs.data, std::plus<T>(), simd_plus);
     return *this;
 }
 // Special case of addition assignment 
@@ -1050,17 +959,15 @@ FLQuant_base<T>& FLQuant_base<T>::operator += (const FLQuant_base<T2>& rhs){
     if (dim5_matcher(get_dim(), rhs.get_dim()) != 1){
         Rcpp::stop("You cannot add FLQuants as dimensions 1-5 do not match.");
     }
-    FLQuant_base<T2> new_rhs = rhs;
-    if (get_niter() > rhs.get_niter()){
-        // Blow up rhs 
-        new_rhs = rhs.propagate_iters(get_niter() - rhs.get_niter() + 1);
+    // An rhs with 1 iter is broadcast over the iters of this, not copied
+    if ((rhs.get_niter() > 1) && (rhs.get_niter() < get_niter())){
+        Rcpp::stop("In FLQuant arithmetic. The rhs must have 1 iter or the same number of iters as the lhs.\n");
     }
     if (rhs.get_niter() > get_niter()){
         // Blow up this
         *this = (*this).propagate_iters(rhs.get_niter() - get_niter() + 1);
     }
-    std::vector<T2> new_rhs_data = new_rhs.get_data();
-    std::transform((*this).data.begin(), (*this).data.end(), new_rhs_data.begin(), (*this).data.begin(), std::plus<T>());
+    transform_data((*this).data, rhs.get_data(), std::plus<T>(), simd_plus);
     return *this;
 }
 
@@ -1068,7 +975,7 @@ FLQuant_base<T>& FLQuant_base<T>::operator += (const FLQuant_base<T2>& rhs){
 // FLQuantAdolc / CppAD += adouble
 template <typename T>
 FLQuant_base<T>& FLQuant_base<T>::operator += (const T& rhs){
-    std::transform((*this).data.begin(), (*this).data.end(), (*this).data.begin(), std::bind1st(std::plus<T>(),rhs)); 
+    transform_data((*this).data, rhs, std::bind1st(std::plus<T>(),rhs), simd_plus);
     return *this;
 }
 
@@ -1076,86 +983,12 @@ FLQuant_base<T>& FLQuant_base<T>::operator += (const T& rhs){
 // Used for FLQuantAdolc / CppAD += double
 // Needs to be instanitated due to extra template class, T2
 template <typename T>
-template <typename T2>
+template <typename T2, typename>
 FLQuant_base<T>& FLQuant_base<T>::operator += (const T2& rhs){
     std::transform((*this).data.begin(), (*this).data.end(), (*this).data.begin(), std::bind1st(std::plus<T>(),rhs)); 
     return *this;
 }
 
-// General multiplication
-// FLQuant_base<T> + FLQuant_base<T>
-template <typename T>
-FLQuant_base<T> FLQuant_base<T>::operator + (const FLQuant_base<T>& rhs) const{
-    FLQuant_base<T> out = *this; // Copy myself
-    out += rhs;
-    return out;
-}
-
-// FLQuant_base<T> + T
-template <typename T>
-FLQuant_base<T> FLQuant_base<T>::operator + (const T& rhs) const{
-    FLQuant_base<T> out = *this; // Copy myself
-    out += rhs;
-    return out;
-}
-
-// Declared outside of class
-template <typename T>
-FLQuant_base<T> operator + (const FLQuant_base<double>& lhs, const FLQuant_base<T>& rhs){
-    FLQuant_base<T> out = rhs;
-    out += lhs;
-    return out;
-
-}
-
-template <typename T>
-FLQuant_base<T> operator + (const FLQuant_base<T>& lhs, const FLQuant_base<double>& rhs){
-    FLQuant_base<T> out = lhs;
-    out += rhs;
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator + (const T& lhs, const FLQuant_base<T>& rhs){
-    FLQuant_base<T> out = rhs;
-    out += lhs;
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator + (const double& lhs, const FLQuant_base<T>& rhs){
-    FLQuant_base<T> out = rhs;
-    out += lhs;
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator + (const FLQuant_base<T>& lhs, const double& rhs){
-    FLQuant_base<T> out = lhs;
-    out += rhs;
-    return out;
-}
-
-FLQuant_base<double> operator + (const double& lhs, const FLQuant_base<double>& rhs){
-    FLQuant_base<double> out = rhs;
-    out += lhs;
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator + (const FLQuant_base<double>& lhs, const T& rhs){
-    FLQuant_base<T> out(lhs);
-    out += rhs;
-    return out;
-}
-
-template <typename T>
-FLQuant_base<T> operator + (const T& lhs, const FLQuant_base<double>& rhs){
-    FLQuant_base<T> out(rhs);
-    out += lhs;
-    return out;
-}
-
 /* Other methods */
 template <typename T>
 int FLQuant_base<T>::match_dims(const FLQuant_base<T>& b) const{
@@ -1176,34 +1009,8 @@ int FLQuant_base<T>::match_dims(const FLQuant_base<T2>& b) const{
     return dim_matcher(dims_a, dims_b);
 }
 
-/* Other functions */
-//FLQuant_base<T> log(const FLQuant_base<T>& flq);
-//FLQuant_base<T> exp(const FLQuant_base<T>& flq);
-
-template <typename T>
-FLQuant_base<T> log(const FLQuant_base<T>& flq){
-    FLQuant_base<T> flq_out = flq;
-    std::vector<T> data = flq_out.get_data();
-    for (typename std::vector<T>::iterator data_iterator = data.begin(); data_iterator != data.end(); ++data_iterator){
-        (*data_iterator) = log(*data_iterator);
-    }
-    flq_out.set_data(data);
-    return flq_out;
-}
-
-template <typename T>
-FLQuant_base<T> exp(const FLQuant_base<T>& flq){
-    FLQuant_base<T> flq_out = flq;
-    std::vector<T> data = flq_out.get_data();
-    for (typename std::vector<T>::iterator data_iterator = data.begin(); data_iterator != data.end(); ++data_iterator){
-        (*data_iterator) = exp(*data_iterator);
-    }
-    flq_out.set_data(data);
-    return flq_out;
-}
-
 //int dim_matcher(const Rcpp::IntegerVector dims_a, const Rcpp::IntegerVector dims_b){
-int dim_matcher(const std::vector<unsigned int> dims_a, const std::vector<unsigned int> dims_b){
+int dim_matcher(const std::vector<unsigned int>& dims_a, const std::vector<unsigned int>& dims_b){
     for (int i=0; i<6; ++i){
         if (dims_a[i] != dims_b[i]){
             return -1 * (i+1); // Return negative of what dim does not match
@@ -1214,7 +1021,7 @@ int dim_matcher(const std::vector<unsigned int> dims_a, const std::vector<unsign
 
 // Only checks dim 1 - 5 - not iter
 //int dim5_matcher(const Rcpp::IntegerVector dims_a, const Rcpp::IntegerVector dims_b){
-int dim5_matcher(const std::vector<unsigned int> dims_a, const std::vector<unsigned int> dims_b){
+int dim5_matcher(const std::vector<unsigned int>& dims_a, const std::vector<unsigned int>& dims_b){
     for (int i=0; i<5; ++i){
         if (dims_a[i] != dims_b[i]){
             return -1 * (i+1); // Return negative of what dim does not match
@@ -1223,31 +1030,55 @@ int dim5_matcher(const std::vector<unsigned int> dims_a, const std::vector<unsig
     return 1; // Else all is good
 }
 
-/*------------- pow method ----------------*/
-template <typename T>
-FLQuant_base<T> pow(const FLQuant_base<T>& flq, const T power){
-    FLQuant_base<T> out(flq);
-    std::transform(flq.begin(), flq.end(), out.begin(),
-            [power](T x) {return pow(x, power);});
-    return  out;
-}
-
-FLQuant_base<adouble> pow(const FLQuant_base<adouble>& flq, const double power){
-    FLQuant_base<adouble> out(flq);
-    std::transform(flq.begin(), flq.end(), out.begin(),
-            [power](adouble x) {return pow(x, power);});
-    return  out;
-}
+/*------------- Sweep methods ----------------*/
 
-FLQuant_base<adouble> pow(const FLQuant_base<double>& flq, const adouble power){
-    FLQuant_base<adouble> out(flq);
-    std::transform(flq.begin(), flq.end(), out.begin(),
-            [power](double x) {return pow(x, power);});
-    return  out;
+/*! \brief Work out the shape of a sweep over 2 FLQuants
+ *
+ * The dims of the 2 FLQuants must be 1 or n (n can be different for each dim).
+ * \param dim1 The dims of the first FLQuant.
+ * \param dim2 The dims of the second FLQuant.
+ */
+FLQuant_broadcast::FLQuant_broadcast(const std::vector<unsigned int>& dim1, const std::vector<unsigned int>& dim2) : dim_out(6), ndim(0){
+    if ((dim1.size() != 6) | (dim2.size() != 6)){
+        Rcpp::stop("In FLQuant Sweep. dims must be of length 6.\n");
+    }
+    // Go over each dim vector, check if 1 or n, make dim of output Q
+    std::size_t natural_stride1 = 1;
+    std::size_t natural_stride2 = 1;
+    for (unsigned int dim_count = 0; dim_count < 6; ++dim_count){
+        if((dim1[dim_count] == dim2[dim_count]) | (dim1[dim_count] == 1) | (dim2[dim_count] == 1)){
+            dim_out[dim_count] = std::max(dim1[dim_count], dim2[dim_count]);
+        }
+        else {
+            Rcpp::stop("In FLQuant Sweep. Size of each dim must be 1 or n.\n");
+        }
+        // Dimensions of length 1 in the output are skipped
+        if (dim_out[dim_count] != 1){
+            const std::size_t dim_stride1 = (dim1[dim_count] == 1) ? 0 : natural_stride1;
+            const std::size_t dim_stride2 = (dim2[dim_count] == 1) ? 0 : natural_stride2;
+            // Collapse into the previous dimension if contiguous with it in both FLQuants
+            if ((ndim > 0) && (dim_stride1 == stride1[ndim-1] * extent[ndim-1]) && (dim_stride2 == stride2[ndim-1] * extent[ndim-1])){
+                extent[ndim-1] *= dim_out[dim_count];
+            }
+            else {
+                extent[ndim] = dim_out[dim_count];
+                stride1[ndim] = dim_stride1;
+                stride2[ndim] = dim_stride2;
+                ++ndim;
+            }
+        }
+        natural_stride1 *= dim1[dim_count];
+        natural_stride2 *= dim2[dim_count];
+    }
+    // A single element
+    if (ndim == 0){
+        extent[0] = 1;
+        stride1[0] = 0;
+        stride2[0] = 0;
+        ndim = 1;
+    }
 }
 
-/*------------- Sweep methods ----------------*/
-
 /*! \brief Performs a binary function operation on 2 FLQuants of possibly different size
  *
  * The dims of the 2 FLQuant objects must be 1 or n (n can be different for each dim).
@@ -1258,41 +1089,61 @@ FLQuant_base<adouble> pow(const FLQuant_base<double>& flq, const adouble power){
  * It's similar to using the %*%, %+% etc. operators in FLR (which is like sweep). 
  * The type of the output FLQuant depends on the types of the input FLQuants.
  * adoubles propagate. For example, AD * D = D.
+ * The strides are worked out once (see FLQuant_broadcast) and the innermost collapsed dimension is a flat loop.
  * \param flq1 FLQuant of type double or adouble
  * \param flq2 FLQuant of type double or adouble
  */
 template <typename T1, typename T2, typename T3>
 FLQuant_base<typename T1::result_type> sweep_flq(const FLQuant_base<T2>& flq1, const FLQuant_base<T3>& flq2, T1 func){
-    auto dim1 = flq1.get_dim();
-    auto dim2 = flq2.get_dim();
-    std::vector<unsigned int> dim_out(6);
-    // Go over each dim vector, check if 1 or n, make dim of output Q
-    for (int i = 0; i <= 5; ++i){
-        if((dim1[i] == dim2[i]) | (dim1[i] == 1) | (dim2[i] == 1)){
-            dim_out[i] = std::max(dim1[i], dim2[i]);
+    const FLQuant_broadcast shape(flq1.get_dim(), flq2.get_dim());
+    // Make the return FLQ of type that is output from the operator
+    FLQuant_base<typename T1::result_type> out(shape.dim_out);
+    const std::size_t size = out.get_size();
+    if (size == 0){
+        return out;
+    }
+    const T2* data1 = flq1.get_data().data();
+    const T3* data2 = flq2.get_data().data();
+    typename FLQuant_base<typename T1::result_type>::iterator out_first = out.begin();
+    // Flat loop over the innermost dimension, odometer over the others
+    const unsigned int inner_extent = shape.extent[0];
+    const std::size_t inner_stride1 = shape.stride1[0];
+    const std::size_t inner_stride2 = shape.stride2[0];
+    // Only shared out if all of the FLQuants are double
+    typedef typename std::conditional<std::is_same<T2, double>::value && std::is_same<T3, double>::value, typename T1::result_type, adouble>::type thread_type;
+    FLQuant_parallel_for<thread_type>(size / inner_extent, inner_extent, [&] (std::size_t first, std::size_t last) {
+        // Start the odometer at the first run
+        std::array<unsigned int, 6> counter;
+        counter.fill(0);
+        std::size_t offset1 = 0;
+        std::size_t offset2 = 0;
+        std::size_t remainder = first;
+        for (unsigned int dim_count = 1; dim_count < shape.ndim; ++dim_count){
+            counter[dim_count] = remainder % shape.extent[dim_count];
+            remainder /= shape.extent[dim_count];
+            offset1 += counter[dim_count] * shape.stride1[dim_count];
+            offset2 += counter[dim_count] * shape.stride2[dim_count];
         }
-        else {
-            Rcpp::stop("In FLQuant Sweep. Size of each dim must be 1 or n.\n");
+        typename FLQuant_base<typename T1::result_type>::iterator out_iterator = out_first + first * inner_extent;
+        for (std::size_t outer_count = first; outer_count < last; ++outer_count){
+            const T2* x = data1 + offset1;
+            const T3* y = data2 + offset2;
+            for (unsigned int inner_count = 0; inner_count < inner_extent; ++inner_count){
+                *out_iterator = func(x[inner_count * inner_stride1], y[inner_count * inner_stride2]);
+                ++out_iterator;
+            }
+            for (unsigned int dim_count = 1; dim_count < shape.ndim; ++dim_count){
+                offset1 += shape.stride1[dim_count];
+                offset2 += shape.stride2[dim_count];
+                if (++counter[dim_count] < shape.extent[dim_count]){
+                    break;
+                }
+                offset1 -= shape.stride1[dim_count] * shape.extent[dim_count];
+                offset2 -= shape.stride2[dim_count] * shape.extent[dim_count];
+                counter[dim_count] = 0;
+            }
         }
-    }
-    // Make the return FLQ of type that is output from the operator
-    FLQuant_base<typename T1::result_type> out(dim_out);
-    // Need to do this element by element - nasty
-    for (unsigned int qcount=1; qcount <= dim_out[0]; ++qcount){
-        for (unsigned int ycount=1; ycount <= dim_out[1]; ++ycount){
-            for (unsigned int ucount=1; ucount <= dim_out[2]; ++ucount){
-                for (unsigned int scount=1; scount <= dim_out[3]; ++scount){
-                    for (unsigned int acount=1; acount <= dim_out[4]; ++acount){
-                        for (unsigned int icount=1; icount <= dim_out[5]; ++icount){
-                            // Apply the func
-                            out(qcount, ycount, ucount, scount, acount, icount) = func(
-                                flq1(std::min(qcount, dim1[0]), std::min(ycount, dim1[1]),
-                                        std::min(ucount, dim1[2]), std::min(scount, dim1[3]),
-                                        std::min(acount, dim1[4]), std::min(icount, dim1[5])),
-                                flq2(std::min(qcount, dim2[0]), std::min(ycount, dim2[1]),
-                                        std::min(ucount, dim2[2]), std::min(scount, dim2[3]),
-                                        std::min(acount, dim2[4]), std::min(icount, dim2[5])));
-    }}}}}}
+    });
     return out;
 }
 
@@ -1354,93 +1205,116 @@ FLQuant_base<adouble> sweep_minus(const FLQuant_base<double>& flq1, const FLQuan
 }
 
 /*------------- Shortcut methods ----------------*/
+
+/*! \brief Sum over one dimension of the data of an FLQuant
+ *
+ * The data is quant fastest so the dimensions before dim_no form contiguous runs and those after it form blocks.
+ * Summing over the quant dimension adds up each contiguous run.
+ * Summing over a later dimension adds whole runs together, element by element.
+ * Each element is summed in the same order as the old element by element loops so the results, and the CppAD tapes, are unchanged.
+ * \param data The data of the FLQuant.
+ * \param dim The dims of the FLQuant.
+ * \param dim_no The dimension to sum over (starting at 0).
+ * \param out The start of the data of the output FLQuant, with length 1 in dim_no.
+ */
+template <typename T>
+void sum_dim(const typename FLQuant_base<T>::data_type& data, const std::vector<unsigned int>& dim, const unsigned int dim_no, typename FLQuant_base<T>::iterator out){
+    std::size_t inner = 1;
+    for (unsigned int dim_count = 0; dim_count < dim_no; ++dim_count){
+        inner *= dim[dim_count];
+    }
+    const std::size_t n = dim[dim_no];
+    const std::size_t outer = (n * inner == 0) ? 0 : data.size() / (n * inner);
+    std::fill(out, out + outer * inner, T(0.0));
+    // Blocks are summed independently so they can be shared out
+    FLQuant_parallel_for<T>(outer, n * inner, [&] (std::size_t first, std::size_t last) {
+        for (std::size_t outer_count = first; outer_count < last; ++outer_count){
+            const T* block = data.data() + outer_count * n * inner;
+            typename FLQuant_base<T>::iterator out_block = out + outer_count * inner;
+            if (inner == 1){
+                T sum = 0.0;
+                for (std::size_t count = 0; count < n; ++count){
+                    sum += block[count];
+                }
+                *out_block = sum;
+            }
+            else {
+                for (std::size_t count = 0; count < n; ++count){
+                    const T* run = block + count * inner;
+                    for (std::size_t inner_count = 0; inner_count < inner; ++inner_count){
+                        out_block[inner_count] += run[inner_count];
+                    }
+                }
+            }
+        }
+    });
+}
+
+/*! \brief The maximum of a contiguous run of values
+ *
+ * The doubles are compared in order.
+ * The adoubles are compared as a balanced tree of CondExpGe() so the depth of the tape is log2(n) rather than n.
+ * As with the old loop, if two values are equal the first one is kept.
+ * \param x The first value.
+ * \param n The number of values (at least 1).
+ */
+double max_run(const double* x, const std::size_t n){
+    double max = x[0];
+    for (std::size_t count = 1; count < n; ++count){
+        max = (max >= x[count]) ? max : x[count];
+    }
+    return max;
+}
+
+adouble max_run(const adouble* x, const std::size_t n){
+    if (n == 1){
+        return x[0];
+    }
+    const std::size_t half = n / 2;
+    const adouble max_left = max_run(x, half);
+    const adouble max_right = max_run(x + half, n - half);
+    return CppAD::CondExpGe(max_left, max_right, max_left, max_right);
+}
+
 template <typename T>
 FLQuant_base<T> year_sum(const FLQuant_base<T>& flq){
-    //Rcpp::IntegerVector dim = flq.get_dim();
-    std::vector<unsigned int> dim = flq.get_dim();
+    const std::vector<unsigned int>& dim = flq.get_dim();
     // Need to make an empty FLQ with the right dim
     FLQuant_base<T> sum_flq(dim[0], 1, dim[2], dim[3], dim[4], dim[5]);
-    Rcpp::List dimnames = flq.get_dimnames();
-    dimnames["year"] = Rcpp::CharacterVector::create("1");
+    FLQuant_dimnames dimnames = flq.get_dimnames();
+    dimnames.set_names(1, summary_names(1));
     // Set dimnames
     sum_flq.set_dimnames(dimnames);
-    // Old school summing - looks ugly
-    T sum = 0;
-    for (unsigned int iters=1; iters <= flq.get_niter(); ++iters){
-        for (unsigned int areas=1; areas <= flq.get_narea(); ++areas){
-            for (unsigned int seasons=1; seasons <= flq.get_nseason(); ++seasons){
-                for (unsigned int units=1; units <= flq.get_nunit(); ++units){
-                    for (unsigned int quants=1; quants <= flq.get_nquant(); ++quants){
-                        sum = 0;
-                        for (unsigned int years=1; years <= flq.get_nyear(); ++years){
-                            sum += flq(quants, years, units, seasons, areas, iters);
-                        }
-                        sum_flq(quants, 1, units, seasons, areas, iters) = sum;
-    }}}}}
+    sum_dim<T>(flq.get_data(), dim, 1, sum_flq.begin());
     return sum_flq;
 }
 
 template <typename T>
 FLQuant_base<T> quant_sum(const FLQuant_base<T>& flq){
-    //Rcpp::IntegerVector dim = flq.get_dim();
-    std::vector<unsigned int> dim = flq.get_dim();
+    const std::vector<unsigned int>& dim = flq.get_dim();
     // Make an empty FLQ with the right dim
     FLQuant_base<T> sum_flq(1, dim[1], dim[2], dim[3], dim[4], dim[5]);
     //// Set dimnames and units
-    Rcpp::List dimnames = flq.get_dimnames();
-    dimnames[0] = Rcpp::CharacterVector::create("all");
+    FLQuant_dimnames dimnames = flq.get_dimnames();
+    dimnames.set_names(0, summary_names(0));
     sum_flq.set_dimnames(dimnames);
     sum_flq.set_units(flq.get_units());
-    // Old school summing - looks ugly
     // Cannot use accumulate() as not defined for adouble
-    T sum = 0;
-    for (unsigned int iters=1; iters <= flq.get_niter(); ++iters){
-        for (unsigned int areas=1; areas <= flq.get_narea(); ++areas){
-            for (unsigned int seasons=1; seasons <= flq.get_nseason(); ++seasons){
-                for (unsigned int units=1; units <= flq.get_nunit(); ++units){
-                    for (unsigned int years=1; years <= flq.get_nyear(); ++years){
-                        sum = 0;
-                        for (unsigned int quants=1; quants <= flq.get_nquant(); ++quants){
-                            sum += flq(quants, years, units, seasons, areas, iters);
-                        }
-                        sum_flq(1, years, units, seasons, areas, iters) = sum;
-    }}}}}
-    // This also works - not so nested but maybe harder to decipher
-    //int nquant = flq.get_nquant();
-    //for (int chunk_counter=1; chunk_counter <= (flq.get_size()) / nquant; ++chunk_counter){
-    //    T sum = 0;
-    //    for (int quant_counter = (chunk_counter * nquant - nquant + 1); quant_counter <= (chunk_counter * nquant); ++quant_counter){
-    //        sum = sum + flq(quant_counter);
-    //    }
-    //    sum_flq(chunk_counter) = sum;
-    //}
+    sum_dim<T>(flq.get_data(), dim, 0, sum_flq.begin());
     return sum_flq;
 }
 
 template <typename T>
 FLQuant_base<T> unit_sum(const FLQuant_base<T>& flq){
-    std::vector<unsigned int> dim = flq.get_dim();
+    const std::vector<unsigned int>& dim = flq.get_dim();
     // Make an empty FLQ with the right dim
     FLQuant_base<T> sum_flq(dim[0], dim[1], 1, dim[3], dim[4], dim[5]);
     //// Set dimnames and units
-    Rcpp::List dimnames = flq.get_dimnames();
-    dimnames["unit"] = Rcpp::CharacterVector::create("unique");
+    FLQuant_dimnames dimnames = flq.get_dimnames();
+    dimnames.set_names(2, summary_names(2));
     sum_flq.set_dimnames(dimnames);
     sum_flq.set_units(flq.get_units());
-    // Old school summing - looks ugly
-    // Cannot use accumulate() as not defined for adouble
-    T sum = 0;
-    for (unsigned int iters=1; iters <= flq.get_niter(); ++iters){
-        for (unsigned int areas=1; areas <= flq.get_narea(); ++areas){
-            for (unsigned int seasons=1; seasons <= flq.get_nseason(); ++seasons){
-                for (unsigned int years=1; years <= flq.get_nyear(); ++years){
-                    for (unsigned int quants=1; quants <= flq.get_nquant(); ++quants){
-                        sum = 0;
-                        for (unsigned int units=1; units <= flq.get_nunit(); ++units){
-                            sum += flq(quants, years, units, seasons, areas, iters);
-                        }
-                        sum_flq(quants, years, 1, seasons, areas, iters) = sum;
-    }}}}}
+    sum_dim<T>(flq.get_data(), dim, 2, sum_flq.begin());
     return sum_flq;
 }
 
@@ -1448,13 +1322,10 @@ template <typename T>
 FLQuant_base<T> quant_mean(const FLQuant_base<T>& flq){
     FLQuant_base<T> flq_mean = quant_sum(flq);
     // Divide by dim
-    for (unsigned int iters=1; iters <= flq.get_niter(); ++iters){
-        for (unsigned int areas=1; areas <= flq.get_narea(); ++areas){
-            for (unsigned int seasons=1; seasons <= flq.get_nseason(); ++seasons){
-                for (unsigned int units=1; units <= flq.get_nunit(); ++units){
-                    for (unsigned int years=1; years <= flq.get_nyear(); ++years){
-                        flq_mean(1, years, units, seasons, areas, iters) = flq_mean(1, years, units, seasons, areas, iters) / flq.get_nquant();
-    }}}}}
+    const double nquant = flq.get_nquant();
+    for (auto& mean : flq_mean){
+        mean = mean / nquant;
+    }
     return flq_mean;
 }
 
@@ -1462,47 +1333,34 @@ template <typename T>
 FLQuant_base<T> year_mean(const FLQuant_base<T>& flq){
     FLQuant_base<T> flq_mean = year_sum(flq);
     // Divide by dim
-    for (unsigned int iters=1; iters <= flq.get_niter(); ++iters){
-        for (unsigned int areas=1; areas <= flq.get_narea(); ++areas){
-            for (unsigned int seasons=1; seasons <= flq.get_nseason(); ++seasons){
-                for (unsigned int units=1; units <= flq.get_nunit(); ++units){
-                    for (unsigned int quants=1; quants <= flq.get_nquant(); ++quants){
-                        flq_mean(quants, 1, units, seasons, areas, iters) = flq_mean(quants, 1, units, seasons, areas, iters) / flq.get_nyear();
-    }}}}}
+    const double nyear = flq.get_nyear();
+    for (auto& mean : flq_mean){
+        mean = mean / nyear;
+    }
     return flq_mean;
 }
 
-
 // max_quant - returns an FLQuant with size 1 in first dimension containing the maximum value of the quant dimension
-// Would like to be able to use template functions max and max_element
-// But we have to be careful when using conditionals and Adolc / CppAD adouble
-// So we do it using the fmax() function from Adolc
-// Might be possible to use template functions if we moved to CppAD
+// We have to be careful when using conditionals and CppAD adouble so CondExpGe is used (see max_run())
 template <typename T>
 FLQuant_base<T> max_quant(const FLQuant_base<T>& flq){
-    //Rcpp::IntegerVector dim = flq.get_dim();
-    std::vector<unsigned int> dim = flq.get_dim();
+    const std::vector<unsigned int>& dim = flq.get_dim();
     // Make an empty FLQ with the right dim
     FLQuant_base<T> max_flq(1, dim[1], dim[2], dim[3], dim[4], dim[5]);
     // Set dimnames and units
-    Rcpp::List dimnames = flq.get_dimnames();
-    dimnames[0] = Rcpp::CharacterVector::create("all");
+    FLQuant_dimnames dimnames = flq.get_dimnames();
+    dimnames.set_names(0, summary_names(0));
     max_flq.set_dimnames(dimnames);
     max_flq.set_units(flq.get_units());
-    // Old school summing - looks ugly
-    T max = 0;
-    for (unsigned int iters=1; iters <= flq.get_niter(); ++iters){
-        for (unsigned int areas=1; areas <= flq.get_narea(); ++areas){
-            for (unsigned int seasons=1; seasons <= flq.get_nseason(); ++seasons){
-                for (unsigned int units=1; units <= flq.get_nunit(); ++units){
-                    for (unsigned int years=1; years <= flq.get_nyear(); ++years){
-                        max = flq(1, years, units, seasons, areas, iters);
-                        for (unsigned int quants=1; quants <= flq.get_nquant(); ++quants){
-                            //max = fmax(max, flq(quants, years, units, seasons, areas, iters));
-                            max = CppAD::CondExpGe(max,flq(quants, years, units, seasons, areas, iters),max, flq(quants, years, units, seasons, areas, iters));
-                        }
-                        max_flq(1, years, units, seasons, areas, iters) = max;
-    }}}}}
+    const unsigned int nquant = dim[0];
+    if (nquant == 0){
+        return max_flq;
+    }
+    const T* quants = flq.get_data().data();
+    for (auto& max : max_flq){
+        max = max_run(quants, nquant);
+        quants += nquant;
+    }
     return max_flq;
 }
 
@@ -1514,15 +1372,14 @@ FLQuant_base<T> scale_by_max_quant(const FLQuant_base<T>& flq){
     // Copy the original FLQ to get the right dim
     FLQuant_base<T> scaled_flq = flq;
     // max_flq.set_units(flq.get_units()); // units should be set to ""
-    for (unsigned int iters=1; iters <= flq.get_niter(); ++iters){
-        for (unsigned int areas=1; areas <= flq.get_narea(); ++areas){
-            for (unsigned int seasons=1; seasons <= flq.get_nseason(); ++seasons){
-                for (unsigned int units=1; units <= flq.get_nunit(); ++units){
-                    for (unsigned int years=1; years <= flq.get_nyear(); ++years){
-                        for (unsigned int quants=1; quants <= flq.get_nquant(); ++quants){
-                            scaled_flq(quants, years, units, seasons, areas, iters)  = flq(quants, years, units, seasons, areas, iters) / max_quant_flq(1, years, units, seasons, areas, iters);
-                        }
-    }}}}}
+    const unsigned int nquant = flq.get_nquant();
+    typename FLQuant_base<T>::iterator scaled_iterator = scaled_flq.begin();
+    for (const auto& max : max_quant_flq){
+        for (unsigned int quant_count = 0; quant_count < nquant; ++quant_count){
+            *scaled_iterator = *scaled_iterator / max;
+            ++scaled_iterator;
+        }
+    }
     return scaled_flq;
 }
 
@@ -1599,6 +1456,210 @@ void timestep_to_year_season(const unsigned int timestep, const unsigned int nse
     season = (timestep-1) % nseason + 1;
 }
 
+//------------------ FLQuantView ---------------------------------
+
+/*! \brief A view of all of an FLQuant
+ *
+ * \param flq The parent FLQuant.
+ */
+template <typename T>
+FLQuantView<T>::FLQuantView(const FLQuant_base<T>& flq) : FLQuantView<T>(flq, Index6(1, 1, 1, 1, 1, 1), flq.dim) {
+}
+
+/*! \brief A view of a subset of an FLQuant
+ *
+ * Makes the same checks as the FLQuant subsetter.
+ * \param flq The parent FLQuant.
+ * \param indices_min_ip A vector of length 6 with the minimum indices of the 6 dimensions
+ * \param indices_max_ip A vector of length 6 with the maximum indices of the 6 dimensions
+ */
+template <typename T>
+FLQuantView<T>::FLQuantView(const FLQuant_base<T>& flq, const Index6& indices_min_ip, const Index6& indices_max_ip) : parent(&flq) {
+    if (flq.dim.size() != 6){
+        Rcpp::stop("In FLQuant subsetter: FLQuant has no dimensions.\n");
+    }
+    for (int dim_counter = 0; dim_counter < 6; ++dim_counter){
+        if (indices_min_ip[dim_counter] < 1){
+            Rcpp::stop("In FLQuant subsetter: requested min dimensions are less than 1.\n");
+        }
+        if (indices_max_ip[dim_counter] < indices_min_ip[dim_counter]){
+            Rcpp::stop("In FLQuant subsetter: min dim > max\n");
+        }
+        // Iter is a special case
+        if ((dim_counter < 5) && (indices_max_ip[dim_counter] > flq.dim[dim_counter])){
+            Rcpp::stop("In FLQuant subsetter: requested subset dimensions are outside of FLQuant bounds.\n");
+        }
+    }
+    // Iterations are a special case: Allowed 1 or N. If FLQ has 1 iter and you ask for more, you get the 1. As R.
+    unsigned int iter_max = indices_max_ip[5];
+    if (iter_max > flq.dim[5]){
+        if ((indices_min_ip[5] == 1) && (flq.dim[5] == 1)){
+            iter_max = 1;
+        }
+        else {
+            Rcpp::stop("In FLQuant subsetter: Max iter > Niters. Only allowed if FLQuant has 1 iter. Even then subset can only be 1:1 or 1:N iters.\n");
+        }
+    }
+    unsigned int parent_stride = 1;
+    unsigned int offset = 0;
+    for (int dim_counter = 0; dim_counter < 6; ++dim_counter){
+        indices_min[dim_counter] = indices_min_ip[dim_counter];
+        dim[dim_counter] = ((dim_counter < 5) ? indices_max_ip[dim_counter] : iter_max) - indices_min_ip[dim_counter] + 1;
+        stride[dim_counter] = parent_stride;
+        offset += (indices_min_ip[dim_counter] - 1) * parent_stride;
+        parent_stride *= flq.dim[dim_counter];
+    }
+    first = flq.data.data() + offset;
+}
+
+template <typename T>
+std::vector<unsigned int> FLQuantView<T>::get_dim() const{
+    return std::vector<unsigned int>(dim.begin(), dim.end());
+}
+
+template <typename T>
+unsigned int FLQuantView<T>::get_size() const{
+    return dim[0] * dim[1] * dim[2] * dim[3] * dim[4] * dim[5];
+}
+
+template <typename T>
+unsigned int FLQuantView<T>::get_nquant() const{
+	return dim[0];
+}
+
+template <typename T>
+unsigned int FLQuantView<T>::get_nyear() const{
+	return dim[1];
+}
+
+template <typename T>
+unsigned int FLQuantView<T>::get_nunit() const{
+	return dim[2];
+}
+
+template <typename T>
+unsigned int FLQuantView<T>::get_nseason() const{
+	return dim[3];
+}
+
+template <typename T>
+unsigned int FLQuantView<T>::get_narea() const{
+	return dim[4];
+}
+
+template <typename T>
+unsigned int FLQuantView<T>::get_niter() const{
+	return dim[5];
+}
+
+template <typename T>
+std::string FLQuantView<T>::get_units() const{
+    return parent->units;
+}
+
+/*! \brief The dimnames of the parent FLQuant over the subset
+ *
+ * Only the names of the dimensions that are not completely covered by the view are copied.
+ */
+template <typename T>
+FLQuant_dimnames FLQuantView<T>::get_dimnames() const{
+    FLQuant_dimnames new_dimnames = parent->dimnames;
+    for (unsigned int dim_counter = 0; dim_counter < 6; ++dim_counter){
+        new_dimnames.subset(dim_counter, indices_min[dim_counter], dim[dim_counter]);
+    }
+    return new_dimnames;
+}
+
+// Get only data accessor - all dims - starts at 1
+template <typename T>
+T FLQuantView<T>::operator () (const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, unsigned int iter) const{
+    if ((quant > dim[0]) || (quant < 1)){
+        Rcpp::stop("In FLQuantView accessor. quant outside of range.\n");
+    }
+    return *(quant_begin(year, unit, season, area, iter) + quant - 1);
+}
+
+/*! \brief Pointer to the contiguous quants of a year, unit, season, area and iter of the view
+ *
+ * The indices start at 1. If the view has 1 iter, any iter gives the first one.
+ */
+template <typename T>
+const T* FLQuantView<T>::quant_begin(const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, unsigned int iter) const{
+    if ((year < 1) || (unit < 1) || (season < 1) || (area < 1) || (iter < 1)){
+        Rcpp::stop("In FLQuantView accessor. year etc must be > 0\n");
+    }
+    if ((year > dim[1]) || (unit > dim[2]) || (season > dim[3]) || (area > dim[4])){
+        Rcpp::stop("Trying to access element outside of year, unit, season or area dim range of FLQuantView.");
+    }
+    if (dim[5] == 1){
+        iter = 1;
+    }
+    if (iter > dim[5]){
+        Rcpp::stop("In FLQuantView accessor: trying to access iter > niter\n");
+    }
+    return first + (year - 1) * stride[1] + (unit - 1) * stride[2] + (season - 1) * stride[3] + (area - 1) * stride[4] + (iter - 1) * stride[5];
+}
+
+/*! \brief Copy the subset into a new FLQuant
+ *
+ * Also sets the units and the dimnames of the subset.
+ */
+template <typename T>
+FLQuant_base<T> FLQuantView<T>::to_FLQuant() const{
+    FLQuant_base<T> out(dim[0], dim[1], dim[2], dim[3], dim[4], dim[5]);
+    out.insert(*this, Index6(1, 1, 1, 1, 1, 1), out.get_dim());
+    out.set_units(get_units());
+    out.set_dimnames(get_dimnames());
+    return out;
+}
+
+template <typename T>
+FLQuant_base<T> quant_sum(const FLQuantView<T>& flqv){
+    std::vector<unsigned int> dim = flqv.get_dim();
+    FLQuant_base<T> sum_flq(1, dim[1], dim[2], dim[3], dim[4], dim[5]);
+    FLQuant_dimnames dimnames = flqv.get_dimnames();
+    dimnames.set_names(0, summary_names(0));
+    sum_flq.set_dimnames(dimnames);
+    sum_flq.set_units(flqv.get_units());
+    typename FLQuant_base<T>::iterator sum_iterator = sum_flq.begin();
+    for (unsigned int iters=1; iters <= dim[5]; ++iters){
+        for (unsigned int areas=1; areas <= dim[4]; ++areas){
+            for (unsigned int seasons=1; seasons <= dim[3]; ++seasons){
+                for (unsigned int units=1; units <= dim[2]; ++units){
+                    for (unsigned int years=1; years <= dim[1]; ++years){
+                        const T* quants = flqv.quant_begin(years, units, seasons, areas, iters);
+                        T sum = 0;
+                        for (unsigned int quant_count=0; quant_count < dim[0]; ++quant_count){
+                            sum += quants[quant_count];
+                        }
+                        *sum_iterator = sum;
+                        ++sum_iterator;
+    }}}}}
+    return sum_flq;
+}
+
+// Sum over the unit dimension of a view
+template <typename T>
+FLQuant_base<T> unit_sum(const FLQuantView<T>& flqv){
+    std::vector<unsigned int> dim = flqv.get_dim();
+    FLQuant_base<T> sum_flq(dim[0], dim[1], 1, dim[3], dim[4], dim[5]);
+    FLQuant_dimnames dimnames = flqv.get_dimnames();
+    dimnames.set_names(2, summary_names(2));
+    sum_flq.set_dimnames(dimnames);
+    sum_flq.set_units(flqv.get_units());
+    for (unsigned int iters=1; iters <= dim[5]; ++iters){
+        for (unsigned int areas=1; areas <= dim[4]; ++areas){
+            for (unsigned int seasons=1; seasons <= dim[3]; ++seasons){
+                for (unsigned int years=1; years <= dim[1]; ++years){
+                    typename FLQuant_base<T>::iterator sum_iterator = sum_flq.begin() + sum_flq.get_data_element(1, years, 1, seasons, areas, iters);
+                    for (unsigned int units=1; units <= dim[2]; ++units){
+                        const T* quants = flqv.quant_begin(years, units, seasons, areas, iters);
+                        std::transform(quants, quants + dim[0], sum_iterator, sum_iterator, [](const T& x, const T& sum) -> T {return sum + x;});
+                    }
+    }}}}
+    return sum_flq;
+}
+
 /*----------------------------------------------------*/
 /* Explicit instantiations - alternatively put all the definitions into the header file
  * This way we have more control over what types the functions work with
@@ -1607,6 +1668,10 @@ void timestep_to_year_season(const unsigned int timestep, const unsigned int nse
 template class FLQuant_base<double>;
 template class FLQuant_base<adouble>;
 
+// Views
+template class FLQuantView<double>;
+template class FLQuantView<adouble>;
+
 // Instantiate arithmetic class methods with mixed types 
 template FLQuant_base<adouble>& FLQuant_base<adouble>::operator *= (const FLQuant_base<double>& rhs);
 template FLQuant_base<adouble>& FLQuant_base<adouble>::operator *= (const double& rhs);
@@ -1621,40 +1686,6 @@ template FLQuant_base<adouble>& FLQuant_base<adouble>::operator += (const double
 template int FLQuant_base<adouble>::match_dims(const FLQuant_base<double>& b) const;
 template int FLQuant_base<double>::match_dims(const FLQuant_base<adouble>& b) const;
 
-// Explicit instantiation of extra templated artithmetic functions
-// Multiplication
-template FLQuant_base<adouble> operator * (const FLQuant_base<double>& lhs, const FLQuant_base<adouble>& rhs);
-template FLQuant_base<adouble> operator * (const FLQuant_base<adouble>& lhs, const FLQuant_base<double>& rhs);
-template FLQuant_base<adouble> operator * (const adouble& lhs, const FLQuant_base<adouble>& rhs);
-template FLQuant_base<adouble> operator * (const double& lhs, const FLQuant_base<adouble>& rhs);
-template FLQuant_base<adouble> operator * (const FLQuant_base<adouble>& lhs, const double& rhs);
-template FLQuant_base<adouble> operator * (const FLQuant_base<double>& lhs, const adouble& rhs);
-template FLQuant_base<adouble> operator * (const adouble& lhs, const FLQuant_base<double>& rhs);
-// Division
-template FLQuant_base<adouble> operator / (const FLQuant_base<double>& lhs, const FLQuant_base<adouble>& rhs);
-template FLQuant_base<adouble> operator / (const FLQuant_base<adouble>& lhs, const FLQuant_base<double>& rhs);
-template FLQuant_base<adouble> operator / (const adouble& lhs, const FLQuant_base<adouble>& rhs);
-template FLQuant_base<adouble> operator / (const double& lhs, const FLQuant_base<adouble>& rhs);
-template FLQuant_base<adouble> operator / (const FLQuant_base<adouble>& lhs, const double& rhs);
-template FLQuant_base<adouble> operator / (const FLQuant_base<double>& lhs, const adouble& rhs);
-template FLQuant_base<adouble> operator / (const adouble& lhs, const FLQuant_base<double>& rhs);
-// Subtraction
-template FLQuant_base<adouble> operator - (const FLQuant_base<double>& lhs, const FLQuant_base<adouble>& rhs);
-template FLQuant_base<adouble> operator - (const FLQuant_base<adouble>& lhs, const FLQuant_base<double>& rhs);
-template FLQuant_base<adouble> operator - (const adouble& lhs, const FLQuant_base<adouble>& rhs);
-template FLQuant_base<adouble> operator - (const double& lhs, const FLQuant_base<adouble>& rhs);
-template FLQuant_base<adouble> operator - (const FLQuant_base<adouble>& lhs, const double& rhs);
-template FLQuant_base<adouble> operator - (const FLQuant_base<double>& lhs, const adouble& rhs);
-template FLQuant_base<adouble> operator - (const adouble& lhs, const FLQuant_base<double>& rhs);
-// Addition
-template FLQuant_base<adouble> operator + (const FLQuant_base<double>& lhs, const FLQuant_base<adouble>& rhs);
-template FLQuant_base<adouble> operator + (const FLQuant_base<adouble>& lhs, const FLQuant_base<double>& rhs);
-template FLQuant_base<adouble> operator + (const adouble& lhs, const FLQuant_base<adouble>& rhs);
-template FLQuant_base<adouble> operator + (const double& lhs, const FLQuant_base<adouble>& rhs);
-template FLQuant_base<adouble> operator + (const FLQuant_base<adouble>& lhs, const double& rhs);
-template FLQuant_base<adouble> operator + (const FLQuant_base<double>& lhs, const adouble& rhs);
-template FLQuant_base<adouble> operator + (const adouble& lhs, const FLQuant_base<double>& rhs);
-
 // Sweep operations
 template FLQuant_base<adouble> sweep_mult(const FLQuant_base<adouble>& flq1, const FLQuant_base<adouble>& flq2);
 template FLQuant_base<double> sweep_mult(const FLQuant_base<double>& flq1, const FLQuant_base<double>& flq2);
@@ -1665,16 +1696,6 @@ template FLQuant_base<double> sweep_plus(const FLQuant_base<double>& flq1, const
 template FLQuant_base<adouble> sweep_minus(const FLQuant_base<adouble>& flq1, const FLQuant_base<adouble>& flq2);
 template FLQuant_base<double> sweep_minus(const FLQuant_base<double>& flq1, const FLQuant_base<double>& flq2);
 
-// Pow
-template FLQuant_base<double> pow(const FLQuant_base<double>& flq, const double power);
-template FLQuant_base<adouble> pow(const FLQuant_base<adouble>& flq, const adouble power);
-
-// Explicit instantiation of other functions
-template FLQuant_base<double> log(const FLQuant_base<double>& flq);
-template FLQuant_base<adouble> log(const FLQuant_base<adouble>& flq);
-template FLQuant_base<double> exp(const FLQuant_base<double>& flq);
-template FLQuant_base<adouble> exp(const FLQuant_base<adouble>& flq);
-
 template FLQuant_base<double> year_sum(const FLQuant_base<double>& flq);
 template FLQuant_base<adouble> year_sum(const FLQuant_base<adouble>& flq);
 template FLQuant_base<double> year_mean(const FLQuant_base<double>& flq);
@@ -1688,6 +1709,11 @@ template FLQuant_base<adouble> quant_mean(const FLQuant_base<adouble>& flq);
 template FLQuant_base<double> unit_sum(const FLQuant_base<double>& flq);
 template FLQuant_base<adouble> unit_sum(const FLQuant_base<adouble>& flq);
 
+template FLQuant_base<double> quant_sum(const FLQuantView<double>& flqv);
+template FLQuant_base<adouble> quant_sum(const FLQuantView<adouble>& flqv);
+template FLQuant_base<double> unit_sum(const FLQuantView<double>& flqv);
+template FLQuant_base<adouble> unit_sum(const FLQuantView<adouble>& flqv);
+
 template FLQuant_base<double> max_quant(const FLQuant_base<double>& flq);
 template FLQuant_base<adouble> max_quant(const FLQuant_base<adouble>& flq);
 
@@ -1,73 +1,209 @@
-/* 
+/*
  * Copyright 2014 FLR Team. Distributed under the GPL 2 or later
  * Maintainer: Finlay Scott, JRC
  */
 
 #include "../inst/include/FLQuant_multidim.h"
+#include <numeric>
+
+namespace {
+// Make the header of a slice with the shape, units and dimnames of an FLQuant
+template <typename T>
+std::shared_ptr<const FLQuant7_header> make_header(const FLQuant_base<T>& flq){
+    return std::make_shared<const FLQuant7_header>(FLQuant7_header{flq.get_dim(), flq.get_size(), flq.get_units(), flq.get_dimnames()});
+}
+
+// Position of an element in a slice (starting at 0), with the same checks as FLQuant_base::get_data_element()
+std::size_t get_slice_element(const std::vector<unsigned int>& dim, const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, unsigned int iter){
+    if ((quant == 0) || (year == 0) || (unit == 0) || (season == 0) || (area == 0) || (iter == 0)){
+        Rcpp::stop("In FLQuant7 accessor. quant etc must be > 0\n");
+    }
+    if ((quant > dim[0]) || (year > dim[1]) || (unit > dim[2]) || (season > dim[3]) || (area > dim[4])){
+        Rcpp::stop("Trying to access element outside of quant, year, unit, season or area dim range.");
+    }
+    // If only 1 iter and trying to get n iter, set iter to 1
+    if (dim[5] == 1){
+        iter = 1;
+    }
+    if (iter > dim[5]){
+        Rcpp::stop("In FLQuant7 accessor: trying to access iter > niter\n");
+    }
+    return (quant - 1) + dim[0] * ((year - 1) + dim[1] * ((unit - 1) + dim[2] * ((season - 1) + dim[3] * ((area - 1) + dim[4] * (std::size_t(iter) - 1)))));
+}
+}
+
+/*--------------- FLQuant7_slice -------------------*/
+
+template <typename T>
+FLQuant7_slice<T>::FLQuant7_slice(T* first_in, const FLQuant7_header* header_in) : first(first_in), header(header_in){
+}
+
+template <typename T>
+const std::vector<unsigned int>& FLQuant7_slice<T>::get_dim() const{
+    return header->dim;
+}
+
+template <typename T>
+unsigned int FLQuant7_slice<T>::get_size() const{
+    return header->size;
+}
+
+template <typename T>
+unsigned int FLQuant7_slice<T>::get_niter() const{
+    return header->dim[5];
+}
+
+template <typename T>
+const std::string& FLQuant7_slice<T>::get_units() const{
+    return header->units;
+}
+
+template <typename T>
+const FLQuant_dimnames& FLQuant7_slice<T>::get_dimnames() const{
+    return header->dimnames;
+}
+
+template <typename T>
+T FLQuant7_slice<T>::operator () (const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const unsigned int iter) const{
+    return first[get_slice_element(header->dim, quant, year, unit, season, area, iter)];
+}
+
+template <typename T>
+T& FLQuant7_slice<T>::operator () (const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const unsigned int iter){
+    return first[get_slice_element(header->dim, quant, year, unit, season, area, iter)];
+}
+
+template <typename T>
+T* FLQuant7_slice<T>::begin(){
+    return first;
+}
+
+template <typename T>
+T* FLQuant7_slice<T>::end(){
+    return first + header->size;
+}
+
+template <typename T>
+const T* FLQuant7_slice<T>::begin() const{
+    return first;
+}
+
+template <typename T>
+const T* FLQuant7_slice<T>::end() const{
+    return first + header->size;
+}
+
+template <typename T>
+FLQuant_base<T> FLQuant7_slice<T>::to_FLQuant() const{
+    FLQuant_base<T> out(header->dim);
+    std::copy(begin(), end(), out.begin());
+    out.set_units(header->units);
+    out.set_dimnames(header->dimnames);
+    return out;
+}
+
+template <typename T>
+FLQuant7_slice<T>& FLQuant7_slice<T>::operator = (const FLQuant_base<T>& flq){
+    if (flq.get_dim() != header->dim){
+        Rcpp::stop("In FLQuant7_slice assignment. The dims of the FLQuant must match those of the slice.\n");
+    }
+    std::copy(flq.begin(), flq.end(), first);
+    return *this;
+}
+
+/*--------------- FLQuant7_base -------------------*/
 
 // Default constructor
-// No dimnames set as the array is null
+// No slices
 template <typename T>
 FLQuant7_base<T>::FLQuant7_base(){
-    //Rprintf("In FLQuant7_base<T> basic constructor\n");
-    // Make NULL std::vector<T>?
 }
 
 // Used as intrusive 'as' - takes a list
-template <typename T> 
+// The FLQuants are made first so that the block is only allocated once
+template <typename T>
 FLQuant7_base<T>::FLQuant7_base(SEXP lst_sexp){
-    //Rprintf("In FLQuant7_base<T> SEXP constructor\n");
     Rcpp::List lst(lst_sexp);
-    Rcpp::List::iterator lst_iterator;
-    // Use emplace_back - avoid copies
-    for (lst_iterator = lst.begin(); lst_iterator != lst.end(); ++ lst_iterator){
-    // Use emplace_back - avoid copies
-        data.push_back(*lst_iterator);
+    std::vector<FLQuant_base<T> > flqs;
+    flqs.reserve(lst.size());
+    std::size_t size = 0;
+    for (Rcpp::List::iterator lst_iterator = lst.begin(); lst_iterator != lst.end(); ++lst_iterator){
+        flqs.emplace_back(static_cast<SEXP>(*lst_iterator));
+        size += flqs.back().get_size();
+    }
+    data.reserve(size);
+    for (const auto& flq : flqs){
+        (*this)(flq);
     }
 }
 
 // Constructor from an FLQuant
-template <typename T> 
-FLQuant7_base<T>::FLQuant7_base(FLQuant_base<T> flq){
-    //Rprintf("In FLQuant7_base<T> FLQuant constructor\n");
-    // Use emplace_back - avoid copies
-    // Use emplace_back - avoid copies
-    data.push_back(flq);
+template <typename T>
+FLQuant7_base<T>::FLQuant7_base(const FLQuant_base<T>& flq){
+    (*this)(flq);
+}
+
+/*! \brief Make ndim7 slices of the same dims, filled with a value
+ *
+ * The slices share one header with blank dimnames.
+ * \param dim The dims of each slice.
+ * \param ndim7 The number of slices.
+ * \param value The value to fill the slices with.
+ */
+template <typename T>
+FLQuant7_base<T>::FLQuant7_base(const std::vector<unsigned int>& dim, const unsigned int ndim7, const T value){
+    if (dim.size() != 6){
+        Rcpp::stop("In FLQuant7 constructor. dim not of length 6.\n");
+    }
+    const std::size_t size = std::accumulate(dim.begin(), dim.end(), std::size_t(1), std::multiplies<std::size_t>());
+    auto header = std::make_shared<const FLQuant7_header>(FLQuant7_header{dim, size, std::string(), FLQuant_dimnames(dim)});
+    data.assign(size * ndim7, value);
+    for (unsigned int slice_count = 0; slice_count < ndim7; ++slice_count){
+        offsets.push_back(slice_count * size);
+        headers.push_back(header);
+    }
 }
 
 // Intrusive wrap
 // List is unamed
 template<typename T>
 FLQuant7_base<T>::operator SEXP() const{
-    //Rprintf("Wrapping FLQuant7_base<T>.\n");
     Rcpp::List list_out;
-    for (unsigned int i = 0; i < get_ndim7(); i++){
-    // Use emplace_back - avoid copies
-        list_out.push_back(data[i]);
+    for (unsigned int i = 1; i <= get_ndim7(); i++){
+        list_out.push_back((*this)(i));
     }
-    // Or, using iterators.
-    // Would like to use an iterator member but cannot change its value in a const method so cannot set value to data.begin()
-    //typename vector<FLQuant_base<T> >::const_iterator data_iterator; 
-    //for (data_iterator = data.begin(); data_iterator != data.end(); ++data_iterator){ // iterator must be const because the method is const
-    //    list_out.push_back(*data_iterator);
-    //}
     return list_out;
 }
 
-
 // Copy constructor - else 'data' can be pointed at by multiple instances
+// The headers are not changed once made so they are shared
 template<typename T>
-FLQuant7_base<T>::FLQuant7_base(const FLQuant7_base<T>& FLQuant7_source){
-    //Rprintf("In FLQuant7_base<T> copy constructor\n");
-	data  = FLQuant7_source.data; // std::vector always does deep copy
+FLQuant7_base<T>::FLQuant7_base(const FLQuant7_base<T>& FLQuant7_source) : data(FLQuant7_source.data), offsets(FLQuant7_source.offsets), headers(FLQuant7_source.headers){
 }
 
 // Assignment operator to ensure deep copy - else 'data' can be pointed at by multiple instances
 template<typename T>
 FLQuant7_base<T>& FLQuant7_base<T>::operator = (const FLQuant7_base<T>& FLQuant7_source){
-    //Rprintf("In FLQuant7_base<T> assignment operator\n");
 	if (this != &FLQuant7_source){
-        data  = FLQuant7_source.data; // std::vector always does deep copy
+        data = FLQuant7_source.data;
+        offsets = FLQuant7_source.offsets;
+        headers = FLQuant7_source.headers;
+	}
+	return *this;
+}
+
+// Move constructor - takes the members of a temporary instead of copying them
+template<typename T>
+FLQuant7_base<T>::FLQuant7_base(FLQuant7_base<T>&& FLQuant7_source) noexcept : data(std::move(FLQuant7_source.data)), offsets(std::move(FLQuant7_source.offsets)), headers(std::move(FLQuant7_source.headers)){
+}
+
+// Move assignment operator
+template<typename T>
+FLQuant7_base<T>& FLQuant7_base<T>::operator = (FLQuant7_base<T>&& FLQuant7_source) noexcept{
+	if (this != &FLQuant7_source){
+        data = std::move(FLQuant7_source.data);
+        offsets = std::move(FLQuant7_source.offsets);
+        headers = std::move(FLQuant7_source.headers);
 	}
 	return *this;
 }
@@ -76,59 +212,71 @@ FLQuant7_base<T>& FLQuant7_base<T>::operator = (const FLQuant7_base<T>& FLQuant7
 
 template <typename T>
 unsigned int FLQuant7_base<T>::get_ndim7() const {
-    unsigned int length = data.size();
-    return length;
+    return offsets.size();
+}
+
+template <typename T>
+void FLQuant7_base<T>::check_element(const unsigned int element) const {
+    if ((element == 0) || (element > get_ndim7())){
+        Rcpp::stop("FLQuant7_base: Trying to access element larger than data size.");
+    }
+}
+
+template <typename T>
+const std::vector<unsigned int>& FLQuant7_base<T>::get_dim(const unsigned int element) const {
+    check_element(element);
+    return headers[element-1]->dim;
+}
+
+template <typename T>
+const typename FLQuant7_base<T>::data_type& FLQuant7_base<T>::get_data() const {
+    return data;
 }
 
+template <typename T>
+typename FLQuant7_base<T>::data_type& FLQuant7_base<T>::get_data() {
+    return data;
+}
 
-// Add another FLQuant_base<T> to the data
+// Add another FLQuant_base<T> as a new slice at the end of the block
+// Views of the slices made before are no longer valid
 template <typename T>
-void FLQuant7_base<T>::operator() (const FLQuant_base<T> flq){
-    // Use emplace_back - avoid copies
-    data.push_back(flq);
+void FLQuant7_base<T>::operator() (const FLQuant_base<T>& flq){
+    offsets.push_back(data.size());
+    headers.push_back(make_header(flq));
+    data.insert(data.end(), flq.begin(), flq.end());
 }
 
 // Get only data accessor - single element
 template <typename T>
 FLQuant_base<T> FLQuant7_base<T>::operator () (const unsigned int element) const{
-    //Rprintf("In const single element accessor\n");
-    if (element > get_ndim7()){
-        Rcpp::stop("FLQuant7_base: Trying to access element larger than data size.");
-    }
-    return data[element-1];
+    check_element(element);
+    return FLQuant7_slice<T>(const_cast<T*>(data.data()) + offsets[element-1], headers[element-1].get()).to_FLQuant();
 }
 
 // Data accessor - single element
 template <typename T>
-FLQuant_base<T>& FLQuant7_base<T>::operator () (const unsigned int element){
-    //Rprintf("In single element accessor\n");
-    if (element > get_ndim7()){
-        Rcpp::stop("FLQuant7_base: Trying to access element larger than data size.");
-    }
-	return data[element-1];
+FLQuant7_slice<T> FLQuant7_base<T>::operator () (const unsigned int element){
+    check_element(element);
+    return FLQuant7_slice<T>(data.data() + offsets[element-1], headers[element-1].get());
 }
 
 // Get only data accessor - all dims
 template <typename T>
 T FLQuant7_base<T>::operator () (const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const unsigned int iter, const unsigned int dim7) const{
-    //Rprintf("In const multiple element accessor\n");
-    if (dim7 > get_ndim7()){
-        Rcpp::stop("FLQuant7_base: Trying to access element larger than data size.");
-    }
-	return data[dim7-1](quant, year, unit, season, area, iter);
+    check_element(dim7);
+	return data[offsets[dim7-1] + get_slice_element(headers[dim7-1]->dim, quant, year, unit, season, area, iter)];
 }
 
 // Get and set data accessor - all dims
 template <typename T>
 T& FLQuant7_base<T>::operator () (const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const unsigned int iter, const unsigned int dim7){
-    //Rprintf("In multiple element accessor\n");
-    if (dim7 > get_ndim7()){
-        Rcpp::stop("FLQuant7_base: Trying to access element larger than data size.");
-    }
-	return data[dim7-1](quant, year, unit, season, area, iter);
+    check_element(dim7);
+	return data[offsets[dim7-1] + get_slice_element(headers[dim7-1]->dim, quant, year, unit, season, area, iter)];
 }
 
 // Explicit instantiation of class
+template class FLQuant7_slice<double>;
+template class FLQuant7_slice<adouble>;
 template class FLQuant7_base<double>;
 template class FLQuant7_base<adouble>;
-
@@ -0,0 +1,236 @@
+/*
+ * Copyright 2014 FLR Team. Distributed under the GPL 2 or later
+ * Maintainer: Finlay Scott, JRC
+ */
+
+#include "../inst/include/FLQuant_param.h"
+
+bool FLQuant_param::single = false;
+
+/*--------------- FLQuant_param -------------------*/
+
+// Default constructor
+// No dimensions, double precision
+FLQuant_param::FLQuant_param(){
+}
+
+// Used as intrusive 'as' - takes an FLQuant
+FLQuant_param::FLQuant_param(SEXP flq_sexp) : FLQuant_param(FLQuant(flq_sexp)) {
+}
+
+/*! \brief Hold the values of an FLQuant in the current storage mode
+ *
+ * \param flq The FLQuant.
+ */
+FLQuant_param::FLQuant_param(const FLQuant& flq) : dim(flq.get_dim()), units(flq.get_units()), dimnames(flq.get_dimnames()) {
+    if (single){
+        compact.assign(flq.begin(), flq.end());
+    }
+    else {
+        full = flq;
+    }
+}
+
+// Intrusive wrap - the values are returned in double precision
+FLQuant_param::operator SEXP() const{
+    return Rcpp::wrap(to_FLQuant());
+}
+
+void FLQuant_param::set_single(const bool single_in){
+    single = single_in;
+}
+
+bool FLQuant_param::get_single(){
+    return single;
+}
+
+/*--------------- Accessors -------------------*/
+
+bool FLQuant_param::is_single() const{
+    return !compact.empty();
+}
+
+const std::vector<unsigned int>& FLQuant_param::get_dim() const{
+    return dim;
+}
+
+unsigned int FLQuant_param::get_size() const{
+    return is_single() ? compact.size() : full.get_size();
+}
+
+const std::string& FLQuant_param::get_units() const{
+    return units;
+}
+
+const FLQuant_dimnames& FLQuant_param::get_dimnames() const{
+    return dimnames;
+}
+
+/*! \brief Position of an element in the values in single precision mode
+ *
+ * Makes the same checks as FLQuant_base::get_data_element().
+ * If there is only 1 iter and iter > 1 the element of iter 1 is returned.
+ */
+unsigned int FLQuant_param::get_data_element(const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, unsigned int iter) const{
+    if ((quant <= 0) || (year <= 0) || (unit <= 0) || (season <= 0) || (area <= 0) || (iter <= 0)){
+        Rcpp::stop("In FLQuant accessor. quant etc must be > 0\n");
+    }
+    if ((quant > dim[0]) || (year > dim[1]) || (unit > dim[2]) || (season > dim[3]) || (area > dim[4])){
+        Rcpp::stop("Trying to access element outside of quant, year, unit, season or area dim range.");
+    }
+    if ((iter > 1) && (dim[5] == 1)){
+        iter = 1;
+    }
+    if (iter > dim[5]){
+        Rcpp::stop("In get_data_element: trying to access iter > niter\n");
+    }
+    return (quant - 1) + dim[0] * ((year - 1) + dim[1] * ((unit - 1) + dim[2] * ((season - 1) + dim[3] * ((area - 1) + dim[4] * (iter - 1)))));
+}
+
+// Get only data accessor - all dims - starts at 1
+double FLQuant_param::operator () (const unsigned int quant, const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const unsigned int iter) const{
+    if (!is_single()){
+        return full(quant, year, unit, season, area, iter);
+    }
+    return compact[get_data_element(quant, year, unit, season, area, iter)];
+}
+
+double FLQuant_param::operator () (const Index6& indices) const{
+    return (*this)(indices[0], indices[1], indices[2], indices[3], indices[4], indices[5]);
+}
+
+// Subset accessor - the values are widened in single precision mode
+FLQuant FLQuant_param::operator () (const Index6& indices_min, const Index6& indices_max) const{
+    if (!is_single()){
+        return full(indices_min, indices_max);
+    }
+    return view(indices_min, indices_max).to_FLQuant();
+}
+
+/*! \brief All of the values as an FLQuant
+ *
+ * A copy, with the values widened in single precision mode.
+ */
+FLQuant FLQuant_param::to_FLQuant() const{
+    if (!is_single()){
+        return full;
+    }
+    FLQuant out(dim);
+    std::copy(compact.begin(), compact.end(), out.begin());
+    out.set_units(units);
+    out.set_dimnames(dimnames);
+    return out;
+}
+
+FLQuant_param_view FLQuant_param::view(const Index6& indices_min, const Index6& indices_max) const{
+    return FLQuant_param_view(*this, indices_min, indices_max);
+}
+
+/*--------------- FLQuant_param_view -------------------*/
+
+/*! \brief A view of all of an FLQuant_param
+ *
+ * \param param The parent.
+ */
+FLQuant_param_view::FLQuant_param_view(const FLQuant_param& param) : FLQuant_param_view(param, Index6(1, 1, 1, 1, 1, 1), param.get_dim()) {
+}
+
+/*! \brief A view of a subset of an FLQuant_param
+ *
+ * Makes the same checks as the FLQuant subsetter.
+ * \param param The parent.
+ * \param indices_min_ip A vector of length 6 with the minimum indices of the 6 dimensions
+ * \param indices_max_ip A vector of length 6 with the maximum indices of the 6 dimensions
+ */
+FLQuant_param_view::FLQuant_param_view(const FLQuant_param& param, const Index6& indices_min_ip, const Index6& indices_max_ip) : parent(&param), full_first(nullptr), compact_first(nullptr) {
+    const std::vector<unsigned int>& param_dim = param.get_dim();
+    if (param_dim.size() != 6){
+        Rcpp::stop("In FLQuant subsetter: FLQuant has no dimensions.\n");
+    }
+    for (int dim_counter = 0; dim_counter < 6; ++dim_counter){
+        if (indices_min_ip[dim_counter] < 1){
+            Rcpp::stop("In FLQuant subsetter: requested min dimensions are less than 1.\n");
+        }
+        if (indices_max_ip[dim_counter] < indices_min_ip[dim_counter]){
+            Rcpp::stop("In FLQuant subsetter: min dim > max\n");
+        }
+        // Iter is a special case
+        if ((dim_counter < 5) && (indices_max_ip[dim_counter] > param_dim[dim_counter])){
+            Rcpp::stop("In FLQuant subsetter: requested subset dimensions are outside of FLQuant bounds.\n");
+        }
+    }
+    // Iterations are a special case: Allowed 1 or N. If FLQ has 1 iter and you ask for more, you get the 1. As R.
+    unsigned int iter_max = indices_max_ip[5];
+    if (iter_max > param_dim[5]){
+        if ((indices_min_ip[5] == 1) && (param_dim[5] == 1)){
+            iter_max = 1;
+        }
+        else {
+            Rcpp::stop("In FLQuant subsetter: Max iter > Niters. Only allowed if FLQuant has 1 iter. Even then subset can only be 1:1 or 1:N iters.\n");
+        }
+    }
+    unsigned int parent_stride = 1;
+    unsigned int offset = 0;
+    for (int dim_counter = 0; dim_counter < 6; ++dim_counter){
+        indices_min[dim_counter] = indices_min_ip[dim_counter];
+        dim[dim_counter] = ((dim_counter < 5) ? indices_max_ip[dim_counter] : iter_max) - indices_min_ip[dim_counter] + 1;
+        stride[dim_counter] = parent_stride;
+        offset += (indices_min_ip[dim_counter] - 1) * parent_stride;
+        parent_stride *= param_dim[dim_counter];
+    }
+    if (param.is_single()){
+        compact_first = param.compact.data() + offset;
+    }
+    else {
+        full_first = param.full.begin() + offset;
+    }
+}
+
+std::vector<unsigned int> FLQuant_param_view::get_dim() const{
+    return std::vector<unsigned int>(dim.begin(), dim.end());
+}
+
+std::string FLQuant_param_view::get_units() const{
+    return parent->get_units();
+}
+
+FLQuant_dimnames FLQuant_param_view::get_dimnames() const{
+    FLQuant_dimnames new_dimnames = parent->get_dimnames();
+    for (unsigned int dim_counter = 0; dim_counter < 6; ++dim_counter){
+        new_dimnames.subset(dim_counter, indices_min[dim_counter], dim[dim_counter]);
+    }
+    return new_dimnames;
+}
+
+/*! \brief Copy the subset into a new FLQuant
+ *
+ * The values are widened to double. The expression sets the units and the dimnames of the subset.
+ */
+FLQuant FLQuant_param_view::to_FLQuant() const{
+    return FLQuant(FLQuant_expr_param_leaf(*this));
+}
+
+//'@title Hold the biological and fishery parameters in single precision
+//'@description Set the storage mode of the parameter slots of the biols and catches used in projections.
+//'@name set_single_precision_params
+//
+
+//' The slots are wt, m, spwn, fec and mat of the biols and landings.wt, discards.wt, catch.sel, price and catch.q of the catches.
+//' They are only read during a projection.
+//' In single precision mode they are held as floats, which halves their memory in operating models with many iterations.
+//' The values are widened to double where they are used. The abundances, the catches and the solver are still in double precision.
+//' The results differ from those of the default double precision mode by the rounding of the parameters (a relative error of about 1e-7).
+//' The mode is used by the projections made after it is set. The default is double precision.
+//'@param single TRUE to hold the parameters in single precision, FALSE for double precision.
+//'@rdname set_single_precision_params
+// [[Rcpp::export]]
+void set_single_precision_params(const bool single){
+    FLQuant_param::set_single(single);
+}
+
+//' @rdname set_single_precision_params
+// [[Rcpp::export]]
+bool get_single_precision_params(){
+    return FLQuant_param::get_single();
+}
+
@@ -0,0 +1,400 @@
+/*
+ * Copyright 2014 FLR Team. Distributed under the GPL 2 or later
+ * Maintainer: Finlay Scott, JRC
+ */
+
+#include "../inst/include/FLQuant_simd.h"
+#include <Rcpp.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+// The AVX2 and AVX-512 kernels are only compiled on x86 with GCC or clang
+// They use the GCC vector extensions so the same code is used for both widths
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define FLASHER_SIMD_X86
+#endif
+
+/*-------------------------------------------------*/
+// Kernels written once for scalars and vectors of doubles
+// V is double or a vector of doubles, VI an integer vector of the same size
+
+namespace {
+
+#define SIMD_INLINE inline __attribute__((always_inline))
+
+// Load and store without alignment requirements
+template <typename V>
+SIMD_INLINE void load(const double* from, V& to){
+    std::memcpy(&to, from, sizeof(V));
+}
+template <typename V>
+SIMD_INLINE void store(const V& from, double* to){
+    std::memcpy(to, &from, sizeof(V));
+}
+// All elements set to value
+template <typename V>
+SIMD_INLINE void broadcast(const double value, V& to){
+    std::memset(&to, 0, sizeof(V));
+    to = to + value;
+}
+
+struct op_multiplies {
+    template <typename V>
+    static SIMD_INLINE void apply(const V& x, const V& y, V& out){ out = x * y; }
+};
+struct op_divides {
+    template <typename V>
+    static SIMD_INLINE void apply(const V& x, const V& y, V& out){ out = x / y; }
+};
+struct op_minus {
+    template <typename V>
+    static SIMD_INLINE void apply(const V& x, const V& y, V& out){ out = x - y; }
+};
+struct op_plus {
+    template <typename V>
+    static SIMD_INLINE void apply(const V& x, const V& y, V& out){ out = x + y; }
+};
+
+// x and y arrays, or one of them a scalar (stride 0)
+template <typename V, typename Op>
+SIMD_INLINE void binary_kernel(const double* x, const std::size_t x_stride, const double* y, const std::size_t y_stride, double* out, const std::size_t n){
+    const std::size_t width = sizeof(V) / sizeof(double);
+    if (n == 0){
+        return;
+    }
+    // Scalars are loaded once
+    V vx, vy, vout;
+    broadcast(*x, vx);
+    broadcast(*y, vy);
+    std::size_t element = 0;
+    for (; element + width <= n; element += width){
+        if (x_stride != 0){
+            load(x + element, vx);
+        }
+        if (y_stride != 0){
+            load(y + element, vy);
+        }
+        Op::apply(vx, vy, vout);
+        store(vout, out + element);
+    }
+    for (; element < n; ++element){
+        double sout;
+        Op::apply(x[element * x_stride], y[element * y_stride], sout);
+        out[element] = sout;
+    }
+}
+
+template <typename V>
+SIMD_INLINE void binary_dispatch(const simd_op op, const double* x, const std::size_t x_stride, const double* y, const std::size_t y_stride, double* out, const std::size_t n){
+    switch (op){
+        case simd_multiplies:
+            binary_kernel<V, op_multiplies>(x, x_stride, y, y_stride, out, n);
+            break;
+        case simd_divides:
+            binary_kernel<V, op_divides>(x, x_stride, y, y_stride, out, n);
+            break;
+        case simd_minus:
+            binary_kernel<V, op_minus>(x, x_stride, y, y_stride, out, n);
+            break;
+        case simd_plus:
+            binary_kernel<V, op_plus>(x, x_stride, y, y_stride, out, n);
+            break;
+    }
+}
+
+/* Cephes exp: exp(x) = 2^n exp(r), with x = n log(2) + r and |r| <= log(2) / 2
+ * exp(r) = 1 + 2r P(r^2) / (Q(r^2) - r P(r^2))
+ * t holds n in its low bits and e is exp(r). 2^n is made from the bits of t by the caller, which needs |x| <= 708.
+ */
+template <typename V>
+SIMD_INLINE void exp_core(const V& x, V& t, V& e){
+    const double shifter = 6755399441055744.0; // 1.5 * 2^52: adding it rounds to an integer held in the low bits
+    t = x * 1.4426950408889634073599 + shifter;
+    V n = t - shifter;
+    V r = x - n * 6.93145751953125E-1;
+    r = r - n * 1.42860682030941723212E-6;
+    V rr = r * r;
+    V px = r * ((1.26177193074810590878E-4 * rr + 3.02994407707441961300E-2) * rr + 9.99999999999999999910E-1);
+    V qx = ((3.00198505138664455042E-6 * rr + 2.52448340349684104192E-3) * rr + 2.27265548208155028766E-1) * rr + 2.00000000000000000009E0;
+    e = 1.0 + 2.0 * (px / (qx - px));
+}
+
+/* Cephes log: log(x) = e log(2) + log(m), with x = m 2^e and sqrt(0.5) <= m < sqrt(2)
+ * log(m) = z + z^3 R(z^2) / S(z^2), with z = 2(m - 1) / (m + 1) = w / y
+ * The caller splits x into w, y and e.
+ */
+template <typename V>
+SIMD_INLINE void log_core(const V& w, const V& y, const V& e, V& out){
+    V z = w / y;
+    V zz = z * z;
+    V ratio = zz * ((-7.89580278884799154124E-1 * zz + 1.63866645699558079767E1) * zz - 6.41409952958715622951E1) /
+        (((zz - 3.56722798256324312549E1) * zz + 3.12093766372244180303E2) * zz - 7.69691943550460008604E2);
+    out = z * ratio;
+    out = out - e * 2.121944400546905827679E-4;
+    out = out + z;
+    out = out + e * 0.693359375;
+}
+
+// Scalar versions of exp and log, with the same formulas as the vector versions
+// Values outside of the range of the formulas go to std::exp and std::log
+double exp_cephes(const double x){
+    if (!((x <= 708.0) && (x >= -708.0))){ // Also NaN
+        return std::exp(x);
+    }
+    double t, e, pow2n;
+    exp_core(x, t, e);
+    std::uint64_t bits;
+    std::memcpy(&bits, &t, sizeof(double));
+    bits = (bits + 1023) << 52;
+    std::memcpy(&pow2n, &bits, sizeof(double));
+    return e * pow2n;
+}
+
+double log_cephes(const double x){
+    std::uint64_t bits;
+    std::memcpy(&bits, &x, sizeof(double));
+    const std::uint64_t exponent = (bits >> 52) & 0x7ff;
+    if (!(x > 0.0) || (exponent == 0) || (exponent == 0x7ff)){
+        return std::log(x);
+    }
+    bits = (bits & 0x000fffffffffffffULL) | 0x3fe0000000000000ULL;
+    double m; // In [0.5, 1)
+    std::memcpy(&m, &bits, sizeof(double));
+    double e = static_cast<double>(exponent) - 1022.0;
+    const double mh = m - 0.5;
+    double w, y;
+    if (m < 0.70710678118654752440){
+        w = mh;
+        y = 0.5 * mh + 0.5;
+        e = e - 1.0;
+    }
+    else {
+        w = mh - 0.5;
+        y = 0.5 * m + 0.5;
+    }
+    double out;
+    log_core(w, y, e, out);
+    return out;
+}
+
+void exp_scalar(const double* x, double* out, const std::size_t n){
+    for (std::size_t element = 0; element < n; ++element){
+        out[element] = exp_cephes(x[element]);
+    }
+}
+
+void log_scalar(const double* x, double* out, const std::size_t n){
+    for (std::size_t element = 0; element < n; ++element){
+        out[element] = log_cephes(x[element]);
+    }
+}
+
+#ifdef FLASHER_SIMD_X86
+
+typedef double v4d __attribute__((vector_size(32)));
+typedef std::int64_t v4i __attribute__((vector_size(32)));
+typedef double v8d __attribute__((vector_size(64)));
+typedef std::int64_t v8i __attribute__((vector_size(64)));
+
+// mask ? a : b, where the lanes of mask are all 1s or all 0s
+template <typename V, typename VI>
+SIMD_INLINE void blend(const VI& mask, const V& a, const V& b, V& out){
+    out = (V)(((VI)a & mask) | ((VI)b & ~mask));
+}
+
+// exp of each lane. The lanes outside of the range of the formula are flagged in outside.
+template <typename V, typename VI>
+SIMD_INLINE void exp_vector(const V& x, V& out, VI& outside){
+    V t, e;
+    exp_core(x, t, e);
+    VI pow2n = ((VI)t + 1023) << 52;
+    out = e * (V)pow2n;
+    outside = ~((VI)(x <= 708.0) & (VI)(x >= -708.0)); // Also NaN
+}
+
+// log of each lane. Only for positive normal numbers, other lanes are flagged in outside.
+template <typename V, typename VI>
+SIMD_INLINE void log_vector(const V& x, V& out, VI& outside){
+    VI bits = (VI)x;
+    VI exponent = (bits >> 52) & 0x7ff;
+    V m = (V)((bits & 0x000fffffffffffffLL) | 0x3fe0000000000000LL); // In [0.5, 1)
+    V e = (V)(exponent | 0x4330000000000000LL) - (4503599627370496.0 + 1022.0); // exponent - 1022 as a double
+    VI small = (VI)(m < 0.70710678118654752440);
+    V mh = m - 0.5;
+    V w, y;
+    blend(small, mh, mh - 0.5, w);
+    blend(small, 0.5 * mh + 0.5, 0.5 * m + 0.5, y);
+    blend(small, e - 1.0, e, e);
+    log_core(w, y, e, out);
+    outside = ~((VI)(x > 0.0) & (VI)(exponent != 0) & (VI)(exponent != 0x7ff));
+}
+
+// One vector of lanes. vector_func is exp_vector or log_vector, the lanes it does not cover use scalar_func.
+template <typename V, typename VI, void (*vector_func)(const V&, V&, VI&), double (*scalar_func)(double)>
+SIMD_INLINE void unary_block(const double* x, double* out){
+    const std::size_t width = sizeof(V) / sizeof(double);
+    V vx, vout;
+    VI outside;
+    load(x, vx);
+    vector_func(vx, vout, outside);
+    for (std::size_t lane = 0; lane < width; ++lane){
+        if (outside[lane] != 0){
+            vout[lane] = scalar_func(vx[lane]);
+        }
+    }
+    store(vout, out);
+}
+
+// The tail is padded to a full vector so that every element uses the same formula
+template <typename V, typename VI, void (*vector_func)(const V&, V&, VI&), double (*scalar_func)(double)>
+SIMD_INLINE void unary_kernel(const double* x, double* out, const std::size_t n){
+    const std::size_t width = sizeof(V) / sizeof(double);
+    std::size_t element = 0;
+    for (; element + width <= n; element += width){
+        unary_block<V, VI, vector_func, scalar_func>(x + element, out + element);
+    }
+    if (element < n){
+        double padded[width];
+        std::fill(padded, padded + width, 1.0); // 1 is in the range of exp and log
+        std::copy(x + element, x + n, padded);
+        unary_block<V, VI, vector_func, scalar_func>(padded, padded);
+        std::copy(padded, padded + (n - element), out + element);
+    }
+}
+
+__attribute__((target("avx2,fma")))
+void binary_avx2(const simd_op op, const double* x, const std::size_t x_stride, const double* y, const std::size_t y_stride, double* out, const std::size_t n){
+    binary_dispatch<v4d>(op, x, x_stride, y, y_stride, out, n);
+}
+
+__attribute__((target("avx2,fma")))
+void exp_avx2(const double* x, double* out, const std::size_t n){
+    unary_kernel<v4d, v4i, exp_vector<v4d, v4i>, exp_cephes>(x, out, n);
+}
+
+__attribute__((target("avx2,fma")))
+void log_avx2(const double* x, double* out, const std::size_t n){
+    unary_kernel<v4d, v4i, log_vector<v4d, v4i>, log_cephes>(x, out, n);
+}
+
+__attribute__((target("avx512f")))
+void binary_avx512(const simd_op op, const double* x, const std::size_t x_stride, const double* y, const std::size_t y_stride, double* out, const std::size_t n){
+    binary_dispatch<v8d>(op, x, x_stride, y, y_stride, out, n);
+}
+
+__attribute__((target("avx512f")))
+void exp_avx512(const double* x, double* out, const std::size_t n){
+    unary_kernel<v8d, v8i, exp_vector<v8d, v8i>, exp_cephes>(x, out, n);
+}
+
+__attribute__((target("avx512f")))
+void log_avx512(const double* x, double* out, const std::size_t n){
+    unary_kernel<v8d, v8i, log_vector<v8d, v8i>, log_cephes>(x, out, n);
+}
+
+#endif // FLASHER_SIMD_X86
+
+// The best level the CPU supports
+simd_level detect_simd_level(){
+#ifdef FLASHER_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")){
+        return simd_avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")){
+        return simd_avx2;
+    }
+#endif
+    return simd_scalar;
+}
+
+simd_level& current_simd_level(){
+    static simd_level level = detect_simd_level();
+    return level;
+}
+
+void binary(const simd_op op, const double* x, const std::size_t x_stride, const double* y, const std::size_t y_stride, double* out, const std::size_t n){
+    switch (current_simd_level()){
+#ifdef FLASHER_SIMD_X86
+        case simd_avx512:
+            binary_avx512(op, x, x_stride, y, y_stride, out, n);
+            return;
+        case simd_avx2:
+            binary_avx2(op, x, x_stride, y, y_stride, out, n);
+            return;
+#endif
+        default:
+            binary_dispatch<double>(op, x, x_stride, y, y_stride, out, n);
+    }
+}
+
+} // anonymous namespace
+
+/*-------------------------------------------------*/
+
+void simd_binary(const simd_op op, const double* x, const double* y, double* out, const std::size_t n){
+    binary(op, x, 1, y, 1, out, n);
+}
+
+void simd_binary(const simd_op op, const double* x, const double y, double* out, const std::size_t n){
+    binary(op, x, 1, &y, 0, out, n);
+}
+
+void simd_binary(const simd_op op, const double x, const double* y, double* out, const std::size_t n){
+    binary(op, &x, 0, y, 1, out, n);
+}
+
+void simd_exp(const double* x, double* out, const std::size_t n){
+    switch (current_simd_level()){
+#ifdef FLASHER_SIMD_X86
+        case simd_avx512:
+            exp_avx512(x, out, n);
+            return;
+        case simd_avx2:
+            exp_avx2(x, out, n);
+            return;
+#endif
+        default:
+            exp_scalar(x, out, n);
+    }
+}
+
+void simd_log(const double* x, double* out, const std::size_t n){
+    switch (current_simd_level()){
+#ifdef FLASHER_SIMD_X86
+        case simd_avx512:
+            log_avx512(x, out, n);
+            return;
+        case simd_avx2:
+            log_avx2(x, out, n);
+            return;
+#endif
+        default:
+            log_scalar(x, out, n);
+    }
+}
+
+simd_level get_simd_level(){
+    return current_simd_level();
+}
+
+std::string get_simd_level_name(){
+    switch (current_simd_level()){
+        case simd_avx512:
+            return "avx512";
+        case simd_avx2:
+            return "avx2";
+        default:
+            return "scalar";
+    }
+}
+
+void set_simd_level(const simd_level level){
+    if (level > detect_simd_level()){
+        Rcpp::stop("In set_simd_level. The CPU does not support that level.\n");
+    }
+    current_simd_level() = level;
+}
+
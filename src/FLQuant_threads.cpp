@@ -0,0 +1,203 @@
+/*
+ * Copyright 2014 FLR Team. Distributed under the GPL 2 or later
+ * Maintainer: Finlay Scott, JRC
+ */
+
+#include "../inst/include/FLQuant_threads.h"
+#include <Rcpp.h>
+#include <algorithm>
+
+namespace {
+// The number of elements in a chunk. A multiple of the width of the vectorised kernels and of the expression blocks
+// so that chunking does not change which elements go through the vector and scalar code.
+const std::size_t chunk_size = 1 << 14;
+// The default min_size
+const std::size_t default_min_size = 1 << 17;
+// Set while a thread is doing a chunk so that nested calls stay on that thread
+thread_local bool in_chunk = false;
+}
+
+FLQuant_threads::FLQuant_threads() : nthreads(1), min_size(default_min_size), stopping(false), job(0), task(nullptr), nitems(0), chunk_items(1), next_chunk(0), nchunks(0), chunks_done(0) {
+}
+
+FLQuant_threads::~FLQuant_threads(){
+    stop();
+}
+
+FLQuant_threads& FLQuant_threads::get(){
+    static FLQuant_threads pool;
+    return pool;
+}
+
+/*! \brief Set the number of threads, including the calling thread
+ *
+ * 1 switches the pool off.
+ * \param nthreads_in The number of threads.
+ */
+void FLQuant_threads::set_nthreads(const unsigned int nthreads_in){
+    const unsigned int new_nthreads = std::max(nthreads_in, 1u);
+    if (new_nthreads == nthreads){
+        return;
+    }
+    stop();
+    nthreads = new_nthreads;
+    start(nthreads - 1);
+}
+
+unsigned int FLQuant_threads::get_nthreads() const{
+    return nthreads;
+}
+
+void FLQuant_threads::set_min_size(const std::size_t min_size_in){
+    min_size = min_size_in;
+}
+
+std::size_t FLQuant_threads::get_min_size() const{
+    return min_size;
+}
+
+/*! \brief Is work of this many elements shared out
+ *
+ * Not if there is only 1 thread, if it is smaller than min_size, or if it is asked for from inside a chunk.
+ * \param size The number of elements.
+ */
+bool FLQuant_threads::use_threads(const std::size_t size) const{
+    return (nthreads > 1) && (size >= min_size) && !in_chunk;
+}
+
+void FLQuant_threads::start(const unsigned int nworkers){
+    stopping = false;
+    for (unsigned int worker_count = 0; worker_count < nworkers; ++worker_count){
+        workers.emplace_back(&FLQuant_threads::work, this);
+    }
+}
+
+void FLQuant_threads::stop(){
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto& worker : workers){
+        worker.join();
+    }
+    workers.clear();
+}
+
+// Take the next chunk of the current job and do it. False if there are none left.
+bool FLQuant_threads::do_chunk(){
+    std::size_t chunk;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (next_chunk >= nchunks){
+            return false;
+        }
+        chunk = next_chunk++;
+    }
+    const std::size_t first = chunk * chunk_items;
+    const std::size_t last = std::min(first + chunk_items, nitems);
+    in_chunk = true;
+    try {
+        (*task)(first, last);
+    }
+    catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!error){
+            error = std::current_exception();
+        }
+    }
+    in_chunk = false;
+    bool last_chunk = false;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        last_chunk = (++chunks_done == nchunks);
+    }
+    if (last_chunk){
+        done.notify_all();
+    }
+    return true;
+}
+
+void FLQuant_threads::work(){
+    unsigned long last_job = 0;
+    while (true){
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [&] {return stopping || (job != last_job);});
+            if (stopping){
+                return;
+            }
+            last_job = job;
+        }
+        while (do_chunk()){
+        }
+    }
+}
+
+/*! \brief Do a task over items [0, nitems) on the pool and wait for it
+ *
+ * The items are split into chunks of about chunk_size elements. The calling thread does chunks too.
+ * An exception thrown by the task is rethrown here.
+ * \param nitems The number of items.
+ * \param item_size The number of elements worked on for each item.
+ * \param task Does the items [first, last).
+ */
+void FLQuant_threads::run(const std::size_t nitems_in, const std::size_t item_size, const task_type& task_in){
+    if (nitems_in == 0){
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task = &task_in;
+        nitems = nitems_in;
+        chunk_items = std::max(chunk_size / std::max(item_size, std::size_t(1)), std::size_t(1));
+        next_chunk = 0;
+        nchunks = (nitems + chunk_items - 1) / chunk_items;
+        chunks_done = 0;
+        error = nullptr;
+        ++job;
+    }
+    wake.notify_all();
+    while (do_chunk()){
+    }
+    std::exception_ptr job_error;
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [&] {return chunks_done == nchunks;});
+        task = nullptr;
+        job_error = error;
+    }
+    if (job_error){
+        std::rethrow_exception(job_error);
+    }
+}
+
+//'@title Set the number of threads used by FLQuant arithmetic
+//'@description Set the number of threads used for the elementwise operations and sums of large FLQuants in the C++ code.
+//'@name set_flquant_threads
+//
+
+//' Only the double precision FLQuants are shared out, not those that are recorded for the automatic differentiation.
+//' The results are the same whatever the number of threads.
+//' Operations on fewer than \code{min_size} elements are done on a single thread.
+//' The default is a single thread.
+//'@param nthreads The number of threads. 1 turns threading off.
+//'@param min_size The smallest number of elements that is shared out.
+//'@rdname set_flquant_threads
+// [[Rcpp::export]]
+void set_flquant_threads(const int nthreads, const double min_size = 131072){
+    if ((nthreads < 1) || (min_size < 0)){
+        Rcpp::stop("In set_flquant_threads. nthreads must be at least 1 and min_size cannot be negative.\n");
+    }
+    FLQuant_threads& pool = FLQuant_threads::get();
+    pool.set_nthreads(nthreads);
+    pool.set_min_size(static_cast<std::size_t>(min_size));
+}
+
+//' @rdname set_flquant_threads
+// [[Rcpp::export]]
+Rcpp::NumericVector get_flquant_threads(){
+    const FLQuant_threads& pool = FLQuant_threads::get();
+    return Rcpp::NumericVector::create(Rcpp::Named("nthreads", static_cast<double>(pool.get_nthreads())), Rcpp::Named("min_size", static_cast<double>(pool.get_min_size())));
+}
+
@@ -11,6 +11,68 @@ Rcpp::Rostream<true>&  Rcpp::Rcout = Rcpp::Rcpp_cout_get();
 Rcpp::Rostream<false>& Rcpp::Rcerr = Rcpp::Rcpp_cerr_get();
 #endif
 
+// set_single_precision_params
+void set_single_precision_params(const bool single);
+RcppExport SEXP _FLasherEMSRR_set_single_precision_params(SEXP singleSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const bool >::type single(singleSEXP);
+    set_single_precision_params(single);
+    return R_NilValue;
+END_RCPP
+}
+// get_single_precision_params
+bool get_single_precision_params();
+RcppExport SEXP _FLasherEMSRR_get_single_precision_params() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(get_single_precision_params());
+    return rcpp_result_gen;
+END_RCPP
+}
+// set_flquant_threads
+void set_flquant_threads(const int nthreads, const double min_size);
+RcppExport SEXP _FLasherEMSRR_set_flquant_threads(SEXP nthreadsSEXP, SEXP min_sizeSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const int >::type nthreads(nthreadsSEXP);
+    Rcpp::traits::input_parameter< const double >::type min_size(min_sizeSEXP);
+    set_flquant_threads(nthreads, min_size);
+    return R_NilValue;
+END_RCPP
+}
+// get_flquant_threads
+Rcpp::NumericVector get_flquant_threads();
+RcppExport SEXP _FLasherEMSRR_get_flquant_threads() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(get_flquant_threads());
+    return rcpp_result_gen;
+END_RCPP
+}
+// register_srr_plugin
+void register_srr_plugin(const std::string name, SEXP plugin);
+RcppExport SEXP _FLasherEMSRR_register_srr_plugin(SEXP nameSEXP, SEXP pluginSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const std::string >::type name(nameSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type plugin(pluginSEXP);
+    register_srr_plugin(name, plugin);
+    return R_NilValue;
+END_RCPP
+}
+// registered_srr_plugins
+std::vector<std::string> registered_srr_plugins();
+RcppExport SEXP _FLasherEMSRR_registered_srr_plugins() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(registered_srr_plugins());
+    return rcpp_result_gen;
+END_RCPP
+}
 // operatingModelRun
 Rcpp::List operatingModelRun(FLFisheriesAD flfs, fwdBiolsAD biols, const fwdControl ctrl, std::vector<double> effort_max, const double effort_mult_initial, const double indep_min, const double indep_max, const int nr_iters);
 RcppExport SEXP _FLasherEMSRR_operatingModelRun(SEXP flfsSEXP, SEXP biolsSEXP, SEXP ctrlSEXP, SEXP effort_maxSEXP, SEXP effort_mult_initialSEXP, SEXP indep_minSEXP, SEXP indep_maxSEXP, SEXP nr_itersSEXP) {
@@ -31,6 +93,12 @@ END_RCPP
 }
 
 static const R_CallMethodDef CallEntries[] = {
+    {"_FLasherEMSRR_set_single_precision_params", (DL_FUNC) &_FLasherEMSRR_set_single_precision_params, 1},
+    {"_FLasherEMSRR_get_single_precision_params", (DL_FUNC) &_FLasherEMSRR_get_single_precision_params, 0},
+    {"_FLasherEMSRR_set_flquant_threads", (DL_FUNC) &_FLasherEMSRR_set_flquant_threads, 2},
+    {"_FLasherEMSRR_get_flquant_threads", (DL_FUNC) &_FLasherEMSRR_get_flquant_threads, 0},
+    {"_FLasherEMSRR_register_srr_plugin", (DL_FUNC) &_FLasherEMSRR_register_srr_plugin, 2},
+    {"_FLasherEMSRR_registered_srr_plugins", (DL_FUNC) &_FLasherEMSRR_registered_srr_plugins, 0},
     {"_FLasherEMSRR_operatingModelRun", (DL_FUNC) &_FLasherEMSRR_operatingModelRun, 8},
     {NULL, NULL, 0}
 };
@@ -17,11 +17,11 @@ fwdBiol_base<T>::fwdBiol_base(){
     desc = std::string(); 
     range = Rcpp::NumericVector();
     n_flq = FLQuant_base<T>();
-    wt_flq = FLQuant();
-    m_flq = FLQuant();
-    spwn_flq = FLQuant();
-    fec_flq = FLQuant();
-    mat_flq = FLQuant();
+    wt_flq = FLQuant_param();
+    m_flq = FLQuant_param();
+    spwn_flq = FLQuant_param();
+    fec_flq = FLQuant_param();
+    mat_flq = FLQuant_param();
     srr = fwdSR_base<T>();
 }
 
@@ -44,6 +44,7 @@ fwdBiol_base<T>::fwdBiol_base(const SEXP flb_sexp){
     // Make fwdSR from FLBiolcpp model and params with Residuals of 1 and multiplicative
     std::vector<unsigned int> res_dims = m_flq.get_dim();
     res_dims[0] = 1;
+    res_dims[5] = 1; // Iters are recycled
     FLQuant deviances(res_dims, 1.0);
     std::string srmodel = fwdb_s4.slot("srmodel");
     FLQuant srparams = fwdb_s4.slot("srparams");
@@ -54,7 +55,7 @@ fwdBiol_base<T>::fwdBiol_base(const SEXP flb_sexp){
 // Constructor from FLBiol and deviances
 // Use delegated constructor to make fwdBiol first, then add the missing deviances
 template <typename T>
-fwdBiol_base<T>::fwdBiol_base(const SEXP flb_sexp, const FLQuant deviances, const bool deviances_mult) : fwdBiol_base(flb_sexp){
+fwdBiol_base<T>::fwdBiol_base(const SEXP flb_sexp, const FLQuant& deviances, const bool deviances_mult) : fwdBiol_base(flb_sexp){
     auto biol_dim = n().get_dim();
     auto resid_dim = deviances.get_dim();
     if ((biol_dim[1] != resid_dim[1]) || (biol_dim[2] != resid_dim[2]) || (biol_dim[3] != resid_dim[3]) || (biol_dim[4] != resid_dim[4])){
@@ -82,7 +83,7 @@ fwdBiol_base<T>::fwdBiol_base(const SEXP flb_sexp, const fwdSR_base<T> srr_in) :
 // Constructor from FLBiol and fwdSR bits
 // Use delegated constructor
 template <typename T>
-fwdBiol_base<T>::fwdBiol_base(const SEXP flb_sexp, const std::string model_name, const FLQuant params, const FLQuant deviances, const bool deviances_mult) : fwdBiol_base(flb_sexp, fwdSR_base<T>(model_name, params, deviances, deviances_mult)){
+fwdBiol_base<T>::fwdBiol_base(const SEXP flb_sexp, const std::string& model_name, const FLQuant& params, const FLQuant& deviances, const bool deviances_mult) : fwdBiol_base(flb_sexp, fwdSR_base<T>(model_name, params, deviances, deviances_mult)){
 }
 
 // Copy constructor - else members can be pointed at by multiple instances
@@ -118,6 +119,39 @@ fwdBiol_base<T>& fwdBiol_base<T>::operator = (const fwdBiol_base<T>& fwdBiol_sou
 	return *this;
 }
 
+// Move constructor - takes the members of a temporary instead of copying them
+template <typename T>
+fwdBiol_base<T>::fwdBiol_base(fwdBiol_base<T>&& fwdBiol_source) noexcept{
+    name = std::move(fwdBiol_source.name);
+    desc = std::move(fwdBiol_source.desc);
+    range = std::move(fwdBiol_source.range);
+    n_flq = std::move(fwdBiol_source.n_flq);
+    wt_flq = std::move(fwdBiol_source.wt_flq);
+    m_flq = std::move(fwdBiol_source.m_flq);
+    spwn_flq = std::move(fwdBiol_source.spwn_flq);
+    fec_flq = std::move(fwdBiol_source.fec_flq);
+    mat_flq = std::move(fwdBiol_source.mat_flq);
+    srr = std::move(fwdBiol_source.srr);
+}
+
+// Move assignment operator
+template <typename T>
+fwdBiol_base<T>& fwdBiol_base<T>::operator = (fwdBiol_base<T>&& fwdBiol_source) noexcept{
+	if (this != &fwdBiol_source){
+        name = std::move(fwdBiol_source.name);
+        desc = std::move(fwdBiol_source.desc);
+        range = std::move(fwdBiol_source.range);
+        n_flq = std::move(fwdBiol_source.n_flq);
+        wt_flq = std::move(fwdBiol_source.wt_flq);
+        m_flq = std::move(fwdBiol_source.m_flq);
+        spwn_flq = std::move(fwdBiol_source.spwn_flq);
+        fec_flq = std::move(fwdBiol_source.fec_flq);
+        mat_flq = std::move(fwdBiol_source.mat_flq);
+        srr = std::move(fwdBiol_source.srr);
+	}
+	return *this;
+}
+
 /* Intrusive 'wrap' */
 // Returns an FLBiol
 template <typename T>
@@ -139,62 +173,62 @@ fwdBiol_base<T>::operator SEXP() const{
 
 // Get const accessors
 template <typename T>
-FLQuant_base<T> fwdBiol_base<T>::n() const {
+const FLQuant_base<T>& fwdBiol_base<T>::n() const {
     return n_flq;
 }
 
 template <typename T>
-FLQuant_base<T> fwdBiol_base<T>::n(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
+FLQuant_base<T> fwdBiol_base<T>::n(const Index6& indices_min, const Index6& indices_max) const {
     return n_flq(indices_min, indices_max);
 }
 
 template <typename T>
-FLQuant fwdBiol_base<T>::wt() const {
+const FLQuant_param& fwdBiol_base<T>::wt() const {
     return wt_flq;
 }
 
 template <typename T>
-FLQuant fwdBiol_base<T>::wt(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
+FLQuant fwdBiol_base<T>::wt(const Index6& indices_min, const Index6& indices_max) const {
     return wt_flq(indices_min, indices_max);
 }
 
 template <typename T>
-FLQuant fwdBiol_base<T>::m() const {
+const FLQuant_param& fwdBiol_base<T>::m() const {
     return m_flq;
 }
 
 template <typename T>
-FLQuant fwdBiol_base<T>::m(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
+FLQuant fwdBiol_base<T>::m(const Index6& indices_min, const Index6& indices_max) const {
     return m_flq(indices_min, indices_max);
 }
 
 template <typename T>
-FLQuant fwdBiol_base<T>::spwn() const {
+const FLQuant_param& fwdBiol_base<T>::spwn() const {
     return spwn_flq;
 }
 
 template <typename T>
-FLQuant fwdBiol_base<T>::spwn(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
+FLQuant fwdBiol_base<T>::spwn(const Index6& indices_min, const Index6& indices_max) const {
     return spwn_flq(indices_min, indices_max);
 }
 
 template <typename T>
-FLQuant fwdBiol_base<T>::fec() const {
+const FLQuant_param& fwdBiol_base<T>::fec() const {
     return fec_flq;
 }
 
 template <typename T>
-FLQuant fwdBiol_base<T>::fec(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
+FLQuant fwdBiol_base<T>::fec(const Index6& indices_min, const Index6& indices_max) const {
     return fec_flq(indices_min, indices_max);
 }
 
 template <typename T>
-FLQuant fwdBiol_base<T>::mat() const {
+const FLQuant_param& fwdBiol_base<T>::mat() const {
     return mat_flq;
 }
 
 template <typename T>
-FLQuant fwdBiol_base<T>::mat(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
+FLQuant fwdBiol_base<T>::mat(const Index6& indices_min, const Index6& indices_max) const {
     return mat_flq(indices_min, indices_max);
 }
 
@@ -205,35 +239,59 @@ FLQuant_base<T>& fwdBiol_base<T>::n() {
 }
 
 template <typename T>
-FLQuant& fwdBiol_base<T>::wt() {
+FLQuant_param& fwdBiol_base<T>::wt() {
     return wt_flq;
 }
 
 template <typename T>
-FLQuant& fwdBiol_base<T>::m() {
+FLQuant_param& fwdBiol_base<T>::m() {
     return m_flq;
 }
 
 template <typename T>
-FLQuant& fwdBiol_base<T>::spwn() {
+FLQuant_param& fwdBiol_base<T>::spwn() {
     return spwn_flq;
 }
 
 template <typename T>
-FLQuant& fwdBiol_base<T>::fec() {
+FLQuant_param& fwdBiol_base<T>::fec() {
     return fec_flq;
 }
 
 template <typename T>
-FLQuant& fwdBiol_base<T>::mat() {
+FLQuant_param& fwdBiol_base<T>::mat() {
     return mat_flq;
 }
 
 template <typename T>
-fwdSR_base<T> fwdBiol_base<T>::get_srr() const{
+const fwdSR_base<T>& fwdBiol_base<T>::get_srr() const{
     return srr;
 }
 
+// Set the gradient of an SRR that is evaluated in R
+template <typename T>
+void fwdBiol_base<T>::set_srr_gradient(const std::string& gradient_formula){
+    srr.set_gradient(gradient_formula);
+}
+
+// Set the covariates of the SRR, e.g. environmental drivers
+template <typename T>
+void fwdBiol_base<T>::set_srr_covariates(const std::vector<std::string>& covariate_names, const std::vector<FLQuant>& covariates){
+    srr.set_covariates(covariate_names, covariates);
+}
+
+// Approximate an SRR that is evaluated in R by lookup tables
+template <typename T>
+void fwdBiol_base<T>::set_srr_lookup(const srrLookup lookup){
+    srr.set_lookup(lookup);
+}
+
+// Set the generator of SRR deviances
+template <typename T>
+void fwdBiol_base<T>::set_srr_deviance_generator(const srrDevianceGenerator deviance_generator){
+    srr.set_deviance_generator(deviance_generator);
+}
+
 // Total biomass at the beginning of the timestep
 template <typename T>
 FLQuant_base<T> fwdBiol_base<T>::biomass() const {
@@ -243,18 +301,13 @@ FLQuant_base<T> fwdBiol_base<T>::biomass() const {
 
 // Subset biomass
 template <typename T>
-FLQuant_base<T> fwdBiol_base<T>::biomass(const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const { 
+FLQuant_base<T> fwdBiol_base<T>::biomass(const Index5& indices_min, const Index5& indices_max) const { 
     bool verbose = false;
     if(verbose){Rprintf("In fwdBiol::biomass subsetter\n");}
-    if((indices_min.size() != 5) | (indices_max.size() != 5)){
-        Rcpp::stop("In fwdBiol biomass subset. indices not of length 5\n");
-    }
     std::vector<unsigned int> dim = n().get_dim();
     // Add age range to indices
-    std::vector<unsigned int> new_indices_min = indices_min;
-    std::vector<unsigned int> new_indices_max = indices_max;
-    new_indices_min.insert(new_indices_min.begin(), 1);
-    new_indices_max.insert(new_indices_max.begin(), dim[0]);
+    Index6 new_indices_min = add_quant(1, indices_min);
+    Index6 new_indices_max = add_quant(dim[0], indices_max);
     if(verbose){Rprintf("summing\n");}
     FLQuant_base<T> biomass = quant_sum(n_flq(new_indices_min, new_indices_max) * wt_flq(new_indices_min, new_indices_max));
     if(verbose){Rprintf("Done summing\n");}
@@ -300,9 +353,8 @@ unsigned int fwdBiol_base<T>::srp_timelag() const{
 
 // SRR accessors - avoids friends
 template <typename T>
-FLQuant_base<T> fwdBiol_base<T>::predict_recruitment(const FLQuant_base<T> srp, const std::vector<unsigned int> initial_params_indices,
-                                                     const std::string model_name){ 
-    return srr.predict_recruitment(srp, initial_params_indices, model_name);
+FLQuant_base<T> fwdBiol_base<T>::predict_recruitment(const FLQuant_base<T>& srp, const Index5& initial_params_indices) const{ 
+    return srr.predict_recruitment(srp, initial_params_indices);
 }
 
 template <typename T>
@@ -348,6 +400,30 @@ fwdBiols_base<T>::fwdBiols_base(SEXP flbs_sexp){
     // Go through the biols list and make the fwdBiol elements
     for (Rcpp::List flb_list: flbs_list){
         fwdBiol_base<T> flb(flb_list["biol"], flb_list["srr_deviances"], flb_list["srr_deviances_mult"]);
+        // Optional covariates of the SRR - set before the gradient as they set up the SRR again
+        if (flb_list.containsElementNamed("srr_covariates")){
+            Rcpp::List covariates_list = flb_list["srr_covariates"];
+            std::vector<std::string> covariate_names = Rcpp::as<std::vector<std::string> >(covariates_list.names());
+            std::vector<FLQuant> covariates;
+            for (SEXP covariate_sexp : covariates_list){
+                covariates.emplace_back(covariate_sexp);
+            }
+            flb.set_srr_covariates(covariate_names, covariates);
+        }
+        // Optional gradient of the SRR
+        if (flb_list.containsElementNamed("srr_gradient")){
+            flb.set_srr_gradient(Rcpp::as<std::string>(flb_list["srr_gradient"]));
+        }
+        // Optional lookup tables of the SRR - after the gradient which they replace
+        if (flb_list.containsElementNamed("srr_lookup")){
+            SEXP lookup_sexp = flb_list["srr_lookup"];
+            flb.set_srr_lookup(srrLookup(lookup_sexp));
+        }
+        // Optional generator of SRR deviances
+        if (flb_list.containsElementNamed("srr_deviance_generator")){
+            SEXP generator_sexp = flb_list["srr_deviance_generator"];
+            flb.set_srr_deviance_generator(srrDevianceGenerator(generator_sexp));
+        }
         biols.emplace_back(flb);
 }
     names = flbs_list.names();
@@ -389,6 +465,23 @@ fwdBiols_base<T>& fwdBiols_base<T>::operator = (const fwdBiols_base<T>& fwdBiols
 	return *this;
 }
 
+// Move constructor - takes the members of a temporary instead of copying them
+template<typename T>
+fwdBiols_base<T>::fwdBiols_base(fwdBiols_base<T>&& fwdBiols_source) noexcept{
+	biols = std::move(fwdBiols_source.biols);
+    names = std::move(fwdBiols_source.names);
+}
+
+// Move assignment operator
+template<typename T>
+fwdBiols_base<T>& fwdBiols_base<T>::operator = (fwdBiols_base<T>&& fwdBiols_source) noexcept{
+	if (this != &fwdBiols_source){
+        biols  = std::move(fwdBiols_source.biols);
+        names = std::move(fwdBiols_source.names);
+	}
+	return *this;
+}
+
 template<typename T>
 unsigned int fwdBiols_base<T>::get_nbiols() const {
     return biols.size();
@@ -396,7 +489,7 @@ unsigned int fwdBiols_base<T>::get_nbiols() const {
 
 // Get only data accessor - single element - starts at 1
 template <typename T>
-fwdBiol_base<T> fwdBiols_base<T>::operator () (const unsigned int element) const{
+const fwdBiol_base<T>& fwdBiols_base<T>::operator () (const unsigned int element) const{
     if (element > get_nbiols()){
         Rcpp::stop("fwdBiols_base: Trying to access element larger than data size.");
     }
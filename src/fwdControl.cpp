@@ -73,6 +73,25 @@ fwdControl& fwdControl::operator = (const fwdControl& fwdControl_source){
 	return *this;
 }
 
+// Move constructor - takes the members of a temporary instead of copying them
+fwdControl::fwdControl(fwdControl&& fwdControl_source) noexcept{
+    target = std::move(fwdControl_source.target);
+    target_iters = std::move(fwdControl_source.target_iters);
+    target_map = std::move(fwdControl_source.target_map);
+    FCB = std::move(fwdControl_source.FCB);
+}
+
+// Move assignment operator
+fwdControl& fwdControl::operator = (fwdControl&& fwdControl_source) noexcept{
+	if (this != &fwdControl_source){
+        target = std::move(fwdControl_source.target);
+        target_iters = std::move(fwdControl_source.target_iters);
+        target_map = std::move(fwdControl_source.target_map);
+        FCB = std::move(fwdControl_source.FCB);
+	}
+	return *this;
+}
+
 Rcpp::DataFrame fwdControl::get_target() const{
     return target;
 }
@@ -237,7 +256,7 @@ std::vector<double> fwdControl::get_target_value(const int target_no, const int
  * \param target_no The target number as given by the target column in the control dataframe.
  * \param col The name of the integer column in the control dataframe.
  */
-Rcpp::IntegerVector fwdControl::get_target_int_col(const int target_no, const std::string col) const {
+Rcpp::IntegerVector fwdControl::get_target_int_col(const int target_no, const std::string& col) const {
     // Check that column exists in data.frame
     std::vector<std::string> names = target.attr("names");
     auto it = std::find(names.begin(), names.end(), col);
@@ -260,7 +279,7 @@ Rcpp::IntegerVector fwdControl::get_target_int_col(const int target_no, const st
  * \param sim_target_no The simultaneous target number
  * \param col The name of the integer column in the control dataframe.
  */
-unsigned int fwdControl::get_target_int_col(const int target_no, const int sim_target_no, const std::string col) const {
+unsigned int fwdControl::get_target_int_col(const int target_no, const int sim_target_no, const std::string& col) const {
     Rcpp::IntegerVector values = get_target_int_col(target_no, col);
     if (sim_target_no > values.size()){
         Rcpp::stop("In fwdControl::get_target_int_col. sim_target_no is too big\n");
@@ -271,7 +290,7 @@ unsigned int fwdControl::get_target_int_col(const int target_no, const int sim_t
 
 // For multiple Biols in the biol column
 // The column is a list - return it
-Rcpp::List fwdControl::get_target_list_int_col(const int target_no, const std::string col) const {
+Rcpp::List fwdControl::get_target_list_int_col(const int target_no, const std::string& col) const {
     // Check that column exists in data.frame
     std::vector<std::string> names = target.attr("names");
     auto it = std::find(names.begin(), names.end(), col);
@@ -289,7 +308,7 @@ Rcpp::List fwdControl::get_target_list_int_col(const int target_no, const std::s
 
 // For multiple Biols in the biol column
 // The column is a list - each element is a vector of ints
-Rcpp::IntegerVector fwdControl::get_target_list_int_col(const int target_no, const int sim_target_no, const std::string col) const {
+Rcpp::IntegerVector fwdControl::get_target_list_int_col(const int target_no, const int sim_target_no, const std::string& col) const {
     Rcpp::List values = get_target_list_int_col(target_no, col);
     if (sim_target_no > values.size()){
         Rcpp::stop("In fwdControl::get_target_list_int_col. sim_target_no is too big\n");
@@ -307,7 +326,7 @@ Rcpp::IntegerVector fwdControl::get_target_list_int_col(const int target_no, con
  * Can be used on non-Numeric columns (no check is made) but who knows what the result will be?!?!
  * \param target_no References the target column in the control dataframe.
  */
-Rcpp::NumericVector fwdControl::get_target_num_col(const int target_no, const std::string col) const {
+Rcpp::NumericVector fwdControl::get_target_num_col(const int target_no, const std::string& col) const {
     // Check that column exists in data.frame
     std::vector<std::string> names = target.attr("names");
     auto it = std::find(names.begin(), names.end(), col);
@@ -330,7 +349,7 @@ Rcpp::NumericVector fwdControl::get_target_num_col(const int target_no, const st
  * \param target_no References the target column in the control dataframe.
  * \param sim_target_no The simultaneous target number
  */
-double fwdControl::get_target_num_col(const int target_no, const int sim_target_no, const std::string col) const {
+double fwdControl::get_target_num_col(const int target_no, const int sim_target_no, const std::string& col) const {
     Rcpp::NumericVector values = get_target_num_col(target_no, col);
     if (sim_target_no > values.size()){
         Rcpp::stop("In fwdControl::get_target_int_col. sim_target_no is too big\n");
@@ -362,7 +381,7 @@ fwdControlTargetType fwdControl::get_target_type(const int target_no, const int
     return get_target_type(quantity);
 }
 
-fwdControlTargetType fwdControl::get_target_type(const std::string quantity) const{
+fwdControlTargetType fwdControl::get_target_type(const std::string& quantity) const{
     target_map_type::const_iterator type_pair_found = target_map.find(quantity);
     if (type_pair_found == target_map.end()){
         Rcpp::stop("Unable to find target quantity in fwdControl target_map\n");
@@ -6,58 +6,615 @@
 #include "../inst/include/fwdSR.h"
 #include "../inst/include/adouble_converter.h" // used for converting SEXP types to adouble
 #include <Rcpp.h>
+#include <cctype>
 using namespace Rcpp;
 
+/*-------------------------------------------------*/
+// Helpers for setting up and evaluating the SR model
+namespace {
+// The formulas of the SRR functions, as written in FLCore, used to recognise them
+struct srr_library_entry {
+    std::string model_name; // Name in the model map
+    std::string formula;
+    std::vector<std::string> param_names; // In the order used by the SRR function
+};
+
+std::vector<srr_library_entry> srr_formula_library(){
+    std::vector<srr_library_entry> library = {
+        {"bevholt", "a * ssb / (b + ssb)", {"a", "b"}},
+        {"bevholtDa", "a / (1 + (b / ssb)^d)", {"a", "b", "d"}},
+        {"ricker", "a * ssb * exp(-b * ssb)", {"a", "b"}},
+        {"geomean", "a", {"a"}},
+        {"bevholtSS3", "(4 * s * R0 * ssb) / (v * (1 - s) + ssb * (5 * s - 1))", {"s", "R0", "v"}},
+        {"cushing", "a * ssb^b", {"a", "b"}},
+        {"segreg", "ifelse(ssb <= b, a * ssb, a * b)", {"a", "b"}},
+        {"segregDa", "ifelse(ssb^d <= b, a * ssb^d, a * b)", {"a", "b", "d"}},
+        {"bevholtsig", "a / ((b / ssb)^c + 1)", {"a", "b", "c"}}};
+    return library;
+}
+
+// The name of the SR function if the formula is a call to it with the SRP and the params, e.g. my_srr(ssb, params)
+std::string srr_call_name(const std::string& rhs){
+    std::string compact;
+    for (const char character : rhs){
+        if (!std::isspace(static_cast<unsigned char>(character))){
+            compact += character;
+        }
+    }
+    const std::vector<std::string> call_args = {"(ssb,params)", "(srp,params)"};
+    for (const std::string& args : call_args){
+        if ((compact.size() > args.size()) && (compact.compare(compact.size() - args.size(), args.size(), args) == 0)){
+            return compact.substr(0, compact.size() - args.size());
+        }
+    }
+    return "";
+}
+
+// Does the parsed R expression use the symbol, e.g. 'params'
+bool uses_symbol(SEXP expression, SEXP symbol){
+    if (expression == symbol){
+        return true;
+    }
+    if ((TYPEOF(expression) == LANGSXP) || (TYPEOF(expression) == LISTSXP)){
+        for (SEXP node = expression; node != R_NilValue; node = CDR(node)){
+            if (uses_symbol(CAR(node), symbol)){
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/*! \brief Evaluates the SR model in R for a batch of SRP values
+ *
+ * The cached R expression is evaluated once with 'ssb' as a vector of all the SRP values and each parameter, by name, as a vector of its values for each SRP value.
+ * If the parameters are the same for all SRP values each parameter is a single value and 'params' is also set as a named vector, as in a single evaluation.
+ * If the parameters differ between SRP values (e.g. they vary by iter) and the expression uses 'params', or the expression fails or does not return one value per SRP value (i.e. it is not vectorised),
+ * it is evaluated one SRP value at a time, with the named parameters of that value.
+ * \param r_expression The parsed formula (or gradient formula).
+ * \param r_env The environment the formula is evaluated in.
+ * \param param_names The names of the SR parameters.
+ * \param uses_params Does the expression use 'params'.
+ * \param srp_values The SRP values.
+ * \param params_values The SR parameters for each SRP value, with the parameters varying fastest (length nparams * number of SRP values).
+ */
+std::vector<double> eval_model_r(const Rcpp::RObject& r_expression, Rcpp::Environment r_env, const std::vector<std::string>& param_names, const bool uses_params,
+                                 const std::vector<double>& srp_values, const std::vector<double>& params_values){
+    const unsigned int nvalues = srp_values.size();
+    const unsigned int nparams = param_names.size();
+    bool same_params = true;
+    for (unsigned int param_count = nparams; (param_count < params_values.size()) && same_params; ++param_count){
+        same_params = (params_values[param_count] == params_values[param_count % nparams]);
+    }
+    if (same_params || !uses_params){
+        r_env.assign("ssb", Rcpp::NumericVector(srp_values.begin(), srp_values.end()));
+        if (same_params){
+            Rcpp::NumericVector params_nv(params_values.begin(), params_values.begin() + nparams);
+            params_nv.attr("names") = param_names;
+            r_env.assign("params", params_nv);
+        }
+        for (unsigned int param_count = 0; param_count < nparams; ++param_count){
+            if (!param_names[param_count].empty()){
+                if (same_params){
+                    r_env.assign(param_names[param_count], params_values[param_count]);
+                }
+                else {
+                    Rcpp::NumericVector param_nv(nvalues);
+                    for (unsigned int value_count = 0; value_count < nvalues; ++value_count){
+                        param_nv[value_count] = params_values[value_count * nparams + param_count];
+                    }
+                    r_env.assign(param_names[param_count], param_nv);
+                }
+            }
+        }
+        if (nvalues == 1){
+            return std::vector<double>(1, Rcpp::as<double>(Rcpp_eval(r_expression, r_env)));
+        }
+        // An error may mean that the function does not work with vectors
+        bool vector_error = false;
+        Rcpp::NumericVector rec_nv;
+        try {
+            rec_nv = Rcpp_eval(r_expression, r_env);
+        }
+        catch (Rcpp::eval_error& e){
+            vector_error = true;
+        }
+        if (!vector_error){
+            if (static_cast<unsigned int>(rec_nv.size()) == nvalues){
+                return std::vector<double>(rec_nv.begin(), rec_nv.end());
+            }
+            // Model does not depend on the SRP - only if the parameters are the same, else the function is not vectorised
+            if (same_params && (rec_nv.size() == 1)){
+                return std::vector<double>(nvalues, rec_nv[0]);
+            }
+        }
+    }
+    // Not vectorised, or uses params that differ - evaluate one value at a time
+    std::vector<double> rec(nvalues);
+    for (unsigned int value_count = 0; value_count < nvalues; ++value_count){
+        std::vector<double> model_params(params_values.begin() + value_count * nparams, params_values.begin() + (value_count + 1) * nparams);
+        rec[value_count] = eval_model_r(r_expression, r_env, param_names, uses_params, std::vector<double>(1, srp_values[value_count]), model_params)[0];
+    }
+    return rec;
+}
+
+// Pick the plugin function for the type of the model map
+void set_plugin_model(const srr_plugin& plugin, double (*&model)(const double, const srrParams&)){
+    model = plugin.model_double;
+}
+
+void set_plugin_model(const srr_plugin& plugin, adouble (*&model)(const adouble, const srrParams&)){
+    model = plugin.model_adouble;
+}
+} // anonymous namespace
+
+/*-------------------------------------------------*/
+// SRR plugins
+
+/*! \brief The registry of SRR plugins
+ *
+ * Maps the names of the registered SR functions to their instantiations.
+ * The registry lasts for the R session. The code of the functions must stay loaded (e.g. the DLL made by Rcpp::cppFunction).
+ */
+std::map<std::string, srr_plugin>& get_srr_plugins(){
+    static std::map<std::string, srr_plugin> srr_plugins;
+    return srr_plugins;
+}
+
+//'@title Register a compiled SR function
+//'@description Register a C++ SR function so that it can be used in projections without calling R.
+//'@name register_srr_plugin
+//
+
+//' The SR function must be templated and have the signature
+//' \code{template <typename T> T my_srr(const T srp, const srrParams& params)}.
+//' It is compiled with \code{Rcpp::cppFunction} and \code{inlineCxxPlugin}, along with a function that returns
+//' \code{make_srr_plugin(&my_srr<double>, &my_srr<adouble>)}.
+//' Once registered, it is used with the formula \code{rec ~ my_srr(ssb, params)} or the model name.
+//' The params are passed in the order of the FLPar.
+//' Registering a name again replaces the previous function.
+//'@param name The name of the SR function.
+//'@param plugin The external pointer returned by make_srr_plugin().
+//'@rdname register_srr_plugin
+// [[Rcpp::export]]
+void register_srr_plugin(const std::string name, SEXP plugin){
+    if ((TYPEOF(plugin) != EXTPTRSXP) || (R_ExternalPtrAddr(plugin) == NULL)){
+        Rcpp::stop("In register_srr_plugin. plugin must be the external pointer returned by make_srr_plugin().\n");
+    }
+    Rcpp::XPtr<srr_plugin> plugin_ptr(plugin);
+    if ((plugin_ptr->model_double == nullptr) || (plugin_ptr->model_adouble == nullptr)){
+        Rcpp::stop("In register_srr_plugin. plugin must have both the double and adouble functions.\n");
+    }
+    // Built in SR functions cannot be replaced
+    fwdSR_base<double> built_in;
+    built_in.init_model_map();
+    if (built_in.has_model(name) && (get_srr_plugins().count(name) == 0)){
+        Rcpp::stop("In register_srr_plugin. Cannot replace the SR function '%s' of the package.\n", name);
+    }
+    get_srr_plugins()[name] = *plugin_ptr;
+}
+
+//' @rdname register_srr_plugin
+// [[Rcpp::export]]
+std::vector<std::string> registered_srr_plugins(){
+    std::vector<std::string> names;
+    for (const std::pair<const std::string, srr_plugin>& plugin : get_srr_plugins()){
+        names.push_back(plugin.first);
+    }
+    return names;
+}
+
 /*-------------------------------------------------*/
 // Templated class
 
 /*! \brief Initialises the model map of SR functions
  *
- * The model map maps the names of SR functions to the addresses of the SR functions contained in the package.
+ * The model map maps the names of SR functions to the addresses of the SR functions contained in the package
+ * and of the registered SRR plugins.
  * This method initialises it.
  */
 template <typename T>
 void fwdSR_base<T>::init_model_map(){
     // Fill up the map
-    map_model_name_to_function["customSRR"] = &customSRR;
-    map_model_name_to_function["CustomSRR"] = &customSRR;
+    map_model_name_to_function["bevholt"] = &bevholt;
+    map_model_name_to_function["bevholtDa"] = &bevholtDa;
+    map_model_name_to_function["ricker"] = &ricker;
+    map_model_name_to_function["constant"] = &constant;
+    map_model_name_to_function["geomean"] = &constant;
+    map_model_name_to_function["bevholtSS3"] = &bevholtSS3;
+    map_model_name_to_function["cushing"] = &cushing;
+    map_model_name_to_function["segreg"] = &segreg;
+    map_model_name_to_function["segregDa"] = &segregDa;
+    map_model_name_to_function["survsrr"] = &survsrr;
+    map_model_name_to_function["bevholtsig"] = &bevholtsig;
+    map_model_name_to_function["mixedsrr"] = &mixedsrr;
+    for (const std::pair<const std::string, srr_plugin>& plugin : get_srr_plugins()){
+        srr_model_ptr plugin_model = nullptr;
+        set_plugin_model(plugin.second, plugin_model);
+        map_model_name_to_function[plugin.first] = plugin_model;
+    }
     return;
 }
 
+/*! \brief Is there an SR function with this name in the model map
+ */
+template <typename T>
+bool fwdSR_base<T>::has_model(const std::string& name) const{
+    return map_model_name_to_function.count(name) > 0;
+}
+
 /*! \brief Empty constructor that creates empty members
  */
 template <typename T>
 fwdSR_base<T>::fwdSR_base(){
+    model = nullptr;
+    pass_covariates = false;
+    cell_nparams = 0;
+    sratio = 1.0;
 }
 
 /*! \brief Main constructor for the fwdSR class
  *
- * Sets the function pointer to point at the correct SR function.
+ * Sets how the SR model is evaluated, in order of preference:
+ * - The model name is the name of an SR function in the model map (including the SRR plugins), or a call to it e.g. my_srr(ssb, params).
+ * - The model formula is recognised as one of the SR functions in the model map (e.g. the FLCore bevholt formula).
+ * - The model formula is compiled into a native expression tree.
+ * - The model formula is evaluated in R.
+ * In the first three cases the SRR is evaluated without calling R and the derivatives of recruitment are recorded on the tape.
  * Assumes all dimensions (e.g. of deviances and parameters) have been checked in R (no checks made here).
  *
- * \param model_name The name of the SR function (must be present in the model map else it fails).
+ * \param model_name The name of the SR function or the SR formula.
  * \param params_ip The SR parameters. The parameters are stored in the first dimension and can be disaggregated by time, area etc.
  * \param deviances_ip Residuals that can be applied to the predicted recruitment.
  * \param deviances_mult_ip Are the deviances multiplicative (true) or additive (false).
  */
 template <typename T>
-fwdSR_base<T>::fwdSR_base(const std::string model_name_ip, const FLQuant params_ip, const FLQuant deviances_ip, const bool deviances_mult_ip) {
+fwdSR_base<T>::fwdSR_base(const std::string& model_name_ip, const FLQuant& params_ip, const FLQuant& deviances_ip, const bool deviances_mult_ip) {
     model_name = model_name_ip;
     // std::cout << model_name; // print for debugging
     params = params_ip;
     deviances = deviances_ip;
     deviances_mult = deviances_mult_ip;
     init_model_map();
-    // Set the model pointer
-    // always map to the customSRR-function as nothing else is defined
-    typename model_map_type::const_iterator model_pair_found = map_model_name_to_function.find("customSRR");
-    //std::cout << model_pair_found; // print for debugging
+    init_model();
+    init_params_tables();
+    init_sratio();
+} 
+
+/*! \brief Set how the SR model is evaluated
+ *
+ * The formula is compiled with the names of the parameters, from the first dimension of params, followed by the names of the covariates.
+ * The covariates are passed to the SR model after the parameters, except to the SR functions of the package which do not use them.
+ */
+template <typename T>
+void fwdSR_base<T>::init_model(){
+    std::vector<std::string> param_names = params.get_dimnames()[0];
+    param_names.resize(get_nparams());
+    param_names.insert(param_names.end(), covariate_names.begin(), covariate_names.end());
+    // Drop the left hand side of the formula and any surrounding whitespace
+    std::string rhs = model_name;
+    std::string::size_type tilde = rhs.find('~');
+    if (tilde != std::string::npos){
+        rhs.erase(0, tilde + 1);
+    }
+    rhs.erase(0, rhs.find_first_not_of(" \t\n"));
+    rhs.erase(rhs.find_last_not_of(" \t\n") + 1);
+    model = nullptr;
+    model_params_order.clear();
+    formula.reset();
+    r_atomic.reset();
+    pass_covariates = true;
+    // Set the model pointer if the name of an SR function, or a call to it with the SRP and params, has been passed in
+    typename model_map_type::const_iterator model_pair_found = map_model_name_to_function.find(rhs);
+    if (model_pair_found == map_model_name_to_function.end()){
+        model_pair_found = map_model_name_to_function.find(srr_call_name(rhs));
+    }
     if (model_pair_found != map_model_name_to_function.end()){
         model = model_pair_found->second; // pulls out value - the address of the SR function
+        pass_covariates = (get_srr_plugins().count(model_pair_found->first) > 0);
     }
-    else
-        Rcpp::stop("SRR model not found\n");
-} 
+    else {
+        formula = std::make_shared<const srrFormula>(model_name, param_names);
+        if (formula->is_native()){
+            recognise_model(param_names);
+            pass_covariates = (model == nullptr);
+        }
+        // If it cannot be compiled, parse the formula once for evaluating in R
+        // It is evaluated in a child of the global environment so that user functions are found without the SRP and params being written to the global environment
+        else {
+            Rcpp::Function parse_func = Rcpp::Environment::base_env()["parse"];
+            SEXP expressions = parse_func(Rcpp::_["text"] = rhs);
+            r_expression = VECTOR_ELT(expressions, 0);
+            r_env = Rcpp::Environment::global_env().new_child(true);
+            make_r_atomic();
+        }
+    }
+}
+
+/*! \brief Precompute the parameter tables and the recruitment schedule
+ *
+ * The parameters, followed by any covariates, of each year, unit, season, area and iter are stored in the order that they are passed to the SR model
+ * (i.e. reordered for a recognised SR function), with a flag for whether any of them are NA.
+ * The tables cover the largest of each dimension of the params and covariates, which are recycled.
+ * The recruitment schedule stores, for each year, unit and season (first area and iter), if recruitment happens in that season
+ * and if it has happened by the end of that season. 
+ * Evaluating the SR model and checking the schedule are then lookups without any allocation.
+ */
+template <typename T>
+void fwdSR_base<T>::init_params_tables(){
+    const unsigned int nparams = params.get_nquant();
+    const unsigned int ncovariates = pass_covariates ? covariates.size() : 0;
+    table_dim = params.get_dim();
+    for (const FLQuant& covariate : covariates){
+        std::vector<unsigned int> covariate_dim = covariate.get_dim();
+        for (unsigned int dim_count = 1; dim_count < 6; ++dim_count){
+            table_dim[dim_count] = std::max(table_dim[dim_count], covariate_dim[dim_count]);
+        }
+    }
+    const unsigned int ncells = table_dim[1] * table_dim[2] * table_dim[3] * table_dim[4] * table_dim[5];
+    const bool reorder = (model != nullptr) && !model_params_order.empty();
+    cell_nparams = (reorder ? model_params_order.size() : nparams) + ncovariates;
+    cell_params.assign(ncells * cell_nparams, 0.0);
+    cell_params_na.assign(ncells, false);
+    for (unsigned int iter = 1; iter <= table_dim[5]; ++iter){
+        for (unsigned int area = 1; area <= table_dim[4]; ++area){
+            for (unsigned int season = 1; season <= table_dim[3]; ++season){
+                for (unsigned int unit = 1; unit <= table_dim[2]; ++unit){
+                    for (unsigned int year = 1; year <= table_dim[1]; ++year){
+                        const unsigned int cell = params_cell(year, unit, season, area, iter);
+                        double* model_params = cell_params.data() + cell * cell_nparams;
+                        if (reorder){
+                            for (unsigned int param_count = 0; param_count < model_params_order.size(); ++param_count){
+                                *model_params++ = recycled_value(params, model_params_order[param_count] + 1, year, unit, season, area, iter);
+                            }
+                        }
+                        else {
+                            for (unsigned int param_count = 0; param_count < nparams; ++param_count){
+                                *model_params++ = recycled_value(params, param_count + 1, year, unit, season, area, iter);
+                            }
+                        }
+                        for (unsigned int param_count = 1; param_count <= nparams; ++param_count){
+                            if (Rcpp::NumericVector::is_na(recycled_value(params, param_count, year, unit, season, area, iter))){
+                                cell_params_na[cell] = true;
+                            }
+                        }
+                        for (unsigned int covariate_count = 0; covariate_count < ncovariates; ++covariate_count){
+                            const double covariate_value = recycled_value(covariates[covariate_count], 1, year, unit, season, area, iter);
+                            if (Rcpp::NumericVector::is_na(covariate_value)){
+                                cell_params_na[cell] = true;
+                            }
+                            *model_params++ = covariate_value;
+                        }
+    }}}}}
+    // Recruitment schedule from the first parameter of the first area and iter
+    recruitment_happens.assign(table_dim[1] * table_dim[2] * table_dim[3], false);
+    recruitment_happened.assign(table_dim[1] * table_dim[2] * table_dim[3], false);
+    for (unsigned int year = 1; year <= table_dim[1]; ++year){
+        for (unsigned int unit = 1; unit <= table_dim[2]; ++unit){
+            bool happened = false;
+            for (unsigned int season = 1; season <= table_dim[3]; ++season){
+                const unsigned int cell = params_cell(year, unit, season, 1, 1);
+                const bool happens = (nparams > 0) && !Rcpp::NumericVector::is_na(recycled_value(params, 1, year, unit, season, 1, 1));
+                happened = happened || happens;
+                recruitment_happens[cell] = happens;
+                recruitment_happened[cell] = happened;
+            }
+        }
+    }
+}
+
+/*! \brief Value of an FLQuant with recycling
+ *
+ * If the requested index is bigger than that dimension of the FLQuant then the first one is used.
+ * The indices start at 1.
+ */
+template <typename T>
+double fwdSR_base<T>::recycled_value(const FLQuant& flq, unsigned int quant, unsigned int year, unsigned int unit, unsigned int season, unsigned int area, unsigned int iter) const{
+    std::vector<unsigned int> flq_dim = flq.get_dim();
+    return flq(quant, (year > flq_dim[1]) ? 1 : year, (unit > flq_dim[2]) ? 1 : unit, (season > flq_dim[3]) ? 1 : season,
+        (area > flq_dim[4]) ? 1 : area, (iter > flq_dim[5]) ? 1 : iter);
+}
+
+/*! \brief Position in the parameter tables
+ *
+ * Parameters get recycled, i.e. if the requested index is bigger than that dimension of the tables then the first one is used.
+ * The indices start at 1.
+ */
+template <typename T>
+unsigned int fwdSR_base<T>::params_cell(unsigned int year, unsigned int unit, unsigned int season, unsigned int area, unsigned int iter) const{
+    if (year > table_dim[1]){
+        year = 1;
+    }
+    if (unit > table_dim[2]){
+        unit = 1;
+    }
+    if (season > table_dim[3]){
+        season = 1;
+    }
+    if (area > table_dim[4]){
+        area = 1;
+    }
+    if (iter > table_dim[5]){
+        iter = 1;
+    }
+    return (year - 1) + table_dim[1] * ((unit - 1) + table_dim[2] * ((season - 1) + table_dim[3] * ((area - 1) + table_dim[4] * (iter - 1))));
+}
+
+/*! \brief Parameters and covariates of a cell of the parameter table
+ *
+ * A view of the table, no data is copied.
+ * \param cell The position of the cell, from params_cell().
+ */
+template <typename T>
+srrParams fwdSR_base<T>::get_cell_params(const unsigned int cell) const{
+    return srrParams(cell_params.data() + cell * cell_nparams, cell_nparams);
+}
+
+/*! \brief Set the covariates of the SR model
+ *
+ * Each covariate (e.g. sea temperature) is an FLQuant of length 1 in the first dimension that is recycled over the other dimensions like the parameters.
+ * Formulas refer to the covariates by name, e.g. rec ~ a * ssb * exp(-b * ssb + c * sst).
+ * SRR plugins get them after the parameters, in the same order as the covariate names.
+ * The SR model is set up again with the new covariates.
+ * \param covariate_names_ip The names of the covariates.
+ * \param covariates_ip The covariates.
+ */
+template <typename T>
+void fwdSR_base<T>::set_covariates(const std::vector<std::string>& covariate_names_ip, const std::vector<FLQuant>& covariates_ip){
+    if (covariate_names_ip.size() != covariates_ip.size()){
+        Rcpp::stop("In fwdSR::set_covariates. There must be a name for each covariate.\n");
+    }
+    for (const FLQuant& covariate : covariates_ip){
+        if (covariate.get_nquant() != 1){
+            Rcpp::stop("In fwdSR::set_covariates. Covariates must be of length 1 in the first dimension.\n");
+        }
+    }
+    covariate_names = covariate_names_ip;
+    covariates = covariates_ip;
+    init_model();
+    init_params_tables();
+}
+
+/*! \brief The names of the covariates of the SR model
+ */
+template <typename T>
+std::vector<std::string> fwdSR_base<T>::get_covariate_names() const{
+    return covariate_names;
+}
+
+/*! \brief Set the sex ratio of recruitment from the unit names of the deviances
+ *
+ * If there are two units called 'F' and 'M' half of the recruitment goes to each, else the ratio is 1.
+ */
+template <typename T>
+void fwdSR_base<T>::init_sratio(){
+    sratio = 1.0;
+    std::vector<unsigned int> res_dim = deviances.get_dim();
+    if ((res_dim.size() > 2) && (res_dim[2] == 2)){
+        std::vector<std::string> unit_names = deviances.get_dimnames()[2];
+        std::sort(unit_names.begin(), unit_names.end());
+        std::vector<std::string> sex = { "F", "M" };
+        if (unit_names == sex){
+            sratio = 0.5;
+        }
+    }
+}
+
+/*! \brief Make the atomic operation that evaluates the SR model in R
+ *
+ * Recruitment is evaluated with the cached R expression.
+ * The derivatives with respect to the SRP are evaluated with the gradient expression, if there is one, else by central differences.
+ * If lookup tables are used, the R expression is only called to build them and recruitment and its derivative come from the tables.
+ */
+template <typename T>
+void fwdSR_base<T>::make_r_atomic(){
+    const Rcpp::RObject rec_expression = r_expression;
+    const Rcpp::RObject gradient_expression = r_gradient_expression;
+    const Rcpp::Environment env = r_env;
+    const std::vector<std::string> param_names = formula->get_param_names();
+    const bool rec_uses_params = uses_symbol(rec_expression, Rf_install("params"));
+    srrAtomic::batch_function_type rec_function = [rec_expression, env, param_names, rec_uses_params](const std::vector<double>& srp_values, const std::vector<double>& params_values){
+        return eval_model_r(rec_expression, env, param_names, rec_uses_params, srp_values, params_values);
+    };
+    srrAtomic::batch_function_type gradient_function;
+    if (!Rf_isNull(gradient_expression)){
+        const bool gradient_uses_params = uses_symbol(gradient_expression, Rf_install("params"));
+        gradient_function = [gradient_expression, env, param_names, gradient_uses_params](const std::vector<double>& srp_values, const std::vector<double>& params_values){
+            return eval_model_r(gradient_expression, env, param_names, gradient_uses_params, srp_values, params_values);
+        };
+    }
+    if (lookup){
+        std::shared_ptr<srrLookup> tables = std::make_shared<srrLookup>(*lookup);
+        tables->set_rec_function(rec_function);
+        lookup = tables;
+        rec_function = [tables](const std::vector<double>& srp_values, const std::vector<double>& params_values){
+            return tables->eval(srp_values, params_values);
+        };
+        gradient_function = [tables](const std::vector<double>& srp_values, const std::vector<double>& params_values){
+            return tables->gradient(srp_values, params_values);
+        };
+    }
+    r_atomic = std::make_shared<srrAtomic>("srr_" + model_name, rec_function, gradient_function);
+}
+
+/*! \brief Approximate an SR model that is evaluated in R by lookup tables
+ *
+ * The SRR is tabulated once for each parameter set and then evaluated with a monotone spline, with its analytic derivative,
+ * so the cost of recruitment no longer depends on how expensive the R function is.
+ * It is ignored if the SR model is evaluated natively.
+ * \param new_lookup The settings of the lookup tables.
+ */
+template <typename T>
+void fwdSR_base<T>::set_lookup(const srrLookup new_lookup){
+    if (!r_atomic){
+        return;
+    }
+    lookup = std::make_shared<srrLookup>(new_lookup);
+    make_r_atomic();
+}
+
+/*! \brief Largest error of the lookup tables at their check points, relative to the largest recruitment in each table
+ *
+ * NA if lookup tables are not used.
+ */
+template <typename T>
+double fwdSR_base<T>::get_lookup_error() const{
+    if (!lookup){
+        return NA_REAL;
+    }
+    return lookup->get_max_error();
+}
+
+/*! \brief Set the gradient of an SR model that is evaluated in R
+ *
+ * The gradient is the derivative of recruitment with respect to the SRP, as a formula in ssb and the parameters (e.g. "a * b / (b + ssb)^2").
+ * It is used instead of central differences. It is ignored if the SR model is evaluated natively.
+ * \param gradient_formula The gradient formula. The left hand side, if any, is dropped.
+ */
+template <typename T>
+void fwdSR_base<T>::set_gradient(const std::string& gradient_formula){
+    if (!r_atomic){
+        return;
+    }
+    std::string rhs = gradient_formula;
+    std::string::size_type tilde = rhs.find('~');
+    if (tilde != std::string::npos){
+        rhs.erase(0, tilde + 1);
+    }
+    Rcpp::Function parse_func = Rcpp::Environment::base_env()["parse"];
+    SEXP expressions = parse_func(Rcpp::_["text"] = rhs);
+    r_gradient_expression = VECTOR_ELT(expressions, 0);
+    make_r_atomic();
+}
+
+/*! \brief Recognise the compiled formula as one of the SR functions
+ *
+ * The formula is compared to the FLCore formulas of the SR functions in the model map.
+ * If they match, the model pointer is set to the SR function and the order of the parameters is stored.
+ * \param param_names The names of the parameters in the params member.
+ */
+template <typename T>
+void fwdSR_base<T>::recognise_model(const std::vector<std::string>& param_names){
+    for (const srr_library_entry& entry : srr_formula_library()){
+        // All the parameters of the SR function must be present
+        std::vector<unsigned int> params_order;
+        for (const std::string& name : entry.param_names){
+            std::vector<std::string>::const_iterator name_found = std::find(param_names.begin(), param_names.end(), name);
+            if (name_found == param_names.end()){
+                break;
+            }
+            params_order.push_back(name_found - param_names.begin());
+        }
+        if (params_order.size() != entry.param_names.size()){
+            continue;
+        }
+        if (formula->is_same(srrFormula(entry.formula, param_names))){
+            model = map_model_name_to_function[entry.model_name];
+            model_params_order = params_order;
+            return;
+        }
+    }
+}
 
 /*! \brief Intrusive 'wrap' for the fwdSR class.
  * Returns a List of stuff - used for tests, not really used for much else.
@@ -80,6 +637,24 @@ fwdSR_base<T>::operator SEXP() const{
 template <typename T>
 fwdSR_base<T>::fwdSR_base(const fwdSR_base<T>& fwdSR_source){
     model = fwdSR_source.model; // Copy the pointer - we want it to point to the same place so copying should be fine.
+    model_params_order = fwdSR_source.model_params_order;
+    formula = fwdSR_source.formula;
+    r_expression = fwdSR_source.r_expression;
+    r_gradient_expression = fwdSR_source.r_gradient_expression;
+    r_env = fwdSR_source.r_env;
+    r_atomic = fwdSR_source.r_atomic;
+    lookup = fwdSR_source.lookup;
+    table_dim = fwdSR_source.table_dim;
+    covariate_names = fwdSR_source.covariate_names;
+    covariates = fwdSR_source.covariates;
+    pass_covariates = fwdSR_source.pass_covariates;
+    cell_params = fwdSR_source.cell_params;
+    cell_nparams = fwdSR_source.cell_nparams;
+    cell_params_na = fwdSR_source.cell_params_na;
+    recruitment_happens = fwdSR_source.recruitment_happens;
+    recruitment_happened = fwdSR_source.recruitment_happened;
+    sratio = fwdSR_source.sratio;
+    deviance_generator = fwdSR_source.deviance_generator;
     model_name = fwdSR_source.model_name;
     params = fwdSR_source.params;
     deviances = fwdSR_source.deviances;
@@ -96,6 +671,24 @@ template <typename T>
 fwdSR_base<T>& fwdSR_base<T>::operator = (const fwdSR_base<T>& fwdSR_source){
 	if (this != &fwdSR_source){
         model = fwdSR_source.model; // Copy the pointer - we want it to point to the same place so copying should be fine.
+        model_params_order = fwdSR_source.model_params_order;
+        formula = fwdSR_source.formula;
+        r_expression = fwdSR_source.r_expression;
+        r_gradient_expression = fwdSR_source.r_gradient_expression;
+        r_env = fwdSR_source.r_env;
+        r_atomic = fwdSR_source.r_atomic;
+        lookup = fwdSR_source.lookup;
+        table_dim = fwdSR_source.table_dim;
+        covariate_names = fwdSR_source.covariate_names;
+        covariates = fwdSR_source.covariates;
+        pass_covariates = fwdSR_source.pass_covariates;
+        cell_params = fwdSR_source.cell_params;
+        cell_nparams = fwdSR_source.cell_nparams;
+        cell_params_na = fwdSR_source.cell_params_na;
+        recruitment_happens = fwdSR_source.recruitment_happens;
+        recruitment_happened = fwdSR_source.recruitment_happened;
+        sratio = fwdSR_source.sratio;
+        deviance_generator = fwdSR_source.deviance_generator;
         model_name = fwdSR_source.model_name;
         params = fwdSR_source.params;
         deviances = fwdSR_source.deviances;
@@ -104,44 +697,73 @@ fwdSR_base<T>& fwdSR_base<T>::operator = (const fwdSR_base<T>& fwdSR_source){
 	return *this;
 }
 
+/*! \brief Move constructor
+ *
+ * Takes the members of a temporary instead of copying them.
+ * \param fwdSR_source The object to be moved.
+ */
+template <typename T>
+fwdSR_base<T>::fwdSR_base(fwdSR_base<T>&& fwdSR_source) noexcept{
+    model = std::move(fwdSR_source.model);
+    model_params_order = std::move(fwdSR_source.model_params_order);
+    formula = std::move(fwdSR_source.formula);
+    r_expression = std::move(fwdSR_source.r_expression);
+    r_gradient_expression = std::move(fwdSR_source.r_gradient_expression);
+    r_env = std::move(fwdSR_source.r_env);
+    r_atomic = std::move(fwdSR_source.r_atomic);
+    lookup = std::move(fwdSR_source.lookup);
+    table_dim = std::move(fwdSR_source.table_dim);
+    covariate_names = std::move(fwdSR_source.covariate_names);
+    covariates = std::move(fwdSR_source.covariates);
+    pass_covariates = std::move(fwdSR_source.pass_covariates);
+    cell_params = std::move(fwdSR_source.cell_params);
+    cell_nparams = fwdSR_source.cell_nparams;
+    cell_params_na = std::move(fwdSR_source.cell_params_na);
+    recruitment_happens = std::move(fwdSR_source.recruitment_happens);
+    recruitment_happened = std::move(fwdSR_source.recruitment_happened);
+    sratio = std::move(fwdSR_source.sratio);
+    deviance_generator = std::move(fwdSR_source.deviance_generator);
+    model_name = std::move(fwdSR_source.model_name);
+    params = std::move(fwdSR_source.params);
+    deviances = std::move(fwdSR_source.deviances);
+    deviances_mult = std::move(fwdSR_source.deviances_mult);
+}
 
-/*! \name Get the SR parameters
+/*! \brief Move assignment operator
  *
- * Given the year, unit, season, area and iter, returns the corresponding stock recruitment parameters.
- * \param year The year of the SR parameters to use.
- * \param unit The unit of the SR parameters to use.
- * \param season The season of the SR parameters to use.
- * \param area The area of the SR parameters to use.
- * \param iter The iter of the SR parameters to use.
+ * \param fwdSR_source The object to be moved.
  */
 template <typename T>
-std::vector<double> fwdSR_base<T>::get_params(unsigned int year, unsigned int unit, unsigned int season, unsigned int area, unsigned int iter) const{
-    const int nparams = get_nparams();
-    std::vector<double> model_params(nparams);
-    // Parameters get recycled, i.e.  if requested year is bigger than years in the params FLQuant then we just take the first one.
-    if (year > params.get_nyear()){
-        year = 1;
-    }
-    if (unit > params.get_nunit()){
-        unit = 1;
-    }
-    if (season > params.get_nseason()){
-        season = 1;
-    }
-    if (area > params.get_narea()){
-        area = 1;
-    }
-    if (iter > params.get_niter()){
-        iter = 1;
-    }
-    for (int i = 1; i <= nparams; ++i){
-        model_params[i-1] = params(i,year,unit,season,area,iter);
-  // uncomment for debugging: 
-  // Rprintf("Year: %i Unit: %i Season: %i Iter: %i Param %i: %f\n",  year, unit, season, iter, i, model_params[i-1]);
-    }
-    return model_params;
+fwdSR_base<T>& fwdSR_base<T>::operator = (fwdSR_base<T>&& fwdSR_source) noexcept{
+	if (this != &fwdSR_source){
+        model = std::move(fwdSR_source.model);
+        model_params_order = std::move(fwdSR_source.model_params_order);
+        formula = std::move(fwdSR_source.formula);
+        r_expression = std::move(fwdSR_source.r_expression);
+        r_gradient_expression = std::move(fwdSR_source.r_gradient_expression);
+        r_env = std::move(fwdSR_source.r_env);
+        r_atomic = std::move(fwdSR_source.r_atomic);
+        lookup = std::move(fwdSR_source.lookup);
+        table_dim = std::move(fwdSR_source.table_dim);
+        covariate_names = std::move(fwdSR_source.covariate_names);
+        covariates = std::move(fwdSR_source.covariates);
+        pass_covariates = std::move(fwdSR_source.pass_covariates);
+        cell_params = std::move(fwdSR_source.cell_params);
+        cell_nparams = fwdSR_source.cell_nparams;
+        cell_params_na = std::move(fwdSR_source.cell_params_na);
+        recruitment_happens = std::move(fwdSR_source.recruitment_happens);
+        recruitment_happened = std::move(fwdSR_source.recruitment_happened);
+        sratio = std::move(fwdSR_source.sratio);
+        deviance_generator = std::move(fwdSR_source.deviance_generator);
+        model_name = std::move(fwdSR_source.model_name);
+        params = std::move(fwdSR_source.params);
+        deviances = std::move(fwdSR_source.deviances);
+        deviances_mult = std::move(fwdSR_source.deviances_mult);
+	}
+	return *this;
 }
 
+
 /*! \name Evaluate the SR model
  *
  * Produces a single value of recruitment given a single value of the SRP.
@@ -161,25 +783,23 @@ std::vector<double> fwdSR_base<T>::get_params(unsigned int year, unsigned int un
  * \param iter The iter of the SR parameters to use.
  */
 template <typename T>
-T fwdSR_base<T>::eval_model(const T srp, int year, int unit, int season, int area, int iter, const std::string model_name) const{
-    // Get the parameters
-    std::vector<double> model_params = get_params(year, unit, season, area, iter);
-    
-    // uncomment for debugging: 
-    // Rprintf("Params: %f\n", model_params);
+T fwdSR_base<T>::eval_model(const T srp, int year, int unit, int season, int area, int iter) const{
+    // Get the parameters from the precomputed table
+    const unsigned int cell = params_cell(year, unit, season, area, iter);
+    const srrParams model_params = get_cell_params(cell);
     // Check if any params are NA - if so, don't evaluate model, set rec to 0.0 for clean exit
-    // Check first value to see if bad for clean exit
-    //Rprintf("size model_params: %i \n", model_params.size());
     T rec = 0.0;
-    bool paramNA = false;
-    for (double param : model_params){
-        if(Rcpp::NumericVector::is_na(param)){
-            paramNA = true;
+    if (!cell_params_na[cell]){
+        if (model != nullptr){
+            rec = model(srp, model_params);
+        }
+        else if (is_native()){
+            rec = formula->eval(srp, model_params.begin());
+        }
+        else {
+            // evaluate in R using the cached expression, recorded on the tape as an atomic operation
+            rec = r_atomic->eval(std::vector<T>(1, srp), std::vector<double>(model_params.begin(), model_params.end()))[0];
         }
-    }
-    if (paramNA == false){
-      // evaluate with the model name passed as function argument
-        rec = model(srp, model_params,model_name);
     }
     else {
         Rcpp::warning("An SR model param is NA. Setting rec to 0 else something bad will happen.\n");
@@ -192,13 +812,8 @@ T fwdSR_base<T>::eval_model(const T srp, int year, int unit, int season, int are
  * \param params_indices The indices of the SR params (starting at 1).
  */
 template <typename T>
-T fwdSR_base<T>::eval_model(const T srp, const std::vector<unsigned int> params_indices, const std::string model_name) const{ 
-    // Check length of params_indices
-    if (params_indices.size() != 5){
-        Rcpp::stop("In fwdSR::eval_model. params_indices must be of length 5.");
-    }
-    T rec = eval_model(srp, params_indices[0], params_indices[1], params_indices[2], params_indices[3], params_indices[4],
-                       model_name);
+T fwdSR_base<T>::eval_model(const T srp, const Index5& params_indices) const{ 
+    T rec = eval_model(srp, params_indices[0], params_indices[1], params_indices[2], params_indices[3], params_indices[4]);
     return rec;
 }
 //@}
@@ -219,11 +834,7 @@ T fwdSR_base<T>::eval_model(const T srp, const std::vector<unsigned int> params_
  * \param initial_params_indices A vector of length 5 (year, unit, ... iter) to specify the start position of the indices of the SR params and deviances relative to the 'whole' operating model (starting at 1).
  */
 template <typename T>
-FLQuant_base<T> fwdSR_base<T>::predict_recruitment(const FLQuant_base<T> srp, const std::vector<unsigned int> initial_params_indices,
-                                                   const std::string model_name){ 
-    if (initial_params_indices.size() != 5){
-        Rcpp::stop("In fwdSR::predict_recruitment. initial_params_indices must be of length 5.\n");
-    }
+FLQuant_base<T> fwdSR_base<T>::predict_recruitment(const FLQuant_base<T>& srp, const Index5& initial_params_indices) const{ 
     std::vector<unsigned int> srp_dim = srp.get_dim();
     if (srp_dim[0] != 1){
         Rcpp::stop("In fwdSR::predict_recruitment. srp must be of length 1 in the first dimension.\n");
@@ -242,44 +853,73 @@ FLQuant_base<T> fwdSR_base<T>::predict_recruitment(const FLQuant_base<T> srp, co
     FLQuant_base<T> rec = srp;
     rec.fill(0.0);
 
-    // SET sex ratio
-    T sratio = 1.0;
-
-    // GET unit dimnames, sorted
-    std::vector<std::string> unit_names;
-    unit_names = Rcpp::as<std::vector<std::string> >(deviances.get_dimnames()[2]);
-    std::sort(unit_names.begin(), unit_names.end());
-    std::vector<std::string> sex = { "F", "M" };
-
-    // IF two unit(s) & unit_names %in% c('F','M'), sratio=0.5
-    if (res_dim[2] == 2) {
-      if(unit_names == sex) {
-        sratio = 0.5;
-      }
-    } 
-
+    // Deterministic recruitment for all SRP values
+    // Natively each value is evaluated in turn. Else all the values are passed to R in one go, as one atomic operation on the tape.
     // Going to have to loop over the dimensions and update the params and deviances indices - not nice
-    std::vector<unsigned int> params_indices = initial_params_indices;
-    //std::vector<unsigned int> deviances_indices = initial_deviances_indices;
+    Index5 params_indices = initial_params_indices;
+    const unsigned int nvalues = srp_dim[1] * srp_dim[2] * srp_dim[3] * srp_dim[4] * srp_dim[5];
+    std::vector<T> rec_det(nvalues, 0.0);
+    std::vector<T> srp_values;
+    std::vector<double> params_values;
+    std::vector<unsigned int> r_positions; // Positions in rec_det of the values evaluated in R
+    bool paramNA = false;
+    unsigned int value_count = 0;
+    for (unsigned int year_counter = 1; year_counter <= srp_dim[1]; ++year_counter){
+        params_indices[0] = initial_params_indices[0] + year_counter - 1;
+        for (unsigned int unit_counter = 1; unit_counter <= srp_dim[2]; ++unit_counter){
+            params_indices[1] = initial_params_indices[1] + unit_counter - 1;
+            for (unsigned int season_counter = 1; season_counter <= srp_dim[3]; ++season_counter){
+                params_indices[2] = initial_params_indices[2] + season_counter - 1;
+                for (unsigned int area_counter = 1; area_counter <= srp_dim[4]; ++area_counter){
+                    params_indices[3] = initial_params_indices[3] + area_counter - 1;
+                    for (unsigned int iter_counter = 1; iter_counter <= srp_dim[5]; ++iter_counter){
+                        params_indices[4] = initial_params_indices[4] + iter_counter - 1;
+                        T srp_value_temp = srp(1, year_counter, unit_counter, season_counter, area_counter, iter_counter);
+                        if (is_native()){
+                            rec_det[value_count] = eval_model(srp_value_temp, params_indices);
+                        }
+                        else {
+                            const unsigned int cell = params_cell(params_indices[0], params_indices[1], params_indices[2], params_indices[3], params_indices[4]);
+                            // If any params are NA rec stays at 0
+                            if (cell_params_na[cell]){
+                                paramNA = true;
+                            }
+                            else {
+                                srp_values.push_back(srp_value_temp);
+                                const srrParams model_params = get_cell_params(cell);
+                                params_values.insert(params_values.end(), model_params.begin(), model_params.end());
+                                r_positions.push_back(value_count);
+                            }
+                        }
+                        ++value_count;
+    }}}}}
+    if (paramNA){
+        Rcpp::warning("An SR model param is NA. Setting rec to 0 else something bad will happen.\n");
+    }
+    if (!r_positions.empty()){
+        std::vector<T> rec_r = r_atomic->eval(srp_values, params_values);
+        for (unsigned int r_count = 0; r_count < r_positions.size(); ++r_count){
+            rec_det[r_positions[r_count]] = rec_r[r_count];
+        }
+    }
+
+    // Apply the sex ratio and deviances
+    value_count = 0;
     for (unsigned int year_counter = 1; year_counter <= srp_dim[1]; ++year_counter){
         params_indices[0] = initial_params_indices[0] + year_counter - 1;
-        //deviances_indices[0] = initial_deviances_indices[0] + year_counter - 1;
         for (unsigned int unit_counter = 1; unit_counter <= srp_dim[2]; ++unit_counter){
             params_indices[1] = initial_params_indices[1] + unit_counter - 1;
-            //deviances_indices[1] = initial_deviances_indices[1] + unit_counter - 1;
             for (unsigned int season_counter = 1; season_counter <= srp_dim[3]; ++season_counter){
                 params_indices[2] = initial_params_indices[2] + season_counter - 1;
-                //deviances_indices[2] = initial_deviances_indices[2] + season_counter - 1;
                 for (unsigned int area_counter = 1; area_counter <= srp_dim[4]; ++area_counter){
                     params_indices[3] = initial_params_indices[3] + area_counter - 1;
-                    //deviances_indices[3] = initial_deviances_indices[3] + area_counter - 1;
                     for (unsigned int iter_counter = 1; iter_counter <= srp_dim[5]; ++iter_counter){
                         params_indices[4] = initial_params_indices[4] + iter_counter - 1;
-                        //deviances_indices[4] = initial_deviances_indices[4] + iter_counter - 1;
-                        T rec_temp = eval_model(srp(1, year_counter, unit_counter, season_counter, area_counter, iter_counter),
-                                                params_indices,
-                                                model_name);
+                        T rec_temp = rec_det[value_count];
                         rec_temp *= sratio;
+                        if (deviance_generator.is_active()){
+                            rec_temp *= deviance_generator.deviance(params_indices[0], params_indices[1], params_indices[2], params_indices[3], params_indices[4]);
+                        }
                         if (deviances_mult == true){
                             rec_temp *= deviances(1, params_indices[0], params_indices[1], params_indices[2], params_indices[3], params_indices[4]);
                         }
@@ -287,12 +927,13 @@ FLQuant_base<T> fwdSR_base<T>::predict_recruitment(const FLQuant_base<T> srp, co
                             rec_temp += deviances(1, params_indices[0], params_indices[1], params_indices[2], params_indices[3], params_indices[4]);
                         }
                         rec(1, year_counter, unit_counter, season_counter, area_counter, iter_counter) = rec_temp;
+                        ++value_count;
     }}}}}
     return rec;
 }
 
 template <typename T>
-FLQuant_base<double> fwdSR_base<T>::get_params() const{
+const FLQuant_base<double>& fwdSR_base<T>::get_params() const{
     return params;
 }
 
@@ -310,12 +951,21 @@ int fwdSR_base<T>::get_nparams() const{
     return params.get_nquant();
 }
 
+/*! \brief Is the SRR evaluated natively.
+ *
+ * True if the model is one of the SR functions or if the model formula was compiled into an expression tree, false if it is evaluated by calling R.
+ */
+template <typename T>
+bool fwdSR_base<T>::is_native() const{
+    return (model != nullptr) || ((formula != nullptr) && formula->is_native());
+}
+
 /*! \brief Get the deviances.
  *
  * Returns the deviances.
  */
 template <typename T>
-FLQuant_base<double> fwdSR_base<T>::get_deviances() const{
+const FLQuant_base<double>& fwdSR_base<T>::get_deviances() const{
     return deviances;
 }
 
@@ -329,8 +979,9 @@ bool fwdSR_base<T>::get_deviances_mult() const{
 }
 
 template <typename T>
-void fwdSR_base<T>::set_deviances(const FLQuant_base<double> new_deviances){
+void fwdSR_base<T>::set_deviances(const FLQuant_base<double>& new_deviances){
     deviances = new_deviances;
+    init_sratio();
 }
 
 template <typename T>
@@ -338,6 +989,21 @@ void fwdSR_base<T>::set_deviances_mult(const bool new_deviances_mult){
     deviances_mult = new_deviances_mult;
 }
 
+/*! \brief Set the deviance generator
+ *
+ * The generated deviances multiply the recruitment on top of the deviances member.
+ * As they are generated when they are needed the deviances member can have a single iteration.
+ */
+template <typename T>
+void fwdSR_base<T>::set_deviance_generator(const srrDevianceGenerator new_deviance_generator){
+    deviance_generator = new_deviance_generator;
+}
+
+template <typename T>
+bool fwdSR_base<T>::has_deviance_generator() const{
+    return deviance_generator.is_active();
+}
+
 //! Does recruitment happen for a unit in that timestep
 /*!
   Each unit can recruit in a different season. Each unit can recruit only once per year.
@@ -350,307 +1016,175 @@ void fwdSR_base<T>::set_deviances_mult(const bool new_deviances_mult){
  */ 
 template <typename T>
 bool fwdSR_base<T>::does_recruitment_happen(unsigned int unit, unsigned int year, unsigned int season) const{
-    unsigned int area = 1;
-    // Just get first iter
-    std::vector<double> sr_params = get_params(year, unit, season, area, 1); 
-    bool did_spawning_happen = true;
-    // Check the first parameter only
-    if (Rcpp::NumericVector::is_na(sr_params[0])){
-        did_spawning_happen = false;
-    }
-    return did_spawning_happen;
+    // Just the first area and iter
+    return recruitment_happens[params_cell(year, unit, season, 1, 1)];
 }
 
+//! Has recruitment happened for a unit in that year, up to and including that season
 template <typename T>
 bool fwdSR_base<T>::has_recruitment_happened(unsigned int unit, unsigned int year, unsigned int season) const{
-    unsigned int area = 1;
-    unsigned int has_spawning_happened = 0;
+    return recruitment_happened[params_cell(year, unit, season, 1, 1)];
+}
 
-    // GET number of seasons
-    unsigned int nseasons = params.get_nseason();
+// Explicit instantiation of class
+template class fwdSR_base<double>;
+template class fwdSR_base<adouble>;
 
-    // CREATE vector of length nseasons
-    std::vector<int> spawns(nseasons);
-    std::vector<double> sr_params = get_params(year, unit, 1, area, 1);
-    spawns[0] = 0 + !Rcpp::NumericVector::is_na(sr_params[0]);
+//--------------------------------------------------------------------
+// SRR functions
+// The params in these functions do not have any disaggregation (e.g. by time or area)
+// They are only the params required to evaluate the SRR function at a specific point
+// The disaggregated parameter values are stored in the fwdSR_base class as an FLQuant_base object
+// The fwdSR.eval_model method sorts out time step of params etc and passes the correct set of params to these functions
+// These functions must have the same argument list so that it matches the typedef for the model pointer
+// Conditions on the SRP use CondExp so that the tape does not depend on the branch taken when it was recorded
 
-    // POPULATE with is.na(sr_params[0]), loop over 2:end
-    for (unsigned int ns=1; ns < nseasons; ++ns){
-      std::vector<double> sr_params = get_params(year, unit, ns+1, area, 1);
-      spawns[ns] = spawns[ns-1] + !Rcpp::NumericVector::is_na(sr_params[0]);
+template <typename T>
+T bevholt(const T srp, const srrParams& params){
+    T rec;
+    // rec = a * srp / (b + srp)
+    rec = params[0] * srp / (params[1] + srp);
+    if (params.size() > 2) {
+      // rec = a / (1 + (b / srp) ^ d)
+      rec = params[0] / (1.0 + pow(params[1] / srp, params[2]));
     }
-    
-    has_spawning_happened = spawns[season-1] > 0;
+    return rec;
+}
 
-    return has_spawning_happened;
+template <typename T>
+T bevholtDa(const T srp, const srrParams& params){
+    T rec;
+    // rec = a / (1 + (b / srp) ^ d)
+    rec = params[0] / (1.0 + pow(params[1] / srp, params[2]));
+    return rec;
+}
 
+template <typename T>
+T ricker(const T srp, const srrParams& params){
+    T rec;
+    // rec = a * srp * exp(-b * srp)
+    rec = params[0] * srp * exp(-params[1] * srp);
+    return rec;
 }
 
-// Explicit instantiation of class
-template class fwdSR_base<double>;
-template class fwdSR_base<adouble>;
+template <typename T>
+T constant(const T, const srrParams& params){
+    T rec;
+    // rec = a 
+    rec = params[0]; 
+    return rec;
+}
+
+template <typename T>
+T bevholtSS3(const T srp, const srrParams& params){
+    T rec;
+    // rec = (4 * s * R0 * ssb) / (v * (1 - s) + ssb * (5 * s - 1)) 
+    double s = params[0];
+    double R0 = params[1];
+    double v = params[2];
+    rec = (4.0 * s * R0 * srp) / (v * (1.0 - s) + srp * (5.0 * s - 1.0));
+    return rec;
+}
+
+template <typename T>
+T cushing(const T srp, const srrParams& params){
+    T rec;
+    // rec = a * srp ^ b
+    rec = params[0] * exp(log(srp) * params[1]);
+    return rec;
+}
 
-// //--------------------------------------------------------------------
-// // SRR functions
-// // The params in these functions do not have any disaggregation (e.g. by time or area)
-// // They are only the params required to evaluate the SRR function at a specific point
-// // The disaggregated parameter values are stored in the fwdSR_base class as an FLQuant_base object
-// // The fwdSR.eval_model method sorts out time step of params etc and passes the correct set of params to these functions
-// // These functions must have the same argument list so that it matches the typedef for the model pointer
 template <typename T>
-T customSRR(const T srp, const std::vector<double> params,const std::string model_name){
+T segreg(const T srp, const srrParams& params){
     T rec;
-  
-  // uncommment for debugging
-  // for(int i=0; i<params.size(); ++i){
-  //   Rprintf("the value of params[%i] : %f \n", i, params[i]);
-  // }
-    // Use the global environment so that any function (such as predefined_function) is found.
-    Environment env = Environment::global_env();
-    
-    // Insert the C++ arguments into the R environment.
-    env.assign("ssb", srp);
-    env.assign("params", params);
-    
-    // uncomment for debugging: 
-    //double ssb_print = env["ssb"];
-    //Rprintf("the value of SSB : %f \n", ssb_print);
-    
-    // Get R's built-in 'parse' function from the base namespace.
-    Function parseFunc = Environment::base_env()["parse"];
-    
-    // Parse the provided formula call string into an R expression.
-    SEXP exprList = parseFunc(_["text"] = model_name);
-    
-    // Evaluate the first expression from the parsed results in the global environment.
-    SEXP result = Rcpp_eval(VECTOR_ELT(exprList, 0), env);
-    // coerse to a double first
-    double d = Rcpp::as<double>(result);
-    
-    // uncomment for debugging:
-    //Rprintf("the value of Rec: %f \n", d);
-    
-    // than coersing it to the template format allowing to be cast to "adouble" correctly
-    rec = T(d);
-    
-    // Convert and return the result as a double.
+    // rec = if(ssb <= b) a * ssb else a * b
+    T b = params[1];
+    T rec_ab = params[0] * params[1];
+    rec = CppAD::CondExpLe(srp, b, T(params[0] * srp), rec_ab);
     return rec;
-    //return static_cast<T>(REAL(rec)[0]);
-    //return rec;
-}
-// 
-// // create a 'custom' SRR that links to a R-call of a specified function
-// 
-// template <typename T>
-// T customSRR(const T srp, const std::vector<double> params){
-//   T rec;
-//   // RInside R(srp, params, f_name);
-//   // T rec;
-//   // // call a specified R function from within C++
-//   // // use params specified in the params slot as env. covars
-//   // Rcpp::Function f(f_name)
-//   // const T rec = f(ssb = srp,covars = params)
-//   // R.parseEval(rec,ans);
-//   // rec = double ans;
-//   // return rec;
-//   
-//   // Rcpp::Function f(f_name);
-//   
-//   // Rcpp::NumericVector rec = f(srp,params);
-//   // rec = f(srp,params);
-//   return rec;
-// }
-// 
-// 
-// // Rcpp::NumericVector customSRR(const T srp, const std::vector<double> params, const char *f_name[]){
-// //   // RInside R(srp, params, f_name);
-// //   // call a specified R function from within C++
-// //   // use params specified in the params slot as env. covars
-// //   Rcpp::Function f(f_name);
-// //   Rcpp::NumericVector rec = f(srp,params);
-// //   return rec;
-// // }
-// 
-// 
-// template <typename T>
-// T bevholt(const T srp, const std::vector<double> params, char *f_name[]){
-//     T rec;
-// 
-//     // rec = a * srp / (b + srp)
-//     rec = params[0] * srp / (params[1] + srp);
-// 
-//     if (params.size() > 2) {
-//       // rec = a / (1 + (b / srp) ^ d)
-//       rec = params[0] / (1 + pow(params[1] / srp, params[2]));
-//     }
-//     
-//     return rec;
-// }
-// 
-// template <typename T>
-// T bevholtDa(const T srp, const std::vector<double> params, char *f_name[]){
-//     T rec;
-// 
-//     // rec = a / (1 + (b / srp) ^ d)
-//     rec = params[0] / (1 + pow(params[1] / srp, params[2]));
-//     
-//     return rec;
-// }
-// 
-// template <typename T>
-// T constant(const T srp, const std::vector<double> params, char *f_name[]){
-//     T rec;
-//     // rec = a 
-//     rec = params[0]; 
-//     return rec;
-// }
-// 
-// template <typename T>
-// T bevholtSS3(const T srp, const std::vector<double> params, char *f_name[]){
-//     T rec;
-//     // rec = (4 * s * R0 * ssb) / (v * (1 - s) + ssb * (5 * s - 1)) 
-//     double s = params[0];
-//     double R0 = params[1];
-//     double v = params[2];
-//     
-//     // sratio is the recruits sex ratio, 1 if single sex model
-//     //double sratio = 1.0;
-//     //if (params.size() > 3) {
-//     //  sratio = params[3];
-//     //}
-//     
-//     // seasp is the prop of rec for the season, 1 if single rec
-//     // TODO BUT srp needs to come from spwn season
-//     //double seasp = 1.0;
-//     //if (params.size() > 4) {
-//     //  seasp = params[4];
-//     //}
-// 
-//     // TODO ssbp is the prop of ssb active in a season, 1 if single rec
-//     //double ssbp = 1.0;
-//     //if (params.size() > 5) {
-//     //  ssbp = params[5];
-//     //}
-//   
-//     rec = (4.0 * s * R0 * srp) / (v * (1.0 - s) + srp * (5 * s - 1.0));
-// 
-//     return rec;
-// }
-// 
-// template <typename T>
-// T cushing(const T srp, const std::vector<double> params, char *f_name[]){
-//   T rec;
-//   // rec = a * srp ^ b
-//   rec = params[0] * exp(log(srp)*params[1]);
-//   return rec;
-// }
-// 
-// template <typename T>
-// T segreg(const T srp, const std::vector<double> params, char *f_name[]){
-//     T rec;
-//     // rec = if(ssb < b) a * ssb else a * b
-//     if(srp <= params[1]) {
-//       rec = params[0] * srp;
-//     }
-//     else {
-//       rec = params[0] * params[1];
-//     }
-//     return rec;
-// }
-// 
-// template <typename T>
-// T segregDa(const T srp, const std::vector<double> params, char *f_name[]){
-//     T rec;
-//     // rec = if(ssb < b) a * ssb else a * b
-//     if(pow(srp, params[2]) <= params[1]) {
-//       rec = params[0] * pow(srp, params[2]);
-//     }
-//     else {
-//       rec = params[0] * params[1];
-//     }
-//     return rec;
-// }
-// 
-// 
-// 
-// template <typename T>
-// T survsrr(const T ssf, const std::vector<double> params, char *f_name[]){
-//     T rec;
-//     
-//     double R0 = params[0];
-//     double sfrac = params[1];
-//     double beta = params[2];
-//     double SB0 = params[3];
-// 
-//     // sratio is the recruits sex ratio, default 0.5 assumes 2 sex model
-//     double sratio = 0.5;
-//     if (params.size() > 4) {
-//       sratio = params[4];
-//     }
-// 
-//     double z0 = log(1.0 / (SB0 / R0));
-//     
-//     double zmax = z0 + sfrac * (0.0 - z0);
-//     
-//     T zsurv = exp((1.0 - pow((ssf / SB0), beta)) * (zmax - z0) + z0);
-// 
-//     // Sex ratio at recruitment set at 1:1
-//     rec = ssf * zsurv * sratio;
-// 
-//     return rec;
-// }
-// 
-// template <typename T>
-// T bevholtsig(const T srp, const std::vector<double> params, char *f_name[]){
-//     T rec;
-//     // rec = a / ((b / srp) ^c + 1)
-//     rec = params[0] / (pow((params[1] / srp), params[2]) + 1);
-//     return rec;
-// }
-// 
-// template <typename T>
-// T mixedsrr(const T srp, const std::vector<double> params, char *f_name[]){
-//     T rec;
-//     
-//     double a = params[0];
-//     double b = params[1];
-//     int mod = params[2];
-// 
-//     // 1 Bevholt, rec = a * srp / (b + srp)
-//     if (mod == 1) {
-//       rec = a * srp / (b + srp);
-//     } else if (mod == 2) {
-//     // 2 Ricker, rec = a * srp * exp (-b * srp)
-//       rec = a * srp * exp(-b * srp);
-//     // 3 Segreg, rec = if(ssb < b) a * ssb else a * b
-//     } else if (mod == 3) {
-//       if(srp <= b) {
-//         rec = a * srp;
-//       } else {
-//         rec = a * b;
-//       }
-//     }
-//     return rec;
-// }
-// 
-// // Instantiate functions
-template double customSRR(const double srp, const std::vector<double> params,const std::string model_name);
-template adouble customSRR(const adouble srp, const std::vector<double> params,const std::string model_name);
-// template double customSRR(const double srp, const std::vector<double> params, char *f_name[]);
-// template adouble customSRR(const adouble srp, const std::vector<double> params, char *f_name[]);
-// template double bevholt(const double srp, const std::vector<double> params, char *f_name[]);
-// template adouble bevholt(const adouble srp, const std::vector<double> params, char *f_name[]);
-// template double constant(const double srp, const std::vector<double> params, char *f_name[]);
-// template adouble constant(const adouble srp, const std::vector<double> params, char *f_name[]);
-// template double bevholtSS3(const double srp, const std::vector<double> params, char *f_name[]);
-// template adouble bevholtSS3(const adouble srp, const std::vector<double> params, char *f_name[]);
-// template double cushing(const double srp, const std::vector<double> params, char *f_name[]);
-// template adouble cushing(const adouble srp, const std::vector<double> params, char *f_name[]);
-// template double segreg(const double srp, const std::vector<double> params, char *f_name[]);
-// template adouble segreg(const adouble srp, const std::vector<double> params, char *f_name[]);
-// template double survsrr(const double srp, const std::vector<double> params, char *f_name[]);
-// template adouble survsrr(const adouble srp, const std::vector<double> params, char *f_name[]);
-// template double bevholtsig(const double srp, const std::vector<double> params, char *f_name[]);
-// template adouble bevholtsig(const adouble srp, const std::vector<double> params, char *f_name[]);
-// template double mixedsrr(const double srp, const std::vector<double> params, char *f_name[]);
-// template adouble mixedsrr(const adouble srp, const std::vector<double> params, char *f_name[]);
+}
+
+template <typename T>
+T segregDa(const T srp, const srrParams& params){
+    T rec;
+    // rec = if(ssb ^ d <= b) a * ssb ^ d else a * b
+    T srp_d = pow(srp, params[2]);
+    T b = params[1];
+    T rec_ab = params[0] * params[1];
+    rec = CppAD::CondExpLe(srp_d, b, T(params[0] * srp_d), rec_ab);
+    return rec;
+}
+
+template <typename T>
+T survsrr(const T ssf, const srrParams& params){
+    T rec;
+    double R0 = params[0];
+    double sfrac = params[1];
+    double beta = params[2];
+    double SB0 = params[3];
+    // sratio is the recruits sex ratio, default 0.5 assumes 2 sex model
+    double sratio = 0.5;
+    if (params.size() > 4) {
+      sratio = params[4];
+    }
+    double z0 = log(1.0 / (SB0 / R0));
+    double zmax = z0 + sfrac * (0.0 - z0);
+    T zsurv = exp((1.0 - pow((ssf / SB0), beta)) * (zmax - z0) + z0);
+    rec = ssf * zsurv * sratio;
+    return rec;
+}
+
+template <typename T>
+T bevholtsig(const T srp, const srrParams& params){
+    T rec;
+    // rec = a / ((b / srp) ^c + 1)
+    rec = params[0] / (pow((params[1] / srp), params[2]) + 1.0);
+    return rec;
+}
+
+template <typename T>
+T mixedsrr(const T srp, const srrParams& params){
+    T rec;
+    double a = params[0];
+    double b = params[1];
+    int mod = params[2];
+    // 1 Bevholt, rec = a * srp / (b + srp)
+    if (mod == 1) {
+      rec = a * srp / (b + srp);
+    // 2 Ricker, rec = a * srp * exp (-b * srp)
+    } else if (mod == 2) {
+      rec = a * srp * exp(-b * srp);
+    // 3 Segreg, rec = if(ssb <= b) a * ssb else a * b
+    } else if (mod == 3) {
+      T b_T = b;
+      T rec_ab = a * b;
+      rec = CppAD::CondExpLe(srp, b_T, T(a * srp), rec_ab);
+    } else {
+      Rcpp::stop("In mixedsrr. Third parameter must be 1 (bevholt), 2 (ricker) or 3 (segreg).\n");
+    }
+    return rec;
+}
+
+// Instantiate functions
+template double bevholt(const double srp, const srrParams& params);
+template adouble bevholt(const adouble srp, const srrParams& params);
+template double bevholtDa(const double srp, const srrParams& params);
+template adouble bevholtDa(const adouble srp, const srrParams& params);
+template double ricker(const double srp, const srrParams& params);
+template adouble ricker(const adouble srp, const srrParams& params);
+template double constant(const double srp, const srrParams& params);
+template adouble constant(const adouble srp, const srrParams& params);
+template double bevholtSS3(const double srp, const srrParams& params);
+template adouble bevholtSS3(const adouble srp, const srrParams& params);
+template double cushing(const double srp, const srrParams& params);
+template adouble cushing(const adouble srp, const srrParams& params);
+template double segreg(const double srp, const srrParams& params);
+template adouble segreg(const adouble srp, const srrParams& params);
+template double segregDa(const double srp, const srrParams& params);
+template adouble segregDa(const adouble srp, const srrParams& params);
+template double survsrr(const double srp, const srrParams& params);
+template adouble survsrr(const adouble srp, const srrParams& params);
+template double bevholtsig(const double srp, const srrParams& params);
+template adouble bevholtsig(const adouble srp, const srrParams& params);
+template double mixedsrr(const double srp, const srrParams& params);
+template adouble mixedsrr(const adouble srp, const srrParams& params);
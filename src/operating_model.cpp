@@ -28,7 +28,7 @@ operatingModel::operatingModel(){
  * \param biols_in The biological stocks.
  * \param ctrl_in The control object that controls the projections.
  */
-operatingModel::operatingModel(const FLFisheriesAD fisheries_in, const fwdBiolsAD biols_in, const fwdControl ctrl_in){
+operatingModel::operatingModel(const FLFisheriesAD& fisheries_in, const fwdBiolsAD& biols_in, const fwdControl& ctrl_in){
   // This requires a lot of checks...
   // Iters in all numbers and efforts must be the same (cannot be n or 1, just n)
   // Age structure and units of catches catching biols must be the same
@@ -105,6 +105,7 @@ operatingModel::operatingModel(const operatingModel& operatingModel_source){
   biols = operatingModel_source.biols;
   fisheries = operatingModel_source.fisheries;
   ctrl = operatingModel_source.ctrl;
+  arena_counters = operatingModel_source.arena_counters;
 }
 
 /*! \brief The assignment operator 
@@ -117,6 +118,33 @@ operatingModel& operatingModel::operator = (const operatingModel& operatingModel
     biols = operatingModel_source.biols;
     fisheries = operatingModel_source.fisheries;
     ctrl = operatingModel_source.ctrl;
+    arena_counters = operatingModel_source.arena_counters;
+	}
+	return *this;
+}
+
+/*! \brief Move constructor
+ *
+ * Takes the members of a temporary instead of copying them.
+ * \param operatingModel_source The object to be moved.
+ */
+operatingModel::operatingModel(operatingModel&& operatingModel_source) noexcept{
+  biols = std::move(operatingModel_source.biols);
+  fisheries = std::move(operatingModel_source.fisheries);
+  ctrl = std::move(operatingModel_source.ctrl);
+  arena_counters = std::move(operatingModel_source.arena_counters);
+}
+
+/*! \brief Move assignment operator
+ *
+ * \param operatingModel_source The object to be moved.
+ */
+operatingModel& operatingModel::operator = (operatingModel&& operatingModel_source) noexcept{
+	if (this != &operatingModel_source){
+    biols = std::move(operatingModel_source.biols);
+    fisheries = std::move(operatingModel_source.fisheries);
+    ctrl = std::move(operatingModel_source.ctrl);
+    arena_counters = std::move(operatingModel_source.arena_counters);
 	}
 	return *this;
 }
@@ -143,6 +171,34 @@ unsigned int operatingModel::get_niter() const{
   return fisheries(1).effort().get_niter();
 }
 
+/*! \brief The largest error of the SRR lookup tables of each biol
+ *
+ * The error is relative to the largest recruitment in each table. It is NA for biols without lookup tables.
+ */
+std::vector<double> operatingModel::srr_lookup_errors() const{
+  std::vector<double> errors(biols.get_nbiols());
+  for (unsigned int biol_no=1; biol_no <= biols.get_nbiols(); ++biol_no){
+    errors[biol_no-1] = biols(biol_no).get_srr().get_lookup_error();
+  }
+  return errors;
+}
+
+/*! \brief The use of the FLQuant arena by each target of the last run
+ *
+ * One row per target: the number of blocks and bytes taken from the arena, and the number of blocks that went to the heap instead.
+ * The counters are per target rather than per timestep as the arena is rewound at the start of each target. Each target (a set of simultaneous targets) is solved in one timestep.
+ */
+Rcpp::NumericMatrix operatingModel::get_arena_counters() const{
+  Rcpp::NumericMatrix out(arena_counters.size(), 3);
+  for (unsigned int target_count = 0; target_count < arena_counters.size(); ++target_count){
+    out(target_count, 0) = arena_counters[target_count].allocations;
+    out(target_count, 1) = arena_counters[target_count].bytes;
+    out(target_count, 2) = arena_counters[target_count].heap_allocations;
+  }
+  out.attr("dimnames") = Rcpp::List::create(R_NilValue, Rcpp::CharacterVector::create("allocations", "bytes", "heap_allocations"));
+  return out;
+}
+
 /*! \brief Does spawning occuring before fishing
  *
  * Any range of indices can be used. If ANY of them has spwn <= hperiod[1,] then true is returned.
@@ -154,19 +210,15 @@ unsigned int operatingModel::get_niter() const{
  * \param indices_min The minimum indices: year, unit, season, area, iter (length 5).
  * \param indices_max The maximum indices: year, unit, season, area, iter (length 5).
  */
-bool operatingModel::spawn_before_fishing(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const{
-  // Check indices_min and indices_max are of length 6
-  if ((indices_min.size() != 5) | (indices_max.size() != 5)){
-    Rcpp::stop("In operatingModel::spawn_before_fishing subsetter. Indices not of length 5\n");
-  }
+bool operatingModel::spawn_before_fishing(const int biol_no, const Index5& indices_min, const Index5& indices_max) const{
   auto sbf = false;
   // Loop over all Fs that catch B
   // Loop over indices
   // if spwn <= hperiod[1,] then return true
-  FLQuant spwn = biols(biol_no).spwn();
+  const FLQuant_param& spwn = biols(biol_no).spwn();
   auto Fs =  ctrl.get_F(biol_no); // unique Fs fishing that B
   for (unsigned int f_counter=0; f_counter < Fs.size(); ++f_counter){
-    FLQuant hperiod = fisheries(Fs[f_counter]).hperiod();
+    const FLQuant& hperiod = fisheries(Fs[f_counter]).hperiod();
     for (auto year_count = indices_min[0]; year_count <= indices_max[0]; ++year_count){
       for (auto unit_count = indices_min[1]; unit_count <= indices_max[1]; ++unit_count){
         for (auto season_count = indices_min[2]; season_count <= indices_max[2]; ++season_count){
@@ -191,19 +243,15 @@ bool operatingModel::spawn_before_fishing(const int biol_no, const std::vector<u
  * \param indices_min The minimum indices: year, unit, season, area, iter (length 5).
  * \param indices_max The maximum indices: year, unit, season, area, iter (length 5).
  */
-bool operatingModel::fishing_before_spawn(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const{
-  // Check indices_min and indices_max are of length 6
-  if ((indices_min.size() != 5) | (indices_max.size() != 5)){
-    Rcpp::stop("In operatingModel::spawn_before_fishing subsetter. Indices not of length 5\n");
-  }
+bool operatingModel::fishing_before_spawn(const int biol_no, const Index5& indices_min, const Index5& indices_max) const{
   auto fbs = false;
   // Loop over all Fs that catch B
   // Loop over indices
   // if spwn <= hperiod[1,] then return true
-  FLQuant spwn = biols(biol_no).spwn();
+  const FLQuant_param& spwn = biols(biol_no).spwn();
   auto Fs =  ctrl.get_F(biol_no); // unique Fs fishing that B
   for (unsigned int f_counter=0; f_counter < Fs.size(); ++f_counter){
-    FLQuant hperiod = fisheries(Fs[f_counter]).hperiod();
+    const FLQuant& hperiod = fisheries(Fs[f_counter]).hperiod();
     for (auto year_count = indices_min[0]; year_count <= indices_max[0]; ++year_count){
       for (auto unit_count = indices_min[1]; unit_count <= indices_max[1]; ++unit_count){
         for (auto season_count = indices_min[2]; season_count <= indices_max[2]; ++season_count){
@@ -229,11 +277,7 @@ bool operatingModel::fishing_before_spawn(const int biol_no, const std::vector<u
  * \param indices_min The minimum indices: year, unit, season, area, iter (length 5).
  * \param indices_max The maximum indices: year, unit, season, area, iter (length 5).
  */
-FLQuantAD operatingModel::get_exp_z_pre_spwn(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const{
-  // Check indices_min and indices_max are of length 6
-  if ((indices_min.size() != 6) | (indices_max.size() != 6)){
-    Rcpp::stop("In operatingModel::get_z_pre_spwn subsetter. Indices not of length 6\n");
-  }
+FLQuantAD operatingModel::get_exp_z_pre_spwn(const int biol_no, const Index6& indices_min, const Index6& indices_max) const{
   // Make dim of the Fprespwn object: max - min + 1
   std::vector<unsigned int> qdim(6,0.0);
   std::transform(indices_max.begin(), indices_max.end(), indices_min.begin(), qdim.begin(), [](unsigned int x, unsigned int y){return x-y+1;});
@@ -244,8 +288,8 @@ FLQuantAD operatingModel::get_exp_z_pre_spwn(const int biol_no, const std::vecto
   // 3. Get Fpropspawn(F,C,B)
   // 4. sum (F * Fpropspawn)
   const Rcpp::IntegerMatrix FC =  ctrl.get_FC(biol_no);
-  std::vector<unsigned int> indices_min5 = {indices_min[1], indices_min[2], indices_min[3], indices_min[4], indices_min[5]}; 
-  std::vector<unsigned int> indices_max5 = {indices_max[1], indices_max[2], indices_max[3], indices_max[4], indices_max[5]}; 
+  const Index5 indices_min5 = drop_quant(indices_min);
+  const Index5 indices_max5 = drop_quant(indices_max);
   for (int f_counter=0; f_counter < FC.nrow(); ++f_counter){
     FLQuantAD tempf = get_f(FC(f_counter,0), FC(f_counter,1), biol_no, indices_min, indices_max); 
     FLQuant temp_prop_spwn = f_prop_spwn(FC(f_counter,0), biol_no, indices_min5, indices_max5);
@@ -253,16 +297,16 @@ FLQuantAD operatingModel::get_exp_z_pre_spwn(const int biol_no, const std::vecto
     f_pre_spwn = f_pre_spwn + temp_propf;
   }
   // Get m pre spwn - need to adjust subsetter for the first dimension
-  std::vector<unsigned int> spwn_indices_max = indices_max;
+  Index6 spwn_indices_max = indices_max;
   spwn_indices_max[0] = 1;
-  FLQuant m_pre_spwn = sweep_mult(biols(biol_no).m(indices_min, indices_max), biols(biol_no).spwn(indices_min, spwn_indices_max));
+  FLQuant spwn_temp = biols(biol_no).spwn(indices_min, spwn_indices_max);
+  FLQuant m_pre_spwn = sweep_mult(biols(biol_no).m(indices_min, indices_max), spwn_temp);
   FLQuantAD z_pre_spwn = f_pre_spwn + m_pre_spwn;
   FLQuantAD exp_z_pre_spwn = exp(-1.0 * z_pre_spwn);
   // exp_z_pre_spwn needs to be 0 when spwn is 0
   // If spwn in biol is NA, then no spawning has occured. Therefore the amount of F and M before spawning is 0
   // A spwn of NA will result in the exp_z_pre_spwn of NA
   // So we find NA in spwn and replace in exp_z_pre_spwn with 0.0
-  FLQuant spwn_temp = biols(biol_no).spwn(indices_min, spwn_indices_max);
   // Hacky because exp_z is age structured and spwn is not
   for (unsigned int iter_count = 1; iter_count <= qdim[5]; ++iter_count){
     for (unsigned int area_count = 1; area_count <= qdim[4]; ++area_count){
@@ -289,12 +333,9 @@ FLQuantAD operatingModel::get_exp_z_pre_spwn(const int biol_no, const std::vecto
  * \param indices_min The minimum indices: year, unit, season, area, iter (length 5).
  * \param indices_max The maximum indices: year, unit, season, area, iter (length 5).
  */
-FLQuantAD operatingModel::total_srp(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const{
+FLQuantAD operatingModel::total_srp(const int biol_no, const Index5& indices_min, const Index5& indices_max) const{
   bool verbose = false;
   if(verbose){Rprintf("\nIn operatingModel::total_srp\n");}
-  if ((indices_min.size() != 5) | (indices_max.size() != 5)){
-    Rcpp::stop("In operatingModel::total_srp subsetter. Indices not of length 5 (no age index)\n");
-  }
   // TODO: CHANGE srp metric
   //FLQuantAD usrp = ssf(biol_no, indices_min, indices_max);
   FLQuantAD usrp = srp(biol_no, indices_min, indices_max);
@@ -318,26 +359,21 @@ FLQuantAD operatingModel::total_srp(const int biol_no, const std::vector<unsigne
  * \param indices_min The minimum indices: year, unit etc (length 5)
  * \param indices_max The maximum indices: year, unit etc (length 5)
  */
-FLQuantAD operatingModel::srp(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const{
+FLQuantAD operatingModel::srp(const int biol_no, const Index5& indices_min, const Index5& indices_max) const{
   bool verbose = false;
   if(verbose){Rprintf("\nIn operatingModel::srp\n");}
-  // Check indices_min and indices_max are of length 5
-  if ((indices_min.size() != 5) | (indices_max.size() != 5)){
-    Rcpp::stop("In operatingModel::srp subsetter. Indices not of length 5\n");
-  }
   // Add age range to input indices
-  std::vector<unsigned int> qindices_min = indices_min;
-  qindices_min.insert(qindices_min.begin(), 1);
+  Index6 qindices_min = add_quant(1, indices_min);
   std::vector<unsigned int> dim = biols(biol_no).n().get_dim();
-  std::vector<unsigned int> qindices_max = indices_max;
-  qindices_max.insert(qindices_max.begin(), dim[0]);
+  Index6 qindices_max = add_quant(dim[0], indices_max);
   FLQuantAD exp_z_pre_spwn = get_exp_z_pre_spwn(biol_no, qindices_min, qindices_max);
 
   // Get srp: N*mat*wt*exp(-Fprespwn - m*spwn) summed over age dimension
+  // Views of the biol members so the subsets are not copied
   FLQuantAD srp = quant_sum(
-    biols(biol_no).n(qindices_min, qindices_max) *
-    biols(biol_no).wt(qindices_min, qindices_max) *
-    biols(biol_no).mat(qindices_min, qindices_max) * exp_z_pre_spwn);
+    biols(biol_no).n().view(qindices_min, qindices_max) *
+    biols(biol_no).wt().view(qindices_min, qindices_max) *
+    biols(biol_no).mat().view(qindices_min, qindices_max) * exp_z_pre_spwn);
     //Rprintf("n0 1: %f, n0 2: %f\n", Value(biols(biol_no).n()(1, qindices_min[1], 1, 1, 1, 1)), Value(biols(biol_no).n()(1, qindices_min[1], 2, 1, 1, 1)));
   //if(verbose){Rprintf("unit 1 n: %f wt: %f mat: %f exp_z_pre_spwn: %f\n", 
   //   Value(biols(biol_no).n()(1, qindices_min[1], qindices_min[2], qindices_min[3], qindices_min[4], qindices_min[5])),  
@@ -351,16 +387,18 @@ FLQuantAD operatingModel::srp(const int biol_no, const std::vector<unsigned int>
   //   Value(exp_z_pre_spwn(1,1,2,1,1,1)));}
 
   // WHat is going on? mat = 0 so srp should be 0
-  FLQuantAD temp = biols(biol_no).n(qindices_min, qindices_max) *
-    biols(biol_no).wt(qindices_min, qindices_max) *
-    biols(biol_no).mat(qindices_min, qindices_max) * exp_z_pre_spwn;
-  if(verbose){Rprintf("temp 1: %f\n", Value(temp(5,1,1,1,1,1)));}
-  if(verbose){Rprintf("temp 2: %f\n", Value(temp(5,1,2,1,1,1)));}
-  FLQuantAD tsrp = unit_sum(srp);
-  if(verbose){Rprintf("srp 1: %f\n", Value(srp(1,1,1,1,1,1)));}
-  if(verbose){Rprintf("srp 2: %f\n", Value(srp(1,1,2,1,1,1)));}
-  if(verbose){Rprintf("tsrp: %f\n", Value(tsrp(1,1,1,1,1,1)));}
-  if(verbose){Rprintf("Leaving operatingModel::srp\n");}
+  if(verbose){
+    FLQuantAD temp = biols(biol_no).n(qindices_min, qindices_max) *
+      biols(biol_no).wt(qindices_min, qindices_max) *
+      biols(biol_no).mat(qindices_min, qindices_max) * exp_z_pre_spwn;
+    Rprintf("temp 1: %f\n", Value(temp(5,1,1,1,1,1)));
+    Rprintf("temp 2: %f\n", Value(temp(5,1,2,1,1,1)));
+    FLQuantAD tsrp = unit_sum(srp);
+    Rprintf("srp 1: %f\n", Value(srp(1,1,1,1,1,1)));
+    Rprintf("srp 2: %f\n", Value(srp(1,1,2,1,1,1)));
+    Rprintf("tsrp: %f\n", Value(tsrp(1,1,1,1,1,1)));
+    Rprintf("Leaving operatingModel::srp\n");
+  }
 
   return srp;
 }
@@ -375,24 +413,18 @@ FLQuantAD operatingModel::srp(const int biol_no, const std::vector<unsigned int>
  * \param indices_min The minimum indices: year, unit etc (length 5)
  * \param indices_max The maximum indices: year, unit etc (length 5)
  */
-FLQuantAD operatingModel::ssf(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const{
-  // Check indices_min and indices_max are of length 5
-  if ((indices_min.size() != 5) | (indices_max.size() != 5)){
-    Rcpp::stop("In operatingModel::ssf subsetter. Indices not of length 5\n");
-  }
+FLQuantAD operatingModel::ssf(const int biol_no, const Index5& indices_min, const Index5& indices_max) const{
   // Add age range to input indices
-  std::vector<unsigned int> qindices_min = indices_min;
-  qindices_min.insert(qindices_min.begin(), 1);
+  Index6 qindices_min = add_quant(1, indices_min);
   std::vector<unsigned int> dim = biols(biol_no).n().get_dim();
-  std::vector<unsigned int> qindices_max = indices_max;
-  qindices_max.insert(qindices_max.begin(), dim[0]);
+  Index6 qindices_max = add_quant(dim[0], indices_max);
   FLQuantAD exp_z_pre_spwn = get_exp_z_pre_spwn(biol_no, qindices_min, qindices_max);
 
   // Get srp: N*mat*wt*exp(-Fprespwn - m*spwn) summed over age dimension
   FLQuantAD ssf = quant_sum(
-    biols(biol_no).n(qindices_min, qindices_max) *
-    biols(biol_no).fec(qindices_min, qindices_max) *
-    biols(biol_no).mat(qindices_min, qindices_max) * exp_z_pre_spwn);
+    biols(biol_no).n().view(qindices_min, qindices_max) *
+    biols(biol_no).fec().view(qindices_min, qindices_max) *
+    biols(biol_no).mat().view(qindices_min, qindices_max) * exp_z_pre_spwn);
   return ssf;
 }
 
@@ -404,18 +436,14 @@ FLQuantAD operatingModel::ssf(const int biol_no, const std::vector<unsigned int>
  * \param indices_min The minimum indices: year, unit etc (length 5)
  * \param indices_max The maximum indices: year, unit etc (length 5)
  */
-FLQuant operatingModel::f_prop_spwn(const int fishery_no, const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const{
-  // Check indices_min and indices_max are of length 5
-  if ((indices_min.size() != 5) | (indices_max.size() != 5)){
-    Rcpp::stop("In operatingModel::f_prop_spwn subsetter. Indices not of length 5\n");
-  }
+FLQuant operatingModel::f_prop_spwn(const int fishery_no, const int biol_no, const Index5& indices_min, const Index5& indices_max) const{
   // Make an object to dump the result into
   FLQuant propf_out(1, indices_max[0]-indices_min[0]+1, indices_max[1]-indices_min[1]+1, indices_max[2]-indices_min[2]+1, indices_max[3]-indices_min[3]+1, indices_max[4]-indices_min[4]+1);
   // Need to calculate element by element as timing can change over years etc.
   double propf = 0.0;
   // To speed up and not get whole FLQuant each time - indicates problem with way we are accessing FLQuant members
-  FLQuant hperiod = fisheries(fishery_no).hperiod();
-  FLQuant spwn_all = biols(biol_no).spwn();
+  const FLQuant& hperiod = fisheries(fishery_no).hperiod();
+  const FLQuant_param& spwn_all = biols(biol_no).spwn();
   for (unsigned int year_count=indices_min[0]; year_count <= indices_max[0]; ++year_count){
     for (unsigned int unit_count=indices_min[1]; unit_count <= indices_max[1]; ++unit_count){
       for (unsigned int season_count=indices_min[2]; season_count <= indices_max[2]; ++season_count){
@@ -474,8 +502,8 @@ std::vector<adouble> operatingModel::calc_rec(const unsigned int biol_no, const
   unsigned int area = 1;
   unsigned int niter = get_niter();
   // SRP for all units
-  std::vector<unsigned int> srp_indices_min{srp_year, 1, srp_season, area, 1};
-  std::vector<unsigned int> srp_indices_max{srp_year, biol_dim[2], srp_season, area, niter};
+  Index5 srp_indices_min{srp_year, 1, srp_season, area, 1};
+  Index5 srp_indices_max{srp_year, biol_dim[2], srp_season, area, niter};
   FLQuantAD srpq = total_srp(biol_no, srp_indices_min, srp_indices_max);
   if(verbose){Rprintf("total_srp: %f\n", Value(srpq(1,1,1,1,1,1)));}
   // Initial indices of the SR params are those of the recruitment timestep for the Biol
@@ -483,19 +511,9 @@ std::vector<adouble> operatingModel::calc_rec(const unsigned int biol_no, const
   unsigned int initial_params_year = 0;
   unsigned int initial_params_season = 0;
   timestep_to_year_season(rec_timestep, biol_dim[3], initial_params_year, initial_params_season);
-  std::vector<unsigned int> initial_params_indices{initial_params_year, unit, initial_params_season, area, 1};
-  // get recruitment name model pointer
-  std::string srmodel = biols(biol_no).get_srr().get_model_name();
-  // print out
-  //std::cout << srmodel; // for debugging
- // remove part of the formula 
- std::string toRemove = "rec~";
- std::string::size_type i = srmodel.find(toRemove);
- if (i != std::string::npos)
-   srmodel.erase(i, toRemove.length());
-  
+  Index5 initial_params_indices{initial_params_year, unit, initial_params_season, area, 1};
   // predict recruitment
-  FLQuantAD rec = biols(biol_no).predict_recruitment(srpq, initial_params_indices, srmodel);
+  FLQuantAD rec = biols(biol_no).predict_recruitment(srpq, initial_params_indices);
   // Rprintf("rec: %f\n", Value(rec(1,1,1,1,1,1))); // for debugging
   if(verbose) {
     for (unsigned int i=1; i<=niter; ++i){
@@ -503,7 +521,7 @@ std::vector<adouble> operatingModel::calc_rec(const unsigned int biol_no, const
     }
   }
   if(verbose){Rprintf("Leaving operatingModel::calc_rec\n");}
-  return rec.get_data();
+  return std::vector<adouble>(rec.begin(), rec.end());
 }
 
 /*! \name get_f
@@ -524,48 +542,49 @@ std::vector<adouble> operatingModel::calc_rec(const unsigned int biol_no, const
  * \param indices_min The minimum indices quant, year, unit etc (length 6)
  * \param indices_max The maximum indices quant, year, unit etc (length 6)
 */
-FLQuantAD operatingModel::get_f(const int fishery_no, const int catch_no, const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
+FLQuantAD operatingModel::get_f(const int fishery_no, const int catch_no, const int biol_no, const Index6& indices_min, const Index6& indices_max) const {
   bool verbose = false;
   if(verbose){Rprintf("In operatingModel::get_f FCB subsetter\n");}
-  if ((indices_min.size() != 6) | (indices_max.size() != 6)){
-    Rcpp::stop("In operatingModel get_f subsetter. Indices not of length 6\n");
-  }
   
   // Lop off the first value from the indices to get indices without quant - needed for effort and catch_q
-  std::vector<unsigned int> indices_min5(indices_min.begin()+1, indices_min.end());
-  std::vector<unsigned int> indices_max5(indices_max.begin()+1, indices_max.end());
+  const Index5 indices_min5 = drop_quant(indices_min);
+  const Index5 indices_max5 = drop_quant(indices_max);
   
   if(verbose){Rprintf("Getting biomass\n");}
   FLQuantAD biomass = biols(biol_no).biomass(indices_min5, indices_max5);
   
   if(verbose){Rprintf("Got biomass\n");}
-  FLQuantAD sel = fisheries(fishery_no, catch_no).catch_sel()(indices_min, indices_max);
   
   // Need special subsetter for effort as always length 1 in the unit dimension
-  std::vector<unsigned int> effort_indices_min5{indices_min5[0], 1, indices_min5[2], indices_min5[3], indices_min5[4]};  
-  std::vector<unsigned int> effort_indices_max5{indices_max5[0], 1, indices_max5[2], indices_max5[3], indices_max5[4]};  
+  Index5 effort_indices_min5{indices_min5[0], 1, indices_min5[2], indices_min5[3], indices_min5[4]};  
+  Index5 effort_indices_max5{indices_max5[0], 1, indices_max5[2], indices_max5[3], indices_max5[4]};  
   if(verbose){Rprintf("Getting effort\n");}
   FLQuantAD effort = fisheries(fishery_no).effort(effort_indices_min5, effort_indices_max5); // Will always have 1 in the unit dimension
   
   // Get q params as a whole FLQuant - just first 2 'ages' (params)
-  std::vector<unsigned int> qparams_indices_min = indices_min5;
-  qparams_indices_min.insert(qparams_indices_min.begin(), 1); 
-  std::vector<unsigned int> qparams_indices_max = indices_max5;
-  qparams_indices_max.insert(qparams_indices_max.begin(), 2); 
+  Index6 qparams_indices_min = add_quant(1, indices_min5);
+  Index6 qparams_indices_max = add_quant(2, indices_max5);
   FLQuant qparams = fisheries(fishery_no, catch_no).catch_q_params(qparams_indices_min, qparams_indices_max);
   
   // Subset qparams to get FLQ of the indiv params - i.e. seperating into alpha and beta - really faffy
   qparams_indices_min = {1,1,1,1,1,1};
   qparams_indices_max = qparams.get_dim();
   qparams_indices_max[0] = 1;
-  FLQuant qparams1 = qparams(qparams_indices_min, qparams_indices_max);
+  FLQuantView<double> qparams1 = qparams.view(qparams_indices_min, qparams_indices_max);
   qparams_indices_min[0] = 2;
   qparams_indices_max[0] = 2;
-  FLQuant qparams2 = qparams(qparams_indices_min, qparams_indices_max);
-  std::transform(biomass.begin(), biomass.end(), qparams2.begin(), biomass.begin(),
-    [](adouble x, double y) { return pow(x, -1.0 * y); } );
+  FLQuantView<double> qparams2 = qparams.view(qparams_indices_min, qparams_indices_max);
+  std::vector<unsigned int> biomass_dim = biomass.get_dim();
+  for (unsigned int iter_count = 1; iter_count <= biomass_dim[5]; ++iter_count){
+    for (unsigned int area_count = 1; area_count <= biomass_dim[4]; ++area_count){
+      for (unsigned int season_count = 1; season_count <= biomass_dim[3]; ++season_count){
+        for (unsigned int unit_count = 1; unit_count <= biomass_dim[2]; ++unit_count){
+          for (unsigned int year_count = 1; year_count <= biomass_dim[1]; ++year_count){
+            adouble& biomass_element = biomass(1, year_count, unit_count, season_count, area_count, iter_count);
+            biomass_element = pow(biomass_element, -1.0 * qparams2(1, year_count, unit_count, season_count, area_count, iter_count));
+  }}}}}
   biomass = sweep_mult(biomass * qparams1, effort); // Use sweep_mult a effort always has length 1 in unit while biomass and qparams may have more
-  FLQuantAD fout = sweep_mult(biomass, sel);
+  FLQuantAD fout = sweep_mult(biomass, fisheries(fishery_no, catch_no).catch_sel()(indices_min, indices_max));
   return fout;
 }
 
@@ -578,8 +597,8 @@ FLQuantAD operatingModel::get_f(const int fishery_no, const int catch_no, const
 FLQuantAD operatingModel::get_f(const int fishery_no, const int catch_no, const int biol_no) const {
 
   // Just call the subset method with full indices
-  std::vector<unsigned int> indices_max = biols(biol_no).n().get_dim();
-  std::vector<unsigned int> indices_min(6,1);
+  Index6 indices_max = biols(biol_no).n().get_dim();
+  Index6 indices_min{1,1,1,1,1,1};
   FLQuantAD f = get_f(fishery_no, catch_no, biol_no, indices_min, indices_max);
   return f;
 }
@@ -589,7 +608,7 @@ FLQuantAD operatingModel::get_f(const int fishery_no, const int catch_no, const
  * \param indices_min minimum indices for subsetting (quant - iter, vector of length 6)
  * \param indices_max maximum indices for subsetting (quant - iter, vector of length 6)
  */
-FLQuantAD operatingModel::get_f(const unsigned int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const{
+FLQuantAD operatingModel::get_f(const unsigned int biol_no, const Index6& indices_min, const Index6& indices_max) const{
   bool verbose = false;
   if(verbose){Rprintf("In operatingModel::get_f biol subsetter\n");}
   if (biol_no > biols.get_nbiols()){
@@ -614,8 +633,8 @@ FLQuantAD operatingModel::get_f(const unsigned int biol_no, const std::vector<un
  * \param biol_no the position of the biol within the biols (starting at 1).
  */
 FLQuantAD operatingModel::get_f(const int biol_no) const {
-  std::vector<unsigned int> indices_max = biols(biol_no).n().get_dim();
-  std::vector<unsigned int> indices_min(6,1);
+  Index6 indices_max = biols(biol_no).n().get_dim();
+  Index6 indices_min{1,1,1,1,1,1};
   FLQuantAD f = get_f(biol_no, indices_min, indices_max);
   return f;
 }
@@ -639,10 +658,7 @@ FLQuantAD operatingModel::get_f(const int biol_no) const {
  * \param indices_min minimum indices for subsetting (quant - iter, vector of length 6)
  * \param indices_max maximum indices for subsetting (quant - iter, vector of length 6)
  */
-FLQuantAD operatingModel::get_nunit_z(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
-  if ((indices_min.size() != 6) | (indices_max.size() != 6)){
-    Rcpp::stop("In operatingModel get_unit_z subsetter. Indices not of length 6\n");
-  }
+FLQuantAD operatingModel::get_nunit_z(const int biol_no, const Index6& indices_min, const Index6& indices_max) const {
   FLQuantAD n = biols(biol_no).n(indices_min, indices_max);
   FLQuantAD surv = survivors(biol_no, indices_min, indices_max);
   FLQuantAD nunit_z = -1.0 * log(unit_sum(surv) / unit_sum(n));
@@ -677,12 +693,9 @@ FLQuantAD operatingModel::get_nunit_z(const int biol_no, const std::vector<unsig
  * \param indices_min minimum indices for subsetting (quant - iter, vector of length 6)
  * \param indices_max maximum indices for subsetting (quant - iter, vector of length 6)
  */
-FLQuantAD operatingModel::get_nunit_f(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
+FLQuantAD operatingModel::get_nunit_f(const int biol_no, const Index6& indices_min, const Index6& indices_max) const {
   bool verbose = false;
   if(verbose){Rprintf("\nIn operatingModel::get_nunit_f biol only\n");}
-  if ((indices_min.size() != 6) | (indices_max.size() != 6)){
-    Rcpp::stop("In operatingModel get_nunit_f B subsetter. Indices not of length 6\n");
-  }
   // Test for shared catch
   if (ctrl.shared_catch(biol_no)){
     Rcpp::stop("In operatingModel get_nunit_f B. Not possible to get unit combined F of a Biol that is fished by a Catch that also fishes on other Biols. This is because it is not possible to get the portion of catches of that Catch that come from a particular Biol.\n");
@@ -711,10 +724,7 @@ FLQuantAD operatingModel::get_nunit_f(const int biol_no, const std::vector<unsig
  * \param indices_min minimum indices for subsetting (quant - iter, vector of length 6)
  * \param indices_max maximum indices for subsetting (quant - iter, vector of length 6)
  */
-FLQuantAD operatingModel::get_nunit_f(const int fishery_no, const int catch_no, const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
-  if ((indices_min.size() != 6) | (indices_max.size() != 6)){
-    Rcpp::stop("In operatingModel get_nunit_f FCB subsetter. Indices not of length 6\n");
-  }
+FLQuantAD operatingModel::get_nunit_f(const int fishery_no, const int catch_no, const int biol_no, const Index6& indices_min, const Index6& indices_max) const {
   // Test for shared catch
   if (ctrl.shared_catch(biol_no)){
     Rcpp::stop("In operatingModel get_nunit_f FCB. Not possible to get unit combined F of a Biol that is fished by a Catch that also fishes on other Biols. This is because it is not possible to get the portion of catches of that Catch that come from a particular Biol.\n");
@@ -736,12 +746,9 @@ FLQuantAD operatingModel::get_nunit_f(const int fishery_no, const int catch_no,
  * \param indices_max maximum indices for subsetting (quant - iter, vector of length 6)
  */
 // TODO: ADD point in time
-FLQuantAD operatingModel::survivors(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const{
+FLQuantAD operatingModel::survivors(const int biol_no, const Index6& indices_min, const Index6& indices_max) const{
   bool verbose = false;
   if(verbose){Rprintf("In operatingModel::survivors\n");}
-  if ((indices_min.size() != 6) | (indices_max.size() != 6)){
-    Rcpp::stop("In operatingModel survivors subsetter. Indices not of length 6\n");
-  }
   if(verbose){Rprintf("About to get F\n");}
       
   FLQuantAD z_temp = get_f(biol_no, indices_min, indices_max) + biols(biol_no).m(indices_min, indices_max);
@@ -784,8 +791,8 @@ void operatingModel::project_biols(const int timestep){
     unsigned int prev_year = 1;
     unsigned int prev_season = 1;
     timestep_to_year_season(timestep-1, biol_dim[3], prev_year, prev_season);
-    std::vector<unsigned int> prev_indices_min{1, prev_year, 1, prev_season, area, 1};
-    std::vector<unsigned int> prev_indices_max{biol_dim[0], prev_year, biol_dim[2], prev_season, area, niter};
+    Index6 prev_indices_min{1, prev_year, 1, prev_season, area, 1};
+    Index6 prev_indices_max{biol_dim[0], prev_year, biol_dim[2], prev_season, area, niter};
     
     // Get abundance at end of preceding timestep
     if(verbose){Rprintf("Getting survivors from previous timestep\n");}
@@ -911,9 +918,9 @@ void operatingModel::project_fisheries(const int timestep){
   std::vector<FLQuantAD> total_z(biols.get_nbiols());
   // Fill it up with natural mortality to start with
   for (unsigned int biol_count=1; biol_count <= biols.get_nbiols(); ++biol_count){
-    std::vector<unsigned int> indices_min{1, year, 1, season, area, 1};
+    Index6 indices_min{1, year, 1, season, area, 1};
     std::vector<unsigned int> biol_dim = biols(biol_count).n().get_dim();
-    std::vector<unsigned int> indices_max{biol_dim[0], year, biol_dim[2], season, area, niter};
+    Index6 indices_max{biol_dim[0], year, biol_dim[2], season, area, niter};
     total_z[biol_count - 1] = biols(biol_count).m(indices_min, indices_max);
     //// Exiting landings and discards in the timestep
     //Rprintf("Existing landings and discards\n");
@@ -936,9 +943,9 @@ void operatingModel::project_fisheries(const int timestep){
   for (int FCB_counter=0; FCB_counter < FCB.nrow(); ++FCB_counter){
     //Rprintf("FCB counter %i Biol %i\n", FCB_counter, FCB(FCB_counter, 2)); 
     // Indices for subsetting the timestep
-    std::vector<unsigned int> indices_min{1, year, 1, season, area, 1};
+    Index6 indices_min{1, year, 1, season, area, 1};
     std::vector<unsigned int> biol_dim = biols(FCB(FCB_counter, 2)).n().get_dim();
-    std::vector<unsigned int> indices_max{biol_dim[0], year, biol_dim[2], season, area, niter};
+    Index6 indices_max{biol_dim[0], year, biol_dim[2], season, area, niter};
     partial_f[FCB_counter] = get_f(FCB(FCB_counter, 0), FCB(FCB_counter, 1), FCB(FCB_counter, 2), indices_min, indices_max);
     // Add the partial f to the total z list
     total_z[FCB(FCB_counter, 2)-1] = total_z[FCB(FCB_counter, 2)-1] + partial_f[FCB_counter];
@@ -953,8 +960,8 @@ void operatingModel::project_fisheries(const int timestep){
       //Rprintf("fishery_count: %i catch_count: %i\n", fishery_count, catch_count);
       // Indices for subsetting the timestep
       std::vector<unsigned int> catch_dim = fisheries(fishery_count, catch_count).landings_n().get_dim();
-      std::vector<unsigned int> indices_min{1, year, 1, season, area, 1};
-      std::vector<unsigned int> indices_max{catch_dim[0], year, catch_dim[2], season, area, niter};
+      Index6 indices_min{1, year, 1, season, area, 1};
+      Index6 indices_max{catch_dim[0], year, catch_dim[2], season, area, niter};
       // Make temporary catch of right size fillled with 0s
       std::vector<unsigned int> catch_temp_dims(6); // Could just use catch_dim from above but that may have multiple areas and units in the future
       std::transform(indices_max.begin(), indices_max.end(), indices_min.begin(), catch_temp_dims.begin(), [] (unsigned int x, unsigned int y) {return x-y+1;});
@@ -1010,6 +1017,9 @@ Rcpp::IntegerMatrix operatingModel::run(const double effort_mult_initial, std::v
   // Effort multiplier is the independent value. There is one independent values for each effort, i.e. for each fishery
   auto neffort = fisheries.get_nfisheries();
   if(verbose){Rprintf("Number of fisheries to solve effort for: %i\n", neffort);}
+  // The data of FLQuant temporaries comes from the arena, which is rewound for each target
+  FLQuant_arena_scope arena_scope;
+  FLQuant_arena& arena = FLQuant_arena::get();
   // The target timesteps are contiguous.
   // Update the biology in the first target timestep.
   // This ensures that we have abundance numbers in the first timestep of the projection.
@@ -1033,11 +1043,13 @@ Rcpp::IntegerMatrix operatingModel::run(const double effort_mult_initial, std::v
   if(verbose){Rprintf("\nTargets to solve: %i \n", ntarget);}
   // Place to store the codes from the solver routine. One code per target per iter. Ntarget x iter
   Rcpp::IntegerMatrix solver_codes(ntarget,niter);
+  arena_counters.assign(ntarget, FLQuant_arena_counters{0, 0, 0});
   // Loop over targets and solve all simultaneous targets in that target set
   // e.g. With 2 fisheries with 2 efforts, we can set 2 catch targets to be solved at the same time
   // Indexing of targets starts at 1
   for (unsigned int target_count = 1; target_count <= ntarget; ++target_count){
     if(verbose){Rprintf("\nProcessing target: %i\n", target_count);}
+    arena.reset();
     auto nsim_targets = ctrl.get_nsim_target(target_count);
     //if(verbose){Rprintf("Number of simultaneous targets: %i\n", nsim_targets);}
     // Timestep in which we find effort is the same for all simultaneous targets in a target set
@@ -1190,6 +1202,7 @@ Rcpp::IntegerMatrix operatingModel::run(const double effort_mult_initial, std::v
     //Rprintf("proj_time: %f \n", proj_time.count());
     //Rprintf("tape_time: %f \n", tape_time.count());
     //Rprintf("solv_time: %f \n", solv_time.count());
+    arena_counters[target_count-1] = arena.get_counters();
   }
   if(verbose){Rprintf("Leaving run\n\n");}
   //auto tendrun = std::chrono::high_resolution_clock::now();
@@ -1209,7 +1222,7 @@ Rcpp::IntegerMatrix operatingModel::run(const double effort_mult_initial, std::v
  * \param indices_min The minimum range of the returned FLQuant. Length should be appropriate for the target type (e.g. 6 for Fbar, 5 for SSB).
  * \param indices_max The maximum range of the returned FLQuant. Length should be appropriate for the target type (e.g. 6 for Fbar, 5 for SSB).
  */
-FLQuantAD operatingModel::eval_om(const fwdControlTargetType target_type, const int fishery_no, const int catch_no, const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) {
+FLQuantAD operatingModel::eval_om(const fwdControlTargetType target_type, const int fishery_no, const int catch_no, const int biol_no, const std::vector<unsigned int>& indices_min, const std::vector<unsigned int>& indices_max) {
   bool verbose = false;
   if(verbose){Rprintf("\nInside eval_om\n");}
   if(verbose){Rprintf("Fishery: %i, Catch: %i, Biol: %i\n", fishery_no, catch_no, biol_no);}
@@ -1624,7 +1637,7 @@ std::vector<adouble> operatingModel::get_target_value_hat(const int target_no, c
       Rprintf("Relative target: %f\n", Value(target_value(1,1,1,1,1,1)));
     }
   }
-  std::vector<adouble> value = target_value.get_data();
+  std::vector<adouble> value(target_value.begin(), target_value.end());
   if(verbose){Rprintf("Leaving get_target_value_hat\n\n");}
   return value;
 } 
@@ -1717,10 +1730,10 @@ void operatingModel::get_target_hat_indices(std::vector<unsigned int>& indices_m
     // Need age names - get from biol or catch (only they have age structure - fishery does not)
     std::vector<std::string> age_names;
     if(!biol_na){
-      age_names = Rcpp::as<std::vector<std::string> >(biols(biol_no).n().get_dimnames()[0]);
+      age_names = biols(biol_no).n().get_dimnames()[0];
     }
     else if (!catch_na){
-      age_names = Rcpp::as<std::vector<std::string> >(fisheries(fishery_no, catch_no).landings_n().get_dimnames()[0]);
+      age_names = fisheries(fishery_no, catch_no).landings_n().get_dimnames()[0];
     }
     else {
       Rcpp::stop("In operatingModel::get_target_hat_indices. Unable to get age range as biol_no and catch_no are NA.\n");
@@ -1848,10 +1861,7 @@ std::vector<double> operatingModel::get_target_value(const int target_no, const
  * \param indices_min The minimum indices quant, year, unit etc (length 6)
  * \param indices_max The maximum indices quant, year, unit etc (length 6)
 */
-FLQuantAD operatingModel::fbar(const int fishery_no, const int catch_no, const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
-  if((indices_min.size() != 6) | (indices_max.size() != 6)){
-    Rcpp::stop("In operatingModel fbar FCB method. indices_min and max must be of length 6\n");
-  }
+FLQuantAD operatingModel::fbar(const int fishery_no, const int catch_no, const int biol_no, const Index6& indices_min, const Index6& indices_max) const {
   FLQuantAD fbar;
   // If a single unit is asked for, get F using get_f method
   if (indices_min[2] == indices_max[2]){
@@ -1871,15 +1881,12 @@ FLQuantAD operatingModel::fbar(const int fishery_no, const int catch_no, const i
  * \param indices_min The minimum indices quant, year, unit etc (length 6)
  * \param indices_max The maximum indices quant, year, unit etc (length 6)
  */
-FLQuantAD operatingModel::fbar(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
+FLQuantAD operatingModel::fbar(const int biol_no, const Index6& indices_min, const Index6& indices_max) const {
   bool verbose = false;
   if(verbose){Rprintf("\nIn operatingModel::fbar biol only\n");}
   
   // DEBUG Rprintf("%i\n", indices_max.size());
 
-  if((indices_min.size() != 6) | (indices_max.size() != 6)){
-    Rcpp::stop("In operatingModel fbar B method. indices_min and max must be of length 6\n");
-  }
   FLQuantAD fbar;
   // If a single unit is asked for, get F using get_f method
   if (indices_min[2] == indices_max[2]){
@@ -1907,16 +1914,11 @@ FLQuantAD operatingModel::fbar(const int biol_no, const std::vector<unsigned int
  * \param indices_min minimum indices for subsetting (year - iter, integer vector of length 5)
  * \param indices_max maximum indices for subsetting (year - iter, integer vector of length 5)
  */
-FLQuantAD operatingModel::landings(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
-  if((indices_min.size() != 5) | (indices_max.size() != 5)){
-    Rcpp::stop("In operatingModel landings on a biol subset method. indices_min and max must be of length 5\n");
-  }
+FLQuantAD operatingModel::landings(const int biol_no, const Index5& indices_min, const Index5& indices_max) const {
   // Indices for the full FLQ, i.e. including first dimension
   std::vector<unsigned int> dim = biols(biol_no).n().get_dim();
-  std::vector<unsigned int> quant_indices_min = indices_min;
-  std::vector<unsigned int> quant_indices_max = indices_max;
-  quant_indices_min.insert(quant_indices_min.begin(), 1);
-  quant_indices_max.insert(quant_indices_max.begin(), dim[0]);
+  Index6 quant_indices_min = add_quant(1, indices_min);
+  Index6 quant_indices_max = add_quant(dim[0], indices_max);
   // Empty quant for storage
   FLQuantAD total_landings(1, indices_max[0] - indices_min[0] + 1, indices_max[1] - indices_min[1] + 1, indices_max[2] - indices_min[2] + 1, indices_max[3] - indices_min[3] + 1, indices_max[4] - indices_min[4] + 1); 
   total_landings.fill(0.0);
@@ -1945,16 +1947,11 @@ FLQuantAD operatingModel::landings(const int biol_no, const std::vector<unsigned
  * \param indices_min minimum indices for subsetting (year - iter, integer vector of length 5)
  * \param indices_max maximum indices for subsetting (year - iter, integer vector of length 5)
  */
-FLQuantAD operatingModel::discards(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
-  if((indices_min.size() != 5) | (indices_max.size() != 5)){
-    Rcpp::stop("In operatingModel discards on a biol subset method. indices_min and max must be of length 5\n");
-  }
+FLQuantAD operatingModel::discards(const int biol_no, const Index5& indices_min, const Index5& indices_max) const {
   // Indices for the full FLQ, i.e. including first dimension
   std::vector<unsigned int> dim = biols(biol_no).n().get_dim();
-  std::vector<unsigned int> quant_indices_min = indices_min;
-  std::vector<unsigned int> quant_indices_max = indices_max;
-  quant_indices_min.insert(quant_indices_min.begin(), 1);
-  quant_indices_max.insert(quant_indices_max.begin(), dim[0]);
+  Index6 quant_indices_min = add_quant(1, indices_min);
+  Index6 quant_indices_max = add_quant(dim[0], indices_max);
   // Empty quant for storage
   FLQuantAD total_discards(1, indices_max[0] - indices_min[0] + 1, indices_max[1] - indices_min[1] + 1, indices_max[2] - indices_min[2] + 1, indices_max[3] - indices_min[3] + 1, indices_max[4] - indices_min[4] + 1); 
   total_discards.fill(0.0);
@@ -1984,10 +1981,7 @@ FLQuantAD operatingModel::discards(const int biol_no, const std::vector<unsigned
  * \param indices_min minimum indices for subsetting (year - iter, integer vector of length 5)
  * \param indices_max maximum indices for subsetting (year - iter, integer vector of length 5)
  */
-FLQuantAD operatingModel::catches(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
-  if((indices_min.size() != 5) | (indices_max.size() != 5)){
-    Rcpp::stop("In operatingModel catches on a biol subset method. indices_min and max must be of length 5\n");
-  }
+FLQuantAD operatingModel::catches(const int biol_no, const Index5& indices_min, const Index5& indices_max) const {
   FLQuantAD total_catches = landings(biol_no, indices_min, indices_max) + discards(biol_no, indices_min, indices_max);
   return total_catches;
 }
@@ -2002,10 +1996,7 @@ FLQuantAD operatingModel::catches(const int biol_no, const std::vector<unsigned
  * \param indices_min minimum indices for subsetting (year - iter, integer vector of length 6)
  * \param indices_max maximum indices for subsetting (year - iter, integer vector of length 6)
  */
-FLQuantAD operatingModel::landings_n(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
-  if((indices_min.size() != 6) | (indices_max.size() != 6)){
-    Rcpp::stop("In operatingModel landings_n on a biol subset method. indices_min and max must be of length 6\n");
-  }
+FLQuantAD operatingModel::landings_n(const int biol_no, const Index6& indices_min, const Index6& indices_max) const {
   // Empty quant for storage
   FLQuantAD total_landings_n(indices_max[0] - indices_min[0] + 1, indices_max[1] - indices_min[1] + 1, indices_max[2] - indices_min[2] + 1, indices_max[3] - indices_min[3] + 1, indices_max[4] - indices_min[4] + 1, indices_max[5] - indices_min[5] + 1); 
   total_landings_n.fill(0.0);
@@ -2034,10 +2025,7 @@ FLQuantAD operatingModel::landings_n(const int biol_no, const std::vector<unsign
  * \param indices_min minimum indices for subsetting (year - iter, integer vector of length 6)
  * \param indices_max maximum indices for subsetting (year - iter, integer vector of length 6)
  */
-FLQuantAD operatingModel::discards_n(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
-  if((indices_min.size() != 6) | (indices_max.size() != 6)){
-    Rcpp::stop("In operatingModel discards_n on a biol subset method. indices_min and max must be of length 6\n");
-  }
+FLQuantAD operatingModel::discards_n(const int biol_no, const Index6& indices_min, const Index6& indices_max) const {
   // Empty quant for storage
   FLQuantAD total_discards_n(indices_max[0] - indices_min[0] + 1, indices_max[1] - indices_min[1] + 1, indices_max[2] - indices_min[2] + 1, indices_max[3] - indices_min[3] + 1, indices_max[4] - indices_min[4] + 1, indices_max[5] - indices_min[5] + 1); 
   total_discards_n.fill(0.0);
@@ -2066,10 +2054,7 @@ FLQuantAD operatingModel::discards_n(const int biol_no, const std::vector<unsign
  * \param indices_min minimum indices for subsetting (age - iter, integer vector of length 6)
  * \param indices_max maximum indices for subsetting (age - iter, integer vector of length 6)
  */
-FLQuantAD operatingModel::catch_n(const int biol_no, const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
-  if((indices_min.size() != 6) | (indices_max.size() != 6)){
-    Rcpp::stop("In operatingModel catch_n on a biol subset method. indices_min and max must be of length 6\n");
-  }
+FLQuantAD operatingModel::catch_n(const int biol_no, const Index6& indices_min, const Index6& indices_max) const {
   FLQuantAD total_catch_n = landings_n(biol_no, indices_min, indices_max) + discards_n(biol_no, indices_min, indices_max);
   return total_catch_n;
 }
@@ -2086,16 +2071,11 @@ FLQuantAD operatingModel::catch_n(const int biol_no, const std::vector<unsigned
  * \param indices_min minimum indices for subsetting (year - iter, integer vector of length 5)
  * \param indices_max maximum indices for subsetting (year - iter, integer vector of length 5)
  */
-FLQuantAD operatingModel::ssb_start(const int biol_no,  const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
-  if((indices_min.size() != 5) | (indices_max.size() != 5)){
-    Rcpp::stop("In operatingModel ssb_start. indices_min and max must be of length 6\n");
-  }
+FLQuantAD operatingModel::ssb_start(const int biol_no,  const Index5& indices_min, const Index5& indices_max) const {
   // Need bigger indices
   std::vector<unsigned int> dim = biols(biol_no).n().get_dim();
-  std::vector<unsigned int> qindices_min = indices_min;
-  qindices_min.insert(qindices_min.begin(), 1);
-  std::vector<unsigned int> qindices_max = indices_max;
-  qindices_max.insert(qindices_max.begin(), dim[0]);
+  Index6 qindices_min = add_quant(1, indices_min);
+  Index6 qindices_max = add_quant(dim[0], indices_max);
   // SSB = n * wt * mat
   // Calc SSB - without unit sum - done in eval_om
   FLQuantAD ssb = quant_sum(biols(biol_no).n(qindices_min, qindices_max) * biols(biol_no).wt(qindices_min, qindices_max) * biols(biol_no).mat(qindices_min, qindices_max));
@@ -2114,16 +2094,11 @@ FLQuantAD operatingModel::ssb_start(const int biol_no,  const std::vector<unsign
  * \param indices_min minimum indices for subsetting (year - iter, integer vector of length 5)
  * \param indices_max maximum indices for subsetting (year - iter, integer vector of length 5)
  */
-FLQuantAD operatingModel::biomass_start(const int biol_no,  const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
-  if((indices_min.size() != 5) | (indices_max.size() != 5)){
-    Rcpp::stop("In operatingModel ssb_start. indices_min and max must be of length 6\n");
-  }
+FLQuantAD operatingModel::biomass_start(const int biol_no,  const Index5& indices_min, const Index5& indices_max) const {
   // Need bigger indices
   std::vector<unsigned int> dim = biols(biol_no).n().get_dim();
-  std::vector<unsigned int> qindices_min = indices_min;
-  qindices_min.insert(qindices_min.begin(), 1);
-  std::vector<unsigned int> qindices_max = indices_max;
-  qindices_max.insert(qindices_max.begin(), dim[0]);
+  Index6 qindices_min = add_quant(1, indices_min);
+  Index6 qindices_max = add_quant(dim[0], indices_max);
   // biomass = n * wt
   // Calc biomass - without unit sum - done in eval_om
   FLQuantAD biomass = quant_sum(biols(biol_no).n(qindices_min, qindices_max) * biols(biol_no).wt(qindices_min, qindices_max));
@@ -2142,16 +2117,11 @@ FLQuantAD operatingModel::biomass_start(const int biol_no,  const std::vector<un
  * \param indices_min minimum indices for subsetting (year - iter, integer vector of length 5)
  * \param indices_max maximum indices for subsetting (year - iter, integer vector of length 5)
  */
-FLQuantAD operatingModel::ssb_end(const int biol_no,  const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
-  if((indices_min.size() != 5) | (indices_max.size() != 5)){
-    Rcpp::stop("In operatingModel ssb_end. indices_min and max must be of length 6\n");
-  }
+FLQuantAD operatingModel::ssb_end(const int biol_no,  const Index5& indices_min, const Index5& indices_max) const {
   // Need bigger indices
   std::vector<unsigned int> dim = biols(biol_no).n().get_dim();
-  std::vector<unsigned int> qindices_min = indices_min;
-  qindices_min.insert(qindices_min.begin(), 1);
-  std::vector<unsigned int> qindices_max = indices_max;
-  qindices_max.insert(qindices_max.begin(), dim[0]);
+  Index6 qindices_min = add_quant(1, indices_min);
+  Index6 qindices_max = add_quant(dim[0], indices_max);
   FLQuantAD surv = survivors(biol_no, qindices_min, qindices_max);
   // SSB = survivors * wt * mat
   // Calc SSB - without unit sum - done in eval_om
@@ -2171,16 +2141,11 @@ FLQuantAD operatingModel::ssb_end(const int biol_no,  const std::vector<unsigned
  * \param indices_min minimum indices for subsetting (year - iter, integer vector of length 5)
  * \param indices_max maximum indices for subsetting (year - iter, integer vector of length 5)
  */
-FLQuantAD operatingModel::inmb_end(const int biol_no,  const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
-  if((indices_min.size() != 5) | (indices_max.size() != 5)){
-    Rcpp::stop("In operatingModel inmb_end. indices_min and max must be of length 6\n");
-  }
+FLQuantAD operatingModel::inmb_end(const int biol_no,  const Index5& indices_min, const Index5& indices_max) const {
   // Need bigger indices
   std::vector<unsigned int> dim = biols(biol_no).n().get_dim();
-  std::vector<unsigned int> qindices_min = indices_min;
-  qindices_min.insert(qindices_min.begin(), 1);
-  std::vector<unsigned int> qindices_max = indices_max;
-  qindices_max.insert(qindices_max.begin(), dim[0]);
+  Index6 qindices_min = add_quant(1, indices_min);
+  Index6 qindices_max = add_quant(dim[0], indices_max);
   // survivors
   FLQuantAD surv = survivors(biol_no, qindices_min, qindices_max);
   // ISB = survivors * wt * (1 - mat)
@@ -2201,16 +2166,11 @@ FLQuantAD operatingModel::inmb_end(const int biol_no,  const std::vector<unsigne
  * \param indices_min minimum indices for subsetting (year - iter, integer vector of length 5)
  * \param indices_max maximum indices for subsetting (year - iter, integer vector of length 5)
  */
-FLQuantAD operatingModel::indb(const int biol_no,  const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
-  if((indices_min.size() != 5) | (indices_max.size() != 5)){
-    Rcpp::stop("In operatingModel indb. indices_min and max must be of length 6\n");
-  }
+FLQuantAD operatingModel::indb(const int biol_no,  const Index5& indices_min, const Index5& indices_max) const {
   // Need bigger indices
   std::vector<unsigned int> dim = biols(biol_no).n().get_dim();
-  std::vector<unsigned int> qindices_min = indices_min;
-  qindices_min.insert(qindices_min.begin(), 1);
-  std::vector<unsigned int> qindices_max = indices_max;
-  qindices_max.insert(qindices_max.begin(), dim[0]);
+  Index6 qindices_min = add_quant(1, indices_min);
+  Index6 qindices_max = add_quant(dim[0], indices_max);
   // z
   FLQuantAD z_temp = get_f(biol_no, qindices_min, qindices_max) + biols(biol_no).m(qindices_min, qindices_max);
   FLQuantAD survivors = biols(biol_no).n(qindices_min, qindices_max) * exp(-0.6 * z_temp);
@@ -2233,10 +2193,7 @@ FLQuantAD operatingModel::indb(const int biol_no,  const std::vector<unsigned in
  * \param indices_min minimum indices for subsetting (year - iter, integer vector of length 5)
  * \param indices_max maximum indices for subsetting (year - iter, integer vector of length 5)
  */
-FLQuantAD operatingModel::biomass_end(const int biol_no,  const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const {
-  if((indices_min.size() != 5) | (indices_max.size() != 5)){
-    Rcpp::stop("In operatingModel biomass_end. indices_min and max must be of length 6\n");
-  }
+FLQuantAD operatingModel::biomass_end(const int biol_no,  const Index5& indices_min, const Index5& indices_max) const {
   // Check that only one timestep is asked for
   if ((indices_min[0] != indices_max[0]) | (indices_min[2] != indices_max[2])){
     Rcpp::stop("In operatingModel biomass_end. Year and season of indices_min and indices_max must be the same. Only one timestep allowed.\n");
@@ -2244,10 +2201,8 @@ FLQuantAD operatingModel::biomass_end(const int biol_no,  const std::vector<unsi
   std::vector<unsigned int> dim = biols(biol_no).n().get_dim();
   // Calc biomass - without unit sum - done in eval_om
   // Need bigger indices
-  std::vector<unsigned int> qindices_min = indices_min;
-  qindices_min.insert(qindices_min.begin(), 1);
-  std::vector<unsigned int> qindices_max = indices_max;
-  qindices_max.insert(qindices_max.begin(), dim[0]);
+  Index6 qindices_min = add_quant(1, indices_min);
+  Index6 qindices_max = add_quant(dim[0], indices_max);
   // Biomass = survivors * wt
   FLQuantAD surv = survivors(biol_no, qindices_min, qindices_max);
   FLQuantAD biomass = quant_sum(surv * biols(biol_no).wt(qindices_min, qindices_max));
@@ -2264,16 +2219,10 @@ FLQuantAD operatingModel::biomass_end(const int biol_no,  const std::vector<unsi
  * \param indices_min minimum indices for subsetting (year - iter, integer vector of length 5)
  * \param indices_max maximum indices for subsetting (year - iter, integer vector of length 5)
  */
-FLQuantAD operatingModel::ssb_spawn(const int biol_no,  const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const{
-  // Check indices_min and indices_max are of length 5
-  if ((indices_min.size() != 5) | (indices_max.size() != 5)){
-    Rcpp::stop("In operatingModel::ssb_spawn subsetter. Indices not of length 5\n");
-  }
+FLQuantAD operatingModel::ssb_spawn(const int biol_no,  const Index5& indices_min, const Index5& indices_max) const{
   // Check for NA in spwn - if any value of spwn across indices range is NA - stop
-  std::vector<unsigned int> qindices_min = indices_min;
-  qindices_min.insert(qindices_min.begin(), 1);
-  std::vector<unsigned int> qindices_max = indices_max;
-  qindices_max.insert(qindices_max.begin(), 1);
+  Index6 qindices_min = add_quant(1, indices_min);
+  Index6 qindices_max = add_quant(1, indices_max);
   FLQuant spwn = biols(biol_no).spwn(qindices_min, qindices_max);
   for (const auto& it : spwn){
     if (Rcpp::NumericVector::is_na(it)){
@@ -2301,16 +2250,10 @@ FLQuantAD operatingModel::ssb_spawn(const int biol_no,  const std::vector<unsign
  * \param indices_min minimum indices for subsetting (year - iter, integer vector of length 5)
  * \param indices_max maximum indices for subsetting (year - iter, integer vector of length 5)
  */
-FLQuantAD operatingModel::biomass_spawn(const int biol_no,  const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) const{
-  // Check indices_min and indices_max are of length 5
-  if ((indices_min.size() != 5) | (indices_max.size() != 5)){
-    Rcpp::stop("In operatingModel::biomass_spawn subsetter. Indices not of length 5\n");
-  }
+FLQuantAD operatingModel::biomass_spawn(const int biol_no,  const Index5& indices_min, const Index5& indices_max) const{
   // Check for NA in spwn - if any value of spwn across indices range is NA - stop
-  std::vector<unsigned int> qindices_min = indices_min;
-  qindices_min.insert(qindices_min.begin(), 1);
-  std::vector<unsigned int> qindices_max = indices_max;
-  qindices_max.insert(qindices_max.begin(), 1);
+  Index6 qindices_min = add_quant(1, indices_min);
+  Index6 qindices_max = add_quant(1, indices_max);
   FLQuant spwn = biols(biol_no).spwn(qindices_min, qindices_max);
   for (const auto& it : spwn){
     if (Rcpp::NumericVector::is_na(it)){
@@ -2339,11 +2282,7 @@ FLQuantAD operatingModel::biomass_spawn(const int biol_no,  const std::vector<un
  * \param indices_min minimum indices for subsetting (year - iter, integer vector of length 5)
  * \param indices_max maximum indices for subsetting (year - iter, integer vector of length 5)
  */
-FLQuantAD operatingModel::ssb_flash(const int biol_no,  const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) {
-  // Check indices_min and indices_max are of length 5
-  if ((indices_min.size() != 5) | (indices_max.size() != 5)){
-    Rcpp::stop("In operatingModel::ssb_flash subsetter. Indices not of length 5\n");
-  }
+FLQuantAD operatingModel::ssb_flash(const int biol_no,  const Index5& indices_min, const Index5& indices_max) {
   // Check a single timestep
   if((indices_min[0] != indices_max[0]) | (indices_min[2] != indices_max[2])){
     Rcpp::stop("In operatingModel::ssb_flash subsetter. Only one timestep allowed in subsetting.\n");
@@ -2370,16 +2309,14 @@ FLQuantAD operatingModel::ssb_flash(const int biol_no,  const std::vector<unsign
     }
     else {
       project_biols(timestep);
-      std::vector<unsigned int> next_indices_min = indices_min;
-      std::vector<unsigned int> next_indices_max = indices_max;
+      Index5 next_indices_min = indices_min;
+      Index5 next_indices_max = indices_max;
       timestep_to_year_season(timestep, biol_dim[3], next_indices_min[0], next_indices_min[2]);
       next_indices_max[0] = next_indices_min[0];
       next_indices_max[2] = next_indices_min[2];
       // Check for NA in spwn in next time step - if any value of spwn across indices range is NA - stop
-      std::vector<unsigned int> qindices_min = next_indices_min;
-      qindices_min.insert(qindices_min.begin(), 1);
-      std::vector<unsigned int> qindices_max = next_indices_max;
-      qindices_max.insert(qindices_max.begin(), 1);
+      Index6 qindices_min = add_quant(1, next_indices_min);
+      Index6 qindices_max = add_quant(1, next_indices_max);
       FLQuant spwn = biols(biol_no).spwn(qindices_min, qindices_max);
       for (const auto& it : spwn){
         if (Rcpp::NumericVector::is_na(it)){
@@ -2403,11 +2340,7 @@ FLQuantAD operatingModel::ssb_flash(const int biol_no,  const std::vector<unsign
  * \param indices_min minimum indices for subsetting (year - iter, integer vector of length 5)
  * \param indices_max maximum indices for subsetting (year - iter, integer vector of length 5)
  */
-FLQuantAD operatingModel::biomass_flash(const int biol_no,  const std::vector<unsigned int> indices_min, const std::vector<unsigned int> indices_max) {
-  // Check indices_min and indices_max are of length 5
-  if ((indices_min.size() != 5) | (indices_max.size() != 5)){
-    Rcpp::stop("In operatingModel::biomass_flash subsetter. Indices not of length 5\n");
-  }
+FLQuantAD operatingModel::biomass_flash(const int biol_no,  const Index5& indices_min, const Index5& indices_max) {
   // Check a single timestep
   if((indices_min[0] != indices_max[0]) | (indices_min[2] != indices_max[2])){
     Rcpp::stop("In operatingModel::biomass_flash subsetter. Only one timestep allowed in subsetting.\n");
@@ -2433,16 +2366,14 @@ FLQuantAD operatingModel::biomass_flash(const int biol_no,  const std::vector<un
     }
     else {
       project_biols(timestep);
-      std::vector<unsigned int> next_indices_min = indices_min;
-      std::vector<unsigned int> next_indices_max = indices_max;
+      Index5 next_indices_min = indices_min;
+      Index5 next_indices_max = indices_max;
       timestep_to_year_season(timestep, biol_dim[3], next_indices_min[0], next_indices_min[2]);
       next_indices_max[0] = next_indices_min[0];
       next_indices_max[2] = next_indices_min[2];
       // Check for NA in spwn in next time step - if any value of spwn across indices range is NA - stop
-      std::vector<unsigned int> qindices_min = next_indices_min;
-      qindices_min.insert(qindices_min.begin(), 1);
-      std::vector<unsigned int> qindices_max = next_indices_max;
-      qindices_max.insert(qindices_max.begin(), 1);
+      Index6 qindices_min = add_quant(1, next_indices_min);
+      Index6 qindices_max = add_quant(1, next_indices_max);
       FLQuant spwn = biols(biol_no).spwn(qindices_min, qindices_max);
       for (const auto& it : spwn){
         if (Rcpp::NumericVector::is_na(it)){
@@ -2510,5 +2441,7 @@ Rcpp::List operatingModelRun(FLFisheriesAD flfs, fwdBiolsAD biols, const fwdCont
   //std::chrono::duration<double, std::milli> run_time = tendrun - tstartrun;
   //Rprintf("OM run_time: %f \n", run_time.count());
 	return Rcpp::List::create(Rcpp::Named("om", om),
-    Rcpp::Named("solver_codes",solver_codes));
+    Rcpp::Named("solver_codes",solver_codes),
+    Rcpp::Named("srr_lookup_error", om.srr_lookup_errors()),
+    Rcpp::Named("arena", om.get_arena_counters()));
 }
@@ -0,0 +1,264 @@
+/*
+ * Copyright 2014 FLR Team. Distributed under the GPL 2 or later
+ * Maintainer: Finlay Scott, JRC
+ */
+
+#include "../inst/include/srr_atomic.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/*-------------------------------------------------*/
+// Helpers for the sparsity patterns
+
+namespace {
+
+// Jacobian sparsity for bool patterns (vector<bool> and vectorBool), stored row by row with q columns
+// Recruitment i depends on SRP i and on the parameters of SRP i
+template <class Pattern>
+void sparse_jac_bool(const size_t q, const size_t nvalues, const size_t nparams, const Pattern& r, Pattern& s){
+    for (size_t value_count = 0; value_count < nvalues; ++value_count){
+        for (size_t col = 0; col < q; ++col){
+            bool depends = r[value_count * q + col];
+            for (size_t param_count = 0; param_count < nparams; ++param_count){
+                depends = depends || r[(nvalues + value_count * nparams + param_count) * q + col];
+            }
+            s[value_count * q + col] = depends;
+        }
+    }
+}
+
+// Transposed Jacobian sparsity for bool patterns
+template <class Pattern>
+void rev_sparse_jac_bool(const size_t q, const size_t nvalues, const size_t nparams, const Pattern& rt, Pattern& st){
+    for (size_t value_count = 0; value_count < nvalues; ++value_count){
+        for (size_t col = 0; col < q; ++col){
+            st[value_count * q + col] = rt[value_count * q + col];
+            for (size_t param_count = 0; param_count < nparams; ++param_count){
+                st[(nvalues + value_count * nparams + param_count) * q + col] = rt[value_count * q + col];
+            }
+        }
+    }
+}
+
+// The number of parameters for each SRP value from the number of inputs and outputs
+size_t nparams_per_value(const size_t nx, const size_t ny){
+    return (ny == 0) ? 0 : (nx - ny) / ny;
+}
+
+} // anonymous namespace
+
+/*-------------------------------------------------*/
+
+/*! \brief Main constructor
+ *
+ * \param name The name of the atomic operation, used by CppAD when reporting errors.
+ * \param rec_function_ip Evaluates recruitment for a batch of SRP values.
+ * \param gradient_function_ip Evaluates the derivative of recruitment with respect to the SRP for a batch of SRP values. If empty, central differences of rec_function_ip are used.
+ */
+srrAtomic::srrAtomic(const std::string& name, const batch_function_type rec_function_ip, const batch_function_type gradient_function_ip) :
+    CppAD::atomic_base<double>(name, CppAD::atomic_base<double>::bool_sparsity_enum),
+    rec_function(rec_function_ip), gradient_function(gradient_function_ip), rec_cached(false), gradient_cached(false){
+}
+
+bool srrAtomic::has_gradient_function() const{
+    return static_cast<bool>(gradient_function);
+}
+
+/*! \brief Evaluate recruitment for a batch of SRP values
+ *
+ * With doubles the recruitment function is called directly.
+ * With adoubles the SRP values and parameters are the inputs of one atomic operation so that the derivatives are kept on the tape.
+ * \param srp The SRP values.
+ * \param params The SR parameters for each SRP value, with the parameters varying fastest (length nparams * number of SRP values).
+ */
+template <>
+std::vector<double> srrAtomic::eval(const std::vector<double>& srp, const std::vector<double>& params){
+    return rec_function(srp, params);
+}
+
+template <>
+std::vector<adouble> srrAtomic::eval(const std::vector<adouble>& srp, const std::vector<double>& params){
+    std::vector<adouble> ax(srp.begin(), srp.end());
+    ax.insert(ax.end(), params.begin(), params.end());
+    std::vector<adouble> ay(srp.size());
+    (*this)(ax, ay);
+    return ay;
+}
+
+// Pull the SRP values and parameters out of the order 0 Taylor coefficients
+void srrAtomic::split_inputs(const size_t nvalues, const size_t order, const CppAD::vector<double>& tx, std::vector<double>& srp, std::vector<double>& params) const{
+    const size_t nx = tx.size() / (order + 1);
+    srp.resize(nvalues);
+    params.resize(nx - nvalues);
+    for (size_t x_count = 0; x_count < nvalues; ++x_count){
+        srp[x_count] = tx[x_count * (order + 1)];
+    }
+    for (size_t x_count = nvalues; x_count < nx; ++x_count){
+        params[x_count - nvalues] = tx[x_count * (order + 1)];
+    }
+}
+
+void srrAtomic::update_values(const std::vector<double>& srp, const std::vector<double>& params){
+    if (rec_cached && (srp == cached_srp) && (params == cached_params)){
+        return;
+    }
+    cached_rec = rec_function(srp, params);
+    if (cached_rec.size() != srp.size()){
+        Rcpp::stop("In srrAtomic. The SRR must return one value for each SRP value.\n");
+    }
+    cached_srp = srp;
+    cached_params = params;
+    rec_cached = true;
+    gradient_cached = false;
+}
+
+/*! \brief Update the cached derivatives of recruitment with respect to the SRP
+ *
+ * Uses the gradient function if there is one.
+ * Else central differences are evaluated with a single call to the recruitment function (all the SRP + h values followed by all the SRP - h values).
+ * The step is not allowed to make a non-negative SRP negative.
+ */
+void srrAtomic::update_gradient(const std::vector<double>& srp, const std::vector<double>& params){
+    update_values(srp, params);
+    if (gradient_cached){
+        return;
+    }
+    const size_t nvalues = srp.size();
+    if (has_gradient_function()){
+        cached_gradient = gradient_function(srp, params);
+        if (cached_gradient.size() != nvalues){
+            Rcpp::stop("In srrAtomic. The SRR gradient must return one value for each SRP value.\n");
+        }
+    }
+    else {
+        const double rel_step = std::cbrt(std::numeric_limits<double>::epsilon());
+        std::vector<double> srp_step(2 * nvalues);
+        std::vector<double> params_step(params);
+        params_step.insert(params_step.end(), params.begin(), params.end());
+        for (size_t value_count = 0; value_count < nvalues; ++value_count){
+            double step = rel_step * std::max(std::abs(srp[value_count]), 1.0);
+            srp_step[value_count] = srp[value_count] + step;
+            srp_step[nvalues + value_count] = srp[value_count] - step;
+            if ((srp[value_count] >= 0.0) && (srp_step[nvalues + value_count] < 0.0)){
+                srp_step[nvalues + value_count] = srp[value_count];
+            }
+        }
+        std::vector<double> rec_step = rec_function(srp_step, params_step);
+        if (rec_step.size() != 2 * nvalues){
+            Rcpp::stop("In srrAtomic. The SRR must return one value for each SRP value.\n");
+        }
+        cached_gradient.resize(nvalues);
+        for (size_t value_count = 0; value_count < nvalues; ++value_count){
+            cached_gradient[value_count] = (rec_step[value_count] - rec_step[nvalues + value_count]) /
+                (srp_step[value_count] - srp_step[nvalues + value_count]);
+        }
+    }
+    gradient_cached = true;
+}
+
+/*! \brief Forward mode, orders 0 and 1
+ *
+ * Recruitment i is a variable if SRP i or any of its parameters are variables.
+ */
+bool srrAtomic::forward(size_t p, size_t q, const CppAD::vector<bool>& vx, CppAD::vector<bool>& vy, const CppAD::vector<double>& tx, CppAD::vector<double>& ty){
+    if (q > 1){
+        return false;
+    }
+    const size_t nvalues = ty.size() / (q + 1);
+    const size_t nparams = nparams_per_value(tx.size() / (q + 1), nvalues);
+    if (vx.size() > 0){
+        for (size_t value_count = 0; value_count < nvalues; ++value_count){
+            vy[value_count] = vx[value_count];
+            for (size_t param_count = 0; param_count < nparams; ++param_count){
+                vy[value_count] = vy[value_count] || vx[nvalues + value_count * nparams + param_count];
+            }
+        }
+    }
+    std::vector<double> srp;
+    std::vector<double> params;
+    split_inputs(nvalues, q, tx, srp, params);
+    if (p == 0){
+        update_values(srp, params);
+        for (size_t value_count = 0; value_count < nvalues; ++value_count){
+            ty[value_count * (q + 1)] = cached_rec[value_count];
+        }
+    }
+    if (q == 1){
+        update_gradient(srp, params);
+        for (size_t value_count = 0; value_count < nvalues; ++value_count){
+            ty[value_count * 2 + 1] = cached_gradient[value_count] * tx[value_count * 2 + 1];
+        }
+    }
+    return true;
+}
+
+/*! \brief Reverse mode, first order
+ */
+bool srrAtomic::reverse(size_t q, const CppAD::vector<double>& tx, const CppAD::vector<double>& ty, CppAD::vector<double>& px, const CppAD::vector<double>& py){
+    if (q > 0){
+        return false;
+    }
+    const size_t nvalues = ty.size();
+    std::vector<double> srp;
+    std::vector<double> params;
+    split_inputs(nvalues, q, tx, srp, params);
+    update_gradient(srp, params);
+    for (size_t x_count = 0; x_count < px.size(); ++x_count){
+        px[x_count] = 0.0;
+    }
+    for (size_t value_count = 0; value_count < nvalues; ++value_count){
+        px[value_count] = cached_gradient[value_count] * py[value_count];
+    }
+    return true;
+}
+
+bool srrAtomic::for_sparse_jac(size_t q, const CppAD::vector<bool>& r, CppAD::vector<bool>& s, const CppAD::vector<double>& x){
+    const size_t nvalues = s.size() / q;
+    sparse_jac_bool(q, nvalues, nparams_per_value(x.size(), nvalues), r, s);
+    return true;
+}
+
+bool srrAtomic::for_sparse_jac(size_t q, const CppAD::vectorBool& r, CppAD::vectorBool& s, const CppAD::vector<double>& x){
+    const size_t nvalues = s.size() / q;
+    sparse_jac_bool(q, nvalues, nparams_per_value(x.size(), nvalues), r, s);
+    return true;
+}
+
+bool srrAtomic::for_sparse_jac(size_t, const CppAD::vector<std::set<size_t> >& r, CppAD::vector<std::set<size_t> >& s, const CppAD::vector<double>& x){
+    const size_t nvalues = s.size();
+    const size_t nparams = nparams_per_value(x.size(), nvalues);
+    for (size_t value_count = 0; value_count < nvalues; ++value_count){
+        s[value_count] = r[value_count];
+        for (size_t param_count = 0; param_count < nparams; ++param_count){
+            const std::set<size_t>& param_r = r[nvalues + value_count * nparams + param_count];
+            s[value_count].insert(param_r.begin(), param_r.end());
+        }
+    }
+    return true;
+}
+
+bool srrAtomic::rev_sparse_jac(size_t q, const CppAD::vector<bool>& rt, CppAD::vector<bool>& st, const CppAD::vector<double>& x){
+    const size_t nvalues = rt.size() / q;
+    rev_sparse_jac_bool(q, nvalues, nparams_per_value(x.size(), nvalues), rt, st);
+    return true;
+}
+
+bool srrAtomic::rev_sparse_jac(size_t q, const CppAD::vectorBool& rt, CppAD::vectorBool& st, const CppAD::vector<double>& x){
+    const size_t nvalues = rt.size() / q;
+    rev_sparse_jac_bool(q, nvalues, nparams_per_value(x.size(), nvalues), rt, st);
+    return true;
+}
+
+bool srrAtomic::rev_sparse_jac(size_t, const CppAD::vector<std::set<size_t> >& rt, CppAD::vector<std::set<size_t> >& st, const CppAD::vector<double>& x){
+    const size_t nvalues = rt.size();
+    const size_t nparams = nparams_per_value(x.size(), nvalues);
+    for (size_t value_count = 0; value_count < nvalues; ++value_count){
+        st[value_count] = rt[value_count];
+        for (size_t param_count = 0; param_count < nparams; ++param_count){
+            st[nvalues + value_count * nparams + param_count] = rt[value_count];
+        }
+    }
+    return true;
+}
+
@@ -0,0 +1,123 @@
+/*
+ * Copyright 2014 FLR Team. Distributed under the GPL 2 or later
+ * Maintainer: Finlay Scott, JRC
+ */
+
+#include "../inst/include/srr_deviances.h"
+#include <cmath>
+
+/*-------------------------------------------------*/
+// Counter-based random numbers
+
+namespace {
+
+// The splitmix64 finaliser - a bijective hash with good avalanche properties
+std::uint64_t mix(std::uint64_t z){
+    z += 0x9e3779b97f4a7c15ULL;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Uniform on (0, 1) from the top 53 bits
+double to_uniform(const std::uint64_t z){
+    return (static_cast<double>(z >> 11) + 0.5) / 9007199254740992.0;
+}
+
+} // anonymous namespace
+
+/*-------------------------------------------------*/
+
+/*! \brief Empty constructor
+ *
+ * The generator is not active.
+ */
+srrDevianceGenerator::srrDevianceGenerator(){
+    active = false;
+    sd = 0.0;
+    rho = 0.0;
+    seed = 0;
+    bias_correct = false;
+}
+
+/*! \brief Main constructor
+ *
+ * \param sd_ip The standard deviation of the log deviances (the marginal standard deviation if autocorrelated).
+ * \param rho_ip The AR(1) autocorrelation of the log deviances between years, between -1 and 1.
+ * \param seed_ip The seed.
+ * \param bias_correct_ip Should the log deviances have a mean of -sd^2/2 so that the mean deviance is 1.
+ * \param iters_ip The original iteration numbers of the iterations (starting at 1). If empty the iterations are 1 to n.
+ */
+srrDevianceGenerator::srrDevianceGenerator(const double sd_ip, const double rho_ip, const double seed_ip, const bool bias_correct_ip, const std::vector<unsigned int>& iters_ip){
+    if (sd_ip < 0.0){
+        Rcpp::stop("In srrDevianceGenerator constructor. sd must not be negative.\n");
+    }
+    if ((rho_ip <= -1.0) || (rho_ip >= 1.0)){
+        Rcpp::stop("In srrDevianceGenerator constructor. rho must be between -1 and 1.\n");
+    }
+    active = true;
+    sd = sd_ip;
+    rho = rho_ip;
+    seed = mix(static_cast<std::uint64_t>(static_cast<std::int64_t>(seed_ip)));
+    bias_correct = bias_correct_ip;
+    iters = iters_ip;
+}
+
+srrDevianceGenerator::srrDevianceGenerator(const SEXP generator_sexp){
+    Rcpp::List generator_list = Rcpp::as<Rcpp::List>(generator_sexp);
+    std::vector<unsigned int> iters_ip;
+    if (generator_list.containsElementNamed("iters")){
+        iters_ip = Rcpp::as<std::vector<unsigned int> >(generator_list["iters"]);
+    }
+    *this = srrDevianceGenerator(Rcpp::as<double>(generator_list["sd"]), Rcpp::as<double>(generator_list["rho"]),
+        Rcpp::as<double>(generator_list["seed"]), Rcpp::as<bool>(generator_list["bias_correct"]), iters_ip);
+}
+
+bool srrDevianceGenerator::is_active() const{
+    return active;
+}
+
+// Standard normal deviate by Box-Muller from the hash of the seed and the indices
+double srrDevianceGenerator::normal(const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const std::uint64_t iter) const{
+    std::uint64_t z = mix(seed ^ iter);
+    z = mix(z ^ area);
+    z = mix(z ^ season);
+    z = mix(z ^ unit);
+    z = mix(z ^ year);
+    const double u1 = to_uniform(z);
+    const double u2 = to_uniform(mix(z));
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * 4.0 * std::atan(1.0) * u2);
+}
+
+/*! \brief Generate a deviance
+ *
+ * The log deviance in the first year is normal with standard deviation sd.
+ * In later years it is rho * (log deviance in the previous year) + sqrt(1 - rho^2) * sd * (normal deviate), so that the process is stationary.
+ * With autocorrelation the years before are generated again, so the cost is proportional to the year.
+ * \param year The year (starting at 1 for the first year of the biol).
+ * \param unit The unit.
+ * \param season The season.
+ * \param area The area.
+ * \param iter The iteration.
+ */
+double srrDevianceGenerator::deviance(const unsigned int year, const unsigned int unit, const unsigned int season, const unsigned int area, const unsigned int iter) const{
+    if (!active){
+        return 1.0;
+    }
+    const std::uint64_t iter_id = iters.empty() ? iter : iters[(iter - 1) % iters.size()];
+    double log_deviance = sd * normal(1, unit, season, area, iter_id);
+    if (rho == 0.0){
+        log_deviance = sd * normal(year, unit, season, area, iter_id);
+    }
+    else {
+        const double innovation_sd = std::sqrt(1.0 - rho * rho) * sd;
+        for (unsigned int year_count = 2; year_count <= year; ++year_count){
+            log_deviance = rho * log_deviance + innovation_sd * normal(year_count, unit, season, area, iter_id);
+        }
+    }
+    if (bias_correct){
+        log_deviance -= sd * sd / 2.0;
+    }
+    return std::exp(log_deviance);
+}
+
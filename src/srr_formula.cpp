@@ -0,0 +1,617 @@
+/*
+ * Copyright 2014 FLR Team. Distributed under the GPL 2 or later
+ * Maintainer: Finlay Scott, JRC
+ */
+
+#include "../inst/include/srr_formula.h"
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+
+/*-------------------------------------------------*/
+// Helper functions for the parser
+
+namespace {
+
+void skip_space(const std::string& text, unsigned int& pos){
+    while ((pos < text.size()) && std::isspace(static_cast<unsigned char>(text[pos]))){
+        ++pos;
+    }
+}
+
+// If the text at pos (after any whitespace) starts with the token, move past it and return true
+bool accept(const std::string& text, unsigned int& pos, const std::string& token){
+    skip_space(text, pos);
+    if (text.compare(pos, token.size(), token) == 0){
+        pos += token.size();
+        return true;
+    }
+    return false;
+}
+
+// As accept() but only if the token is not followed by any of the characters in not_followed_by (e.g. '<' but not '<=')
+bool accept_only(const std::string& text, unsigned int& pos, const std::string& token, const std::string& not_followed_by){
+    skip_space(text, pos);
+    unsigned int end = pos + token.size();
+    if ((text.compare(pos, token.size(), token) == 0) && ((end >= text.size()) || (not_followed_by.find(text[end]) == std::string::npos))){
+        pos = end;
+        return true;
+    }
+    return false;
+}
+
+bool is_name_start(const char c){
+    return std::isalpha(static_cast<unsigned char>(c)) || (c == '.');
+}
+
+bool is_name_char(const char c){
+    return std::isalnum(static_cast<unsigned char>(c)) || (c == '.') || (c == '_');
+}
+
+std::string read_name(const std::string& text, unsigned int& pos){
+    unsigned int start = pos;
+    while ((pos < text.size()) && is_name_char(text[pos])){
+        ++pos;
+    }
+    return text.substr(start, pos - start);
+}
+
+} // anonymous namespace
+
+/*-------------------------------------------------*/
+
+/*! \brief Empty constructor
+ *
+ * Creates a formula that is not native.
+ */
+srrFormula::srrFormula(){
+    root = -1;
+    native = false;
+}
+
+/*! \brief Main constructor - parses and compiles the formula
+ *
+ * The formula is the right hand side of the R formula (e.g. "a * ssb / (b + ssb)"). If the left hand side is included ("rec ~ ...") it is dropped.
+ * The SRP is called 'ssb'. The parameters can be referred to by name or by position (params[1], params[[2]] etc.).
+ * The arithmetic operators, exp(), log(), log10(), sqrt(), abs(), pmin(), pmax(), ifelse() and the comparison and logical operators are supported.
+ * c() and FLQuant() wrappers around the expression are ignored.
+ * If the formula contains anything else, it is not compiled and is_native() returns false so that the caller can fall back to R.
+ * \param formula_ip The SRR formula.
+ * \param param_names_ip The names of the SR parameters, in the order they are stored in the first dimension of the params FLQuant.
+ */
+srrFormula::srrFormula(const std::string& formula_ip, const std::vector<std::string>& param_names_ip){
+    formula = formula_ip;
+    param_names = param_names_ip;
+    root = -1;
+    native = false;
+    // Drop the left hand side
+    std::string text = formula;
+    std::string::size_type tilde = text.find('~');
+    if (tilde != std::string::npos){
+        text.erase(0, tilde + 1);
+    }
+    unsigned int pos = 0;
+    root = parse_or(text, pos);
+    skip_space(text, pos);
+    // Everything must have been parsed and only things we know about are allowed
+    if ((root >= 0) && (pos == text.size())){
+        native = check_node(root);
+    }
+}
+
+bool srrFormula::is_native() const{
+    return native;
+}
+
+std::string srrFormula::get_formula() const{
+    return formula;
+}
+
+std::vector<std::string> srrFormula::get_param_names() const{
+    return param_names;
+}
+
+/*! \brief Compare two compiled formulas
+ *
+ * The formulas are the same if they have the same operations, constants and parameters in the same order.
+ * No attempt is made to rearrange the expressions, e.g. a * ssb is not the same as ssb * a.
+ * Parameters are compared by position so the formulas should have been compiled with the same parameter names.
+ * \param other The formula to compare with.
+ */
+bool srrFormula::is_same(const srrFormula& other) const{
+    if (!native || !other.native){
+        return false;
+    }
+    return same_node(root, other, other.root);
+}
+
+bool srrFormula::same_node(const int node_no, const srrFormula& other, const int other_node_no) const{
+    if ((node_no < 0) || (other_node_no < 0)){
+        return (node_no < 0) && (other_node_no < 0);
+    }
+    const node& nd = nodes[node_no];
+    const node& other_nd = other.nodes[other_node_no];
+    if ((nd.type != other_nd.type) ||
+        ((nd.type == node_constant) && (nd.value != other_nd.value)) ||
+        ((nd.type == node_param) && (nd.param != other_nd.param))){
+        return false;
+    }
+    for (unsigned int child_count = 0; child_count < 3; ++child_count){
+        if (!same_node(nd.child[child_count], other, other_nd.child[child_count])){
+            return false;
+        }
+    }
+    return true;
+}
+
+/*! \brief Evaluate the compiled formula
+ *
+ * If T is adouble the operations are recorded on the tape so that the derivative of recruitment with respect to the SRP is kept.
+ * \param srp The spawning reproductive potential.
+ * \param params The SR parameters, in the same order as the parameter names used to compile the formula.
+ */
+template <typename T>
+T srrFormula::eval(const T srp, const double* params) const{
+    if (!native){
+        Rcpp::stop("In srrFormula::eval. Formula has not been compiled.\n");
+    }
+    return eval_node(root, srp, params);
+}
+
+template <typename T>
+T srrFormula::eval_node(const int node_no, const T& srp, const double* params) const{
+    using std::exp; using std::log; using std::log10; using std::sqrt; using std::abs; using std::pow;
+    const node& nd = nodes[node_no];
+    const T zero = 0.0;
+    const T one = 1.0;
+    // Conditional operators are always evaluated with CondExp so that the tape does not depend on the branch taken
+    switch (nd.type){
+        case node_constant:
+            return T(nd.value);
+        case node_srp:
+            return srp;
+        case node_param:
+            return T(params[nd.param]);
+        case node_add:
+            return eval_node(nd.child[0], srp, params) + eval_node(nd.child[1], srp, params);
+        case node_sub:
+            return eval_node(nd.child[0], srp, params) - eval_node(nd.child[1], srp, params);
+        case node_mult:
+            return eval_node(nd.child[0], srp, params) * eval_node(nd.child[1], srp, params);
+        case node_div:
+            return eval_node(nd.child[0], srp, params) / eval_node(nd.child[1], srp, params);
+        case node_pow:
+            return pow(eval_node(nd.child[0], srp, params), eval_node(nd.child[1], srp, params));
+        case node_neg:
+            return -eval_node(nd.child[0], srp, params);
+        case node_exp:
+            return exp(eval_node(nd.child[0], srp, params));
+        case node_log:
+            return log(eval_node(nd.child[0], srp, params));
+        case node_log10:
+            return log10(eval_node(nd.child[0], srp, params));
+        case node_sqrt:
+            return sqrt(eval_node(nd.child[0], srp, params));
+        case node_abs:
+            return abs(eval_node(nd.child[0], srp, params));
+        case node_min: {
+            T lhs = eval_node(nd.child[0], srp, params);
+            T rhs = eval_node(nd.child[1], srp, params);
+            return CppAD::CondExpLt(lhs, rhs, lhs, rhs);
+        }
+        case node_max: {
+            T lhs = eval_node(nd.child[0], srp, params);
+            T rhs = eval_node(nd.child[1], srp, params);
+            return CppAD::CondExpGt(lhs, rhs, lhs, rhs);
+        }
+        case node_lt:
+            return CppAD::CondExpLt(eval_node(nd.child[0], srp, params), eval_node(nd.child[1], srp, params), one, zero);
+        case node_le:
+            return CppAD::CondExpLe(eval_node(nd.child[0], srp, params), eval_node(nd.child[1], srp, params), one, zero);
+        case node_gt:
+            return CppAD::CondExpGt(eval_node(nd.child[0], srp, params), eval_node(nd.child[1], srp, params), one, zero);
+        case node_ge:
+            return CppAD::CondExpGe(eval_node(nd.child[0], srp, params), eval_node(nd.child[1], srp, params), one, zero);
+        case node_eq:
+            return CppAD::CondExpEq(eval_node(nd.child[0], srp, params), eval_node(nd.child[1], srp, params), one, zero);
+        case node_ne:
+            return CppAD::CondExpEq(eval_node(nd.child[0], srp, params), eval_node(nd.child[1], srp, params), zero, one);
+        case node_and: {
+            T rhs = CppAD::CondExpEq(eval_node(nd.child[1], srp, params), zero, zero, one);
+            return CppAD::CondExpEq(eval_node(nd.child[0], srp, params), zero, zero, rhs);
+        }
+        case node_or: {
+            T rhs = CppAD::CondExpEq(eval_node(nd.child[1], srp, params), zero, zero, one);
+            return CppAD::CondExpEq(eval_node(nd.child[0], srp, params), zero, rhs, one);
+        }
+        case node_not:
+            return CppAD::CondExpEq(eval_node(nd.child[0], srp, params), zero, one, zero);
+        case node_ifelse: {
+            T yes = eval_node(nd.child[1], srp, params);
+            T no = eval_node(nd.child[2], srp, params);
+            // If the test is a comparison, use it directly rather than going through a 0 / 1 value
+            const node& test = nodes[nd.child[0]];
+            if ((test.type >= node_lt) && (test.type <= node_ne)){
+                T lhs = eval_node(test.child[0], srp, params);
+                T rhs = eval_node(test.child[1], srp, params);
+                switch (test.type){
+                    case node_lt: return CppAD::CondExpLt(lhs, rhs, yes, no);
+                    case node_le: return CppAD::CondExpLe(lhs, rhs, yes, no);
+                    case node_gt: return CppAD::CondExpGt(lhs, rhs, yes, no);
+                    case node_ge: return CppAD::CondExpGe(lhs, rhs, yes, no);
+                    case node_eq: return CppAD::CondExpEq(lhs, rhs, yes, no);
+                    default: return CppAD::CondExpEq(lhs, rhs, no, yes);
+                }
+            }
+            return CppAD::CondExpEq(eval_node(nd.child[0], srp, params), zero, no, yes);
+        }
+        default:
+            Rcpp::stop("In srrFormula::eval_node. Unknown operation in formula.\n");
+    }
+}
+
+/*-------------------------------------------------*/
+// Parser
+// Each parse method returns the position of the new node in nodes, or -1 if the text could not be parsed.
+
+int srrFormula::add_node(const node_type type, const int child1, const int child2, const int child3, const double value, const unsigned int param){
+    node nd;
+    nd.type = type;
+    nd.value = value;
+    nd.param = param;
+    nd.child[0] = child1;
+    nd.child[1] = child2;
+    nd.child[2] = child3;
+    nodes.push_back(nd);
+    return nodes.size() - 1;
+}
+
+// Are all the nodes reachable from node_no something we can evaluate
+bool srrFormula::check_node(const int node_no) const{
+    if (node_no < 0){
+        return false;
+    }
+    const node& nd = nodes[node_no];
+    if (nd.type == node_unknown){
+        return false;
+    }
+    if ((nd.type == node_param) && (nd.param >= param_names.size())){
+        return false;
+    }
+    for (unsigned int child_count = 0; child_count < 3; ++child_count){
+        if ((nd.child[child_count] >= 0) && !check_node(nd.child[child_count])){
+            return false;
+        }
+    }
+    return true;
+}
+
+int srrFormula::parse_or(const std::string& text, unsigned int& pos){
+    int lhs = parse_and(text, pos);
+    while (lhs >= 0){
+        if (!(accept(text, pos, "||") || accept(text, pos, "|"))){
+            break;
+        }
+        int rhs = parse_and(text, pos);
+        lhs = (rhs < 0) ? -1 : add_node(node_or, lhs, rhs);
+    }
+    return lhs;
+}
+
+int srrFormula::parse_and(const std::string& text, unsigned int& pos){
+    int lhs = parse_not(text, pos);
+    while (lhs >= 0){
+        if (!(accept(text, pos, "&&") || accept(text, pos, "&"))){
+            break;
+        }
+        int rhs = parse_not(text, pos);
+        lhs = (rhs < 0) ? -1 : add_node(node_and, lhs, rhs);
+    }
+    return lhs;
+}
+
+int srrFormula::parse_not(const std::string& text, unsigned int& pos){
+    if (accept_only(text, pos, "!", "=")){
+        int operand = parse_not(text, pos);
+        return (operand < 0) ? -1 : add_node(node_not, operand);
+    }
+    return parse_comparison(text, pos);
+}
+
+int srrFormula::parse_comparison(const std::string& text, unsigned int& pos){
+    int lhs = parse_additive(text, pos);
+    if (lhs < 0){
+        return -1;
+    }
+    node_type type;
+    if (accept(text, pos, "<=")){
+        type = node_le;
+    }
+    else if (accept(text, pos, ">=")){
+        type = node_ge;
+    }
+    else if (accept(text, pos, "==")){
+        type = node_eq;
+    }
+    else if (accept(text, pos, "!=")){
+        type = node_ne;
+    }
+    else if (accept_only(text, pos, "<", "-")){ // Not assignment
+        type = node_lt;
+    }
+    else if (accept(text, pos, ">")){
+        type = node_gt;
+    }
+    else {
+        return lhs;
+    }
+    int rhs = parse_additive(text, pos);
+    return (rhs < 0) ? -1 : add_node(type, lhs, rhs);
+}
+
+int srrFormula::parse_additive(const std::string& text, unsigned int& pos){
+    int lhs = parse_multiplicative(text, pos);
+    while (lhs >= 0){
+        node_type type;
+        if (accept(text, pos, "+")){
+            type = node_add;
+        }
+        else if (accept(text, pos, "-")){
+            type = node_sub;
+        }
+        else {
+            break;
+        }
+        int rhs = parse_multiplicative(text, pos);
+        lhs = (rhs < 0) ? -1 : add_node(type, lhs, rhs);
+    }
+    return lhs;
+}
+
+int srrFormula::parse_multiplicative(const std::string& text, unsigned int& pos){
+    int lhs = parse_unary(text, pos);
+    while (lhs >= 0){
+        node_type type;
+        if (accept_only(text, pos, "*", "*")){ // ** is power in R
+            type = node_mult;
+        }
+        else if (accept(text, pos, "/")){
+            type = node_div;
+        }
+        else {
+            break;
+        }
+        int rhs = parse_unary(text, pos);
+        lhs = (rhs < 0) ? -1 : add_node(type, lhs, rhs);
+    }
+    return lhs;
+}
+
+// In R unary minus binds less tightly than ^, i.e. -a^2 is -(a^2)
+int srrFormula::parse_unary(const std::string& text, unsigned int& pos){
+    if (accept(text, pos, "-")){
+        int operand = parse_unary(text, pos);
+        return (operand < 0) ? -1 : add_node(node_neg, operand);
+    }
+    if (accept(text, pos, "+")){
+        return parse_unary(text, pos);
+    }
+    return parse_power(text, pos);
+}
+
+// ^ is right associative and the exponent can have a unary minus, e.g. a^-b^2 is a^(-(b^2))
+int srrFormula::parse_power(const std::string& text, unsigned int& pos){
+    int base = parse_primary(text, pos);
+    if (base < 0){
+        return -1;
+    }
+    if (accept(text, pos, "^") || accept(text, pos, "**")){
+        int exponent = parse_unary(text, pos);
+        return (exponent < 0) ? -1 : add_node(node_pow, base, exponent);
+    }
+    return base;
+}
+
+int srrFormula::parse_primary(const std::string& text, unsigned int& pos){
+    skip_space(text, pos);
+    if (pos >= text.size()){
+        return -1;
+    }
+    const char c = text[pos];
+    // Bracketed expression
+    if (c == '('){
+        ++pos;
+        int expr = parse_or(text, pos);
+        if ((expr < 0) || !accept(text, pos, ")")){
+            return -1;
+        }
+        return expr;
+    }
+    // Number
+    if (std::isdigit(static_cast<unsigned char>(c)) || ((c == '.') && (pos + 1 < text.size()) && std::isdigit(static_cast<unsigned char>(text[pos+1])))){
+        const char* start = text.c_str() + pos;
+        char* end;
+        double value = std::strtod(start, &end);
+        pos += end - start;
+        if ((pos < text.size()) && (text[pos] == 'L')){ // Integer literal
+            ++pos;
+        }
+        return add_node(node_constant, -1, -1, -1, value);
+    }
+    // Strings are only allowed as arguments we ignore (e.g. units in FLQuant())
+    if ((c == '"') || (c == '\'')){
+        std::string::size_type close = text.find(c, pos + 1);
+        if (close == std::string::npos){
+            return -1;
+        }
+        pos = close + 1;
+        return add_node(node_unknown);
+    }
+    if (!is_name_start(c)){
+        return -1;
+    }
+    std::string name = read_name(text, pos);
+    skip_space(text, pos);
+    // Function call
+    if ((pos < text.size()) && (text[pos] == '(')){
+        ++pos;
+        return parse_call(name, text, pos);
+    }
+    // Parameters by name - check these first in case a parameter has the same name as something else
+    std::vector<std::string>::const_iterator param_found = std::find(param_names.begin(), param_names.end(), name);
+    if (param_found != param_names.end()){
+        return add_node(node_param, -1, -1, -1, 0.0, param_found - param_names.begin());
+    }
+    // Parameters by position: params[i] or params[[i]]
+    if ((name == "params") && (pos < text.size()) && (text[pos] == '[')){
+        bool double_bracket = accept(text, pos, "[[");
+        if (!double_bracket){
+            accept(text, pos, "[");
+        }
+        int index = parse_or(text, pos);
+        if ((index < 0) || !accept(text, pos, double_bracket ? "]]" : "]")){
+            return -1;
+        }
+        const node index_node = nodes[index];
+        nodes.pop_back();
+        if ((index_node.type != node_constant) || (index_node.value < 1.0) || (index_node.value != std::floor(index_node.value))){
+            return add_node(node_unknown);
+        }
+        return add_node(node_param, -1, -1, -1, 0.0, static_cast<unsigned int>(index_node.value) - 1);
+    }
+    if ((name == "ssb") || (name == "srp")){
+        return add_node(node_srp);
+    }
+    if (name == "pi"){
+        return add_node(node_constant, -1, -1, -1, 4.0 * std::atan(1.0));
+    }
+    if ((name == "TRUE") || (name == "T")){
+        return add_node(node_constant, -1, -1, -1, 1.0);
+    }
+    if ((name == "FALSE") || (name == "F")){
+        return add_node(node_constant, -1, -1, -1, 0.0);
+    }
+    return add_node(node_unknown);
+}
+
+// The opening bracket has already been read
+int srrFormula::parse_call(const std::string& name, const std::string& text, unsigned int& pos){
+    std::vector<int> args;
+    std::vector<std::string> arg_names;
+    if (!accept(text, pos, ")")){
+        do {
+            // Named argument?
+            std::string arg_name;
+            unsigned int name_pos = pos;
+            skip_space(text, name_pos);
+            if ((name_pos < text.size()) && is_name_start(text[name_pos])){
+                arg_name = read_name(text, name_pos);
+                if (accept_only(text, name_pos, "=", "=")){
+                    pos = name_pos;
+                }
+                else {
+                    arg_name = std::string();
+                }
+            }
+            int arg = parse_or(text, pos);
+            if (arg < 0){
+                return -1;
+            }
+            args.push_back(arg);
+            arg_names.push_back(arg_name);
+        } while (accept(text, pos, ","));
+        if (!accept(text, pos, ")")){
+            return -1;
+        }
+    }
+    // Pull out the positional arguments (and the named ones we know about)
+    std::vector<int> positional;
+    for (unsigned int arg_count = 0; arg_count < args.size(); ++arg_count){
+        if (arg_names[arg_count].empty()){
+            positional.push_back(args[arg_count]);
+        }
+    }
+    // Wrappers that do not change the value - extra named arguments (e.g. dimnames in FLQuant()) are ignored
+    if ((name == "c") || (name == "FLQuant") || (name == "as.numeric") || (name == "as.vector") || (name == "drop")){
+        return (positional.size() == 1) ? positional[0] : add_node(node_unknown);
+    }
+    // Everything else only has positional arguments, apart from ifelse()
+    if (name == "ifelse"){
+        int test = -1, yes = -1, no = -1;
+        unsigned int next_positional = 0;
+        for (unsigned int arg_count = 0; arg_count < args.size(); ++arg_count){
+            const std::string& arg_name = arg_names[arg_count];
+            if (arg_name == "test"){
+                test = args[arg_count];
+            }
+            else if (arg_name == "yes"){
+                yes = args[arg_count];
+            }
+            else if (arg_name == "no"){
+                no = args[arg_count];
+            }
+            else if (arg_name.empty()){
+                // Fill the first empty slot
+                int* slots[3] = {&test, &yes, &no};
+                while ((next_positional < 3) && (*slots[next_positional] >= 0)){
+                    ++next_positional;
+                }
+                if (next_positional >= 3){
+                    return add_node(node_unknown);
+                }
+                *slots[next_positional] = args[arg_count];
+            }
+            else {
+                return add_node(node_unknown);
+            }
+        }
+        if ((test < 0) || (yes < 0) || (no < 0)){
+            return add_node(node_unknown);
+        }
+        return add_node(node_ifelse, test, yes, no);
+    }
+    if (positional.size() != args.size()){
+        return add_node(node_unknown);
+    }
+    if ((name == "pmin") || (name == "pmax") || (name == "min") || (name == "max")){
+        if (positional.empty()){
+            return add_node(node_unknown);
+        }
+        node_type type = ((name == "pmin") || (name == "min")) ? node_min : node_max;
+        int out = positional[0];
+        for (unsigned int arg_count = 1; arg_count < positional.size(); ++arg_count){
+            out = add_node(type, out, positional[arg_count]);
+        }
+        return out;
+    }
+    // log(x, base)
+    if ((name == "log") && (positional.size() == 2)){
+        int numerator = add_node(node_log, positional[0]);
+        int denominator = add_node(node_log, positional[1]);
+        return add_node(node_div, numerator, denominator);
+    }
+    if (positional.size() != 1){
+        return add_node(node_unknown);
+    }
+    if (name == "exp"){
+        return add_node(node_exp, positional[0]);
+    }
+    if (name == "log"){
+        return add_node(node_log, positional[0]);
+    }
+    if (name == "log10"){
+        return add_node(node_log10, positional[0]);
+    }
+    if (name == "sqrt"){
+        return add_node(node_sqrt, positional[0]);
+    }
+    if (name == "abs"){
+        return add_node(node_abs, positional[0]);
+    }
+    return add_node(node_unknown);
+}
+
+// Explicit instantiation
+template double srrFormula::eval(const double srp, const double* params) const;
+template adouble srrFormula::eval(const adouble srp, const double* params) const;
+
@@ -0,0 +1,294 @@
+/*
+ * Copyright 2014 FLR Team. Distributed under the GPL 2 or later
+ * Maintainer: Finlay Scott, JRC
+ */
+
+#include "../inst/include/srr_lookup.h"
+#include <algorithm>
+#include <cmath>
+
+/*-------------------------------------------------*/
+// Monotone cubic Hermite interpolation
+
+namespace {
+
+// Slopes of the Fritsch-Carlson monotone spline through the points
+std::vector<double> pchip_slopes(const std::vector<double>& x, const std::vector<double>& y){
+    const size_t npoints = x.size();
+    std::vector<double> slope(npoints, 0.0);
+    if (npoints < 2){
+        return slope;
+    }
+    std::vector<double> h(npoints - 1);
+    std::vector<double> delta(npoints - 1);
+    for (size_t count = 0; count < (npoints - 1); ++count){
+        h[count] = x[count + 1] - x[count];
+        delta[count] = (y[count + 1] - y[count]) / h[count];
+    }
+    if (npoints == 2){
+        slope[0] = delta[0];
+        slope[1] = delta[0];
+        return slope;
+    }
+    // Interior points - weighted harmonic mean of the secants, 0 at a local extreme
+    for (size_t count = 1; count < (npoints - 1); ++count){
+        if ((delta[count - 1] * delta[count]) > 0.0){
+            const double w1 = 2.0 * h[count] + h[count - 1];
+            const double w2 = h[count] + 2.0 * h[count - 1];
+            slope[count] = (w1 + w2) / (w1 / delta[count - 1] + w2 / delta[count]);
+        }
+    }
+    // End points - three point formula, kept shape preserving
+    auto end_slope = [](const double h0, const double h1, const double delta0, const double delta1){
+        double end = ((2.0 * h0 + h1) * delta0 - h0 * delta1) / (h0 + h1);
+        if ((end * delta0) <= 0.0){
+            end = 0.0;
+        }
+        else if (((delta0 * delta1) <= 0.0) && (std::abs(end) > std::abs(3.0 * delta0))){
+            end = 3.0 * delta0;
+        }
+        return end;
+    };
+    slope[0] = end_slope(h[0], h[1], delta[0], delta[1]);
+    slope[npoints - 1] = end_slope(h[npoints - 2], h[npoints - 3], delta[npoints - 2], delta[npoints - 3]);
+    return slope;
+}
+
+// Value and derivative of the cubic Hermite spline on the interval starting at point i
+void hermite(const std::vector<double>& x, const std::vector<double>& y, const std::vector<double>& slope, const size_t i, const double xval, double& yval, double& dyval){
+    const double h = x[i + 1] - x[i];
+    const double t = (xval - x[i]) / h;
+    const double t2 = t * t;
+    const double t3 = t2 * t;
+    yval = (2.0 * t3 - 3.0 * t2 + 1.0) * y[i] + (t3 - 2.0 * t2 + t) * h * slope[i] +
+        (-2.0 * t3 + 3.0 * t2) * y[i + 1] + (t3 - t2) * h * slope[i + 1];
+    dyval = (6.0 * t2 - 6.0 * t) / h * y[i] + (3.0 * t2 - 4.0 * t + 1.0) * slope[i] +
+        (-6.0 * t2 + 6.0 * t) / h * y[i + 1] + (3.0 * t2 - 2.0 * t) * slope[i + 1];
+}
+
+// Stop if the SRR is not finite at any of the SRP values, e.g. log(ssb) or 1/ssb at 0
+// The spline cannot be fitted through them and the errors are not defined
+void check_finite(const std::vector<double>& srp, const std::vector<double>& rec){
+    for (size_t count = 0; count < rec.size(); ++count){
+        if (!std::isfinite(rec[count])){
+            Rcpp::stop("In srrLookup. The SRR is not finite at SRP = %g. Lookup tables need an SRR that is finite from 0 to the largest SRP.\n", srp[count]);
+        }
+    }
+}
+
+} // anonymous namespace
+
+/*-------------------------------------------------*/
+
+/*! \brief Empty constructor
+ *
+ * Uses a relative tolerance of 1e-6 and up to 1025 points.
+ */
+srrLookup::srrLookup(){
+    tolerance = 1e-6;
+    max_points = 1025;
+    srp_max = 0.0;
+}
+
+/*! \brief Main constructor
+ *
+ * \param tolerance_ip The largest error at the check points, relative to the largest recruitment in the table.
+ * \param max_points_ip The maximum number of points in each table (at least 3).
+ * \param srp_max_ip The initial upper limit of the SRP grid. If 0 it is twice the first SRP value. The limit is extended if needed.
+ */
+srrLookup::srrLookup(const double tolerance_ip, const unsigned int max_points_ip, const double srp_max_ip){
+    if (tolerance_ip <= 0.0){
+        Rcpp::stop("In srrLookup constructor. tolerance must be positive.\n");
+    }
+    if (max_points_ip < 3){
+        Rcpp::stop("In srrLookup constructor. max_points must be at least 3.\n");
+    }
+    if (srp_max_ip < 0.0){
+        Rcpp::stop("In srrLookup constructor. srp_max must not be negative.\n");
+    }
+    tolerance = tolerance_ip;
+    max_points = max_points_ip;
+    srp_max = srp_max_ip;
+}
+
+srrLookup::srrLookup(const SEXP lookup_sexp){
+    Rcpp::List lookup_list = Rcpp::as<Rcpp::List>(lookup_sexp);
+    *this = srrLookup(Rcpp::as<double>(lookup_list["tolerance"]), Rcpp::as<unsigned int>(lookup_list["max_points"]),
+        Rcpp::as<double>(lookup_list["srp_max"]));
+}
+
+void srrLookup::set_rec_function(const batch_function_type rec_function_ip){
+    rec_function = rec_function_ip;
+    tables.clear();
+}
+
+/*! \brief Tabulate the SRR for one parameter set
+ *
+ * Starts with 17 evenly spaced points between 0 and srp_upper.
+ * The SRR must be finite at all of them, including SRP = 0.
+ * Each round evaluates the SRR at the midpoints of all the intervals in a single call and adds the midpoints where the spline error is too big,
+ * the worst first if there is not room for all of them.
+ * \param params The parameter set.
+ * \param srp_upper The upper limit of the grid.
+ */
+srrLookup::table srrLookup::build_table(const std::vector<double>& params, const double srp_upper) const{
+    table lookup_table;
+    const unsigned int initial_points = std::min(max_points, 17u);
+    lookup_table.srp.resize(initial_points);
+    for (unsigned int point_count = 0; point_count < initial_points; ++point_count){
+        lookup_table.srp[point_count] = srp_upper * point_count / (initial_points - 1);
+    }
+    auto batch_params = [&params](const size_t nvalues){
+        std::vector<double> all_params;
+        all_params.reserve(nvalues * params.size());
+        for (size_t value_count = 0; value_count < nvalues; ++value_count){
+            all_params.insert(all_params.end(), params.begin(), params.end());
+        }
+        return all_params;
+    };
+    lookup_table.rec = rec_function(lookup_table.srp, batch_params(initial_points));
+    if (lookup_table.rec.size() != initial_points){
+        Rcpp::stop("In srrLookup. The SRR must return one value for each SRP value.\n");
+    }
+    check_finite(lookup_table.srp, lookup_table.rec);
+    while (true){
+        lookup_table.slope = pchip_slopes(lookup_table.srp, lookup_table.rec);
+        const size_t nintervals = lookup_table.srp.size() - 1;
+        std::vector<double> mid_srp(nintervals);
+        for (size_t interval_count = 0; interval_count < nintervals; ++interval_count){
+            mid_srp[interval_count] = 0.5 * (lookup_table.srp[interval_count] + lookup_table.srp[interval_count + 1]);
+        }
+        const std::vector<double> mid_rec = rec_function(mid_srp, batch_params(nintervals));
+        if (mid_rec.size() != nintervals){
+            Rcpp::stop("In srrLookup. The SRR must return one value for each SRP value.\n");
+        }
+        check_finite(mid_srp, mid_rec);
+        double rec_scale = 0.0;
+        for (const double rec : lookup_table.rec){
+            rec_scale = std::max(rec_scale, std::abs(rec));
+        }
+        if (rec_scale == 0.0){
+            rec_scale = 1.0;
+        }
+        // Relative error at each midpoint
+        std::vector<std::pair<double, size_t> > errors(nintervals);
+        lookup_table.max_error = 0.0;
+        for (size_t interval_count = 0; interval_count < nintervals; ++interval_count){
+            double spline_rec = 0.0;
+            double spline_drec = 0.0;
+            hermite(lookup_table.srp, lookup_table.rec, lookup_table.slope, interval_count, mid_srp[interval_count], spline_rec, spline_drec);
+            const double error = std::abs(spline_rec - mid_rec[interval_count]) / rec_scale;
+            errors[interval_count] = std::make_pair(error, interval_count);
+            lookup_table.max_error = std::max(lookup_table.max_error, error);
+        }
+        if ((lookup_table.max_error <= tolerance) || (lookup_table.srp.size() >= max_points)){
+            break;
+        }
+        // Add the worst midpoints, as many as there is room for
+        std::sort(errors.begin(), errors.end(), std::greater<std::pair<double, size_t> >());
+        std::vector<bool> add_midpoint(nintervals, false);
+        const size_t room = max_points - lookup_table.srp.size();
+        for (size_t error_count = 0; (error_count < nintervals) && (error_count < room) && (errors[error_count].first > tolerance); ++error_count){
+            add_midpoint[errors[error_count].second] = true;
+        }
+        std::vector<double> new_srp;
+        std::vector<double> new_rec;
+        for (size_t interval_count = 0; interval_count < nintervals; ++interval_count){
+            new_srp.push_back(lookup_table.srp[interval_count]);
+            new_rec.push_back(lookup_table.rec[interval_count]);
+            if (add_midpoint[interval_count]){
+                new_srp.push_back(mid_srp[interval_count]);
+                new_rec.push_back(mid_rec[interval_count]);
+            }
+        }
+        new_srp.push_back(lookup_table.srp.back());
+        new_rec.push_back(lookup_table.rec.back());
+        lookup_table.srp = new_srp;
+        lookup_table.rec = new_rec;
+    }
+    return lookup_table;
+}
+
+/*! \brief The table of a parameter set that covers the SRP
+ *
+ * The table is built the first time the parameter set is used.
+ * If the SRP is above the upper limit of the table, the table is built again up to twice the SRP.
+ */
+const srrLookup::table& srrLookup::get_table(const std::vector<double>& params, const double srp){
+    if (!rec_function){
+        Rcpp::stop("In srrLookup. There is no SRR to tabulate.\n");
+    }
+    std::map<std::vector<double>, table>::iterator table_found = tables.find(params);
+    if ((table_found != tables.end()) && (srp <= table_found->second.srp.back())){
+        return table_found->second;
+    }
+    double srp_upper = std::max(srp_max, 2.0 * srp);
+    if (table_found != tables.end()){
+        srp_upper = std::max(srp_upper, 2.0 * table_found->second.srp.back());
+    }
+    if (srp_upper <= 0.0){
+        srp_upper = 1.0;
+    }
+    table& lookup_table = tables[params];
+    lookup_table = build_table(params, srp_upper);
+    return lookup_table;
+}
+
+// Value and derivative from a table - linear below the first point
+void srrLookup::eval_table(const table& lookup_table, const double srp, double& rec, double& drec) const{
+    if (srp <= lookup_table.srp.front()){
+        drec = lookup_table.slope.front();
+        rec = lookup_table.rec.front() + drec * (srp - lookup_table.srp.front());
+        return;
+    }
+    std::vector<double>::const_iterator upper = std::upper_bound(lookup_table.srp.begin(), lookup_table.srp.end(), srp);
+    size_t interval = std::min(static_cast<size_t>(upper - lookup_table.srp.begin()), lookup_table.srp.size() - 1) - 1;
+    hermite(lookup_table.srp, lookup_table.rec, lookup_table.slope, interval, srp, rec, drec);
+}
+
+/*! \brief Recruitment from the tables for a batch of SRP values
+ *
+ * \param srp The SRP values.
+ * \param params The parameters of each SRP value, with the parameters varying fastest.
+ */
+std::vector<double> srrLookup::eval(const std::vector<double>& srp, const std::vector<double>& params){
+    const size_t nvalues = srp.size();
+    const size_t nparams = (nvalues == 0) ? 0 : params.size() / nvalues;
+    std::vector<double> rec(nvalues);
+    double drec = 0.0;
+    for (size_t value_count = 0; value_count < nvalues; ++value_count){
+        const std::vector<double> value_params(params.begin() + value_count * nparams, params.begin() + (value_count + 1) * nparams);
+        eval_table(get_table(value_params, srp[value_count]), srp[value_count], rec[value_count], drec);
+    }
+    return rec;
+}
+
+/*! \brief Derivative of recruitment with respect to the SRP from the tables for a batch of SRP values
+ *
+ * \param srp The SRP values.
+ * \param params The parameters of each SRP value, with the parameters varying fastest.
+ */
+std::vector<double> srrLookup::gradient(const std::vector<double>& srp, const std::vector<double>& params){
+    const size_t nvalues = srp.size();
+    const size_t nparams = (nvalues == 0) ? 0 : params.size() / nvalues;
+    std::vector<double> drec(nvalues);
+    double rec = 0.0;
+    for (size_t value_count = 0; value_count < nvalues; ++value_count){
+        const std::vector<double> value_params(params.begin() + value_count * nparams, params.begin() + (value_count + 1) * nparams);
+        eval_table(get_table(value_params, srp[value_count]), srp[value_count], rec, drec[value_count]);
+    }
+    return drec;
+}
+
+double srrLookup::get_max_error() const{
+    double max_error = 0.0;
+    for (const std::pair<const std::vector<double>, table>& lookup_table : tables){
+        max_error = std::max(max_error, lookup_table.second.max_error);
+    }
+    return max_error;
+}
+
+unsigned int srrLookup::get_ntables() const{
+    return tables.size();
+}
+